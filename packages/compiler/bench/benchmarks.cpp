@@ -0,0 +1,742 @@
+#include "source_generator.h"
+
+#include "files.h"
+#include "thread_pool.h"
+#include "ast/arena.h"
+#include "ast/ast.h"
+#include "ast/parsing_context.h"
+#include "ast/serialization.h"
+#include "ast/visitor.h"
+#include "ast/visitor_pipeline.h"
+#include "ast/nodes/blocks.h"
+#include "ast/nodes/expression.h"
+#include "ast/nodes/traversal.h"
+#include "ast/tokens/tokenizer.h"
+#include "runtime/symbols.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/PassManager.h>
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+
+/*
+ * Compiler throughput benchmarks, one per phase of Program::prepare_module.
+ *
+ * Every benchmark takes the shape of its synthetic input as arguments:
+ * (functions, structs, nesting depth). Phases that consume the output of earlier phases
+ * run those earlier phases with the timer paused, so each result only covers its own phase.
+ *
+ * Results are written to `cstride_bench.json` in the working directory, unless `--benchmark_out`
+ * is passed explicitly.
+ */
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    bench::GeneratorOptions options_from(const benchmark::State& state)
+    {
+        return {
+            .functions = static_cast<size_t>(state.range(0)),
+            .structs = static_cast<size_t>(state.range(1)),
+            .depth = static_cast<size_t>(state.range(2))
+        };
+    }
+
+    std::shared_ptr<SourceFile> generate_file(const benchmark::State& state)
+    {
+        return std::make_shared<SourceFile>("bench.sr", bench::generate_source(options_from(state)));
+    }
+
+    /// The phases of Program::prepare_modules for a single file, in order.
+    enum class Phase
+    {
+        PARSE,
+        IMPORT_VISITOR,
+        FUNCTION_VISITOR,
+        EXPRESSION_VISITOR,
+        VALIDATE,
+        CODEGEN,
+        OPTIMIZE
+    };
+
+    std::unique_ptr<llvm::TargetMachine> create_target_machine()
+    {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+
+        auto builder = llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost());
+        return llvm::cantFail(builder.createTargetMachine());
+    }
+
+    struct CompilationState
+    {
+        std::unique_ptr<llvm::TargetMachine> target_machine = create_target_machine();
+        std::unique_ptr<llvm::LLVMContext> llvm_context;
+        std::unique_ptr<llvm::Module> module;
+        std::unique_ptr<AstBlock> root;
+        llvm::OptimizationLevel optimization_level = llvm::OptimizationLevel::O3;
+
+        void reset()
+        {
+            // The module has to go before the context that owns its types
+            this->root.reset();
+            this->module.reset();
+            this->llvm_context.reset();
+        }
+
+        ~CompilationState()
+        {
+            this->reset();
+        }
+    };
+
+    /// Writes a project of 256 generated files of varying size to <code>directory</code>.
+    std::vector<FilePath> write_project(const std::filesystem::path& directory, size_t& total_size)
+    {
+        std::filesystem::create_directories(directory);
+
+        std::vector<FilePath> files;
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            const auto source = bench::generate_source({ .functions = 10 + i % 64, .structs = 4, .seed = i });
+            const auto path = directory / std::format("file{}.sr", i);
+
+            std::ofstream(path, std::ios::binary) << source;
+            files.push_back(path.string());
+            total_size += source.size();
+        }
+
+        return files;
+    }
+
+    void run_phase(CompilationState& compilation, TokenSet tokens, const Phase phase)
+    {
+        AstNodeTraverser traverser;
+
+        switch (phase)
+        {
+        case Phase::PARSE:
+            compilation.root = parse_sequential(std::make_shared<ParsingContext>(), tokens);
+            break;
+        case Phase::IMPORT_VISITOR:
+        {
+            ImportVisitor import_visitor;
+            import_visitor.set_current_file_name("bench.sr");
+            traverser.visit_block(&import_visitor, compilation.root.get());
+            break;
+        }
+        case Phase::FUNCTION_VISITOR:
+        {
+            FunctionVisitor function_visitor;
+            traverser.visit_block(&function_visitor, compilation.root.get());
+            break;
+        }
+        case Phase::EXPRESSION_VISITOR:
+        {
+            ExpressionVisitor type_visitor;
+            runtime::register_runtime_symbols(compilation.root->get_context());
+            traverser.visit_block(&type_visitor, compilation.root.get());
+            break;
+        }
+        case Phase::VALIDATE:
+            compilation.root->validate();
+            break;
+        case Phase::CODEGEN:
+        {
+            compilation.llvm_context = std::make_unique<llvm::LLVMContext>();
+            compilation.module = std::make_unique<llvm::Module>("bench_module", *compilation.llvm_context);
+            compilation.module->setDataLayout(compilation.target_machine->createDataLayout());
+            compilation.module->setTargetTriple(compilation.target_machine->getTargetTriple());
+
+            llvm::IRBuilder<> builder(*compilation.llvm_context);
+            compilation.root->resolve_forward_references(compilation.module.get(), &builder);
+            compilation.root->codegen(compilation.module.get(), &builder);
+            break;
+        }
+        case Phase::OPTIMIZE:
+        {
+            llvm::LoopAnalysisManager loop_analysis_manager;
+            llvm::FunctionAnalysisManager function_analysis_manager;
+            llvm::CGSCCAnalysisManager cgscc_analysis_manager;
+            llvm::ModuleAnalysisManager module_analysis_manager;
+
+            llvm::PassBuilder pass_builder(compilation.target_machine.get());
+
+            pass_builder.registerModuleAnalyses(module_analysis_manager);
+            pass_builder.registerCGSCCAnalyses(cgscc_analysis_manager);
+            pass_builder.registerFunctionAnalyses(function_analysis_manager);
+            pass_builder.registerLoopAnalyses(loop_analysis_manager);
+            pass_builder.crossRegisterProxies(
+                loop_analysis_manager,
+                function_analysis_manager,
+                cgscc_analysis_manager,
+                module_analysis_manager);
+
+            auto module_pass_manager = pass_builder.buildPerModuleDefaultPipeline(compilation.optimization_level);
+            module_pass_manager.run(*compilation.module, module_analysis_manager);
+            break;
+        }
+        }
+    }
+
+    /// Measures a single phase. All phases before it are set up again, untimed, for every iteration,
+    /// since most phases mutate the AST or its contexts and can't be repeated on the same tree.
+    void benchmark_phase(
+        benchmark::State& state,
+        const Phase phase,
+        const llvm::OptimizationLevel optimization_level = llvm::OptimizationLevel::O3)
+    {
+        const auto file = generate_file(state);
+        const auto tokens = tokenizer::tokenize(file);
+
+        CompilationState compilation;
+        compilation.optimization_level = optimization_level;
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            compilation.reset();
+            for (auto setup_phase = Phase::PARSE; setup_phase < phase;
+                 setup_phase = static_cast<Phase>(static_cast<int>(setup_phase) + 1))
+            {
+                run_phase(compilation, tokens, setup_phase);
+            }
+            state.ResumeTiming();
+
+            run_phase(compilation, tokens, phase);
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file->source.size()));
+    }
+}
+
+static void BM_Tokenize(benchmark::State& state)
+{
+    const auto file = generate_file(state);
+
+    for (auto _ : state)
+    {
+        auto tokens = tokenizer::tokenize(file);
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file->source.size()));
+}
+
+static void BM_ParseSequential(benchmark::State& state)
+{
+    const auto file = generate_file(state);
+    const auto tokens = tokenizer::tokenize(file);
+
+    for (auto _ : state)
+    {
+        // Token sets are views, so copying one for each iteration doesn't copy any tokens
+        auto set = tokens;
+        auto root = parse_sequential(std::make_shared<ParsingContext>(), set);
+        benchmark::DoNotOptimize(root);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file->source.size()));
+}
+
+/// Same as BM_ParseSequential, but with all nodes, types and contexts placed in an arena.
+static void BM_ParseSequentialArena(benchmark::State& state)
+{
+    const auto file = generate_file(state);
+    const auto tokens = tokenizer::tokenize(file);
+
+    for (auto _ : state)
+    {
+        AstArena arena;
+        AstArena::Scope arena_scope(arena);
+
+        auto set = tokens;
+        auto root = parse_sequential(make_context(), set);
+        benchmark::DoNotOptimize(root);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file->source.size()));
+}
+
+/// Parses a project of 256 generated files of varying size, on a pool of <code>state.range(0)</code> threads.
+static void BM_ParseFiles(benchmark::State& state)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "cstride_bench_project";
+    size_t total_size = 0;
+    const auto files = write_project(directory, total_size);
+
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        auto ast = Ast::parse_files(files, pool);
+        benchmark::DoNotOptimize(ast);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * total_size));
+    std::filesystem::remove_all(directory);
+}
+
+/// Loads the project of <code>BM_ParseFiles</code> from a warm parsed-file cache, on a pool of
+/// <code>state.range(0)</code> threads.
+static void BM_ParseFilesCached(benchmark::State& state)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "cstride_bench_cached_project";
+    size_t total_size = 0;
+    const auto files = write_project(directory, total_size);
+
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    const AstCache cache(directory / "cache");
+    benchmark::DoNotOptimize(Ast::parse_files(files, pool, &cache));
+
+    for (auto _ : state)
+    {
+        auto ast = Ast::parse_files(files, pool, &cache);
+        benchmark::DoNotOptimize(ast);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * total_size));
+    std::filesystem::remove_all(directory);
+}
+
+/// Parses a small script together with the project of <code>BM_ParseFiles</code>, which it barely
+/// uses, with lazy function bodies when <code>state.range(0)</code> is set.
+static void BM_ParseFilesLazy(benchmark::State& state)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "cstride_bench_lazy_project";
+    size_t total_size = 0;
+    auto files = write_project(directory, total_size);
+
+    const auto script = directory / "main.sr";
+    std::ofstream(script, std::ios::binary) << "fn main(): i32 { return 0; }\n";
+    files.push_back(script.string());
+
+    const bool lazy = state.range(0) != 0;
+    ThreadPool pool(1);
+
+    for (auto _ : state)
+    {
+        auto ast = Ast::parse_files(files, pool, nullptr, lazy);
+        ast->parse_reachable_functions();
+        benchmark::DoNotOptimize(ast);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * total_size));
+    std::filesystem::remove_all(directory);
+}
+
+/// Looks up each of <code>state.range(0)</code> global variables and functions from a nested scope.
+static void BM_GlobalSymbolLookup(benchmark::State& state)
+{
+    const auto symbol_count = static_cast<size_t>(state.range(0));
+    const auto source = std::make_shared<SourceFile>("bench.sr", "");
+    const SourceFragment position(source, 0, 0);
+    const auto global = make_context();
+
+    const auto make_int = [&]
+    {
+        return std::make_unique<AstPrimitiveType>(position, global, PrimitiveType::INT32);
+    };
+
+    std::vector<std::string> variable_names;
+    std::vector<std::string> function_names;
+    for (size_t i = 0; i < symbol_count; ++i)
+    {
+        variable_names.push_back(std::format("global{}", i));
+        global->define_variable(Symbol(position, variable_names.back()), make_int(), VisibilityModifier::PUBLIC);
+
+        std::vector<std::unique_ptr<IAstType>> parameters;
+        parameters.push_back(make_int());
+
+        function_names.push_back(std::format("function{}", i));
+        global->define_function(
+            Symbol(position, function_names.back()),
+            std::make_unique<AstFunctionType>(position, global, std::move(parameters), make_int()),
+            VisibilityModifier::PUBLIC);
+    }
+
+    const auto scope = make_context(make_context(global, ContextType::FUNCTION), ContextType::CONTROL_FLOW);
+
+    std::vector<std::unique_ptr<IAstType>> argument_types;
+    argument_types.push_back(make_int());
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < symbol_count; ++i)
+        {
+            benchmark::DoNotOptimize(scope->lookup_variable(variable_names[i]));
+            benchmark::DoNotOptimize(scope->get_function_definition(function_names[i], argument_types));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * symbol_count * 2));
+}
+
+/// Resolves each of <code>state.range(0)</code> overloads of one function by its argument types.
+static void BM_OverloadResolution(benchmark::State& state)
+{
+    static constexpr PrimitiveType parameter_types[] = {
+        PrimitiveType::INT32, PrimitiveType::INT64, PrimitiveType::FLOAT64, PrimitiveType::BOOL
+    };
+    static constexpr size_t parameter_count = 6;
+
+    const auto overload_count = static_cast<size_t>(state.range(0));
+    const auto source = std::make_shared<SourceFile>("bench.sr", "");
+    const SourceFragment position(source, 0, 0);
+    const auto global = make_context();
+
+    // The parameters of overload i are the base-4 digits of i
+    const auto make_parameters = [&](size_t overload)
+    {
+        std::vector<std::unique_ptr<IAstType>> parameters;
+        for (size_t i = 0; i < parameter_count; ++i, overload /= std::size(parameter_types))
+        {
+            parameters.push_back(std::make_unique<AstPrimitiveType>(
+                position, global, parameter_types[overload % std::size(parameter_types)]));
+        }
+        return parameters;
+    };
+
+    std::vector<std::vector<std::unique_ptr<IAstType>>> argument_types;
+    for (size_t i = 0; i < overload_count; ++i)
+    {
+        global->define_function(
+            Symbol(position, "overloaded"),
+            std::make_unique<AstFunctionType>(
+                position,
+                global,
+                make_parameters(i),
+                std::make_unique<AstPrimitiveType>(position, global, PrimitiveType::INT32)),
+            VisibilityModifier::PUBLIC);
+
+        argument_types.push_back(make_parameters(i));
+    }
+
+    const auto scope = make_context(global, ContextType::FUNCTION);
+
+    for (auto _ : state)
+    {
+        for (const auto& arguments : argument_types)
+        {
+            benchmark::DoNotOptimize(scope->get_function_definition("overloaded", arguments));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * overload_count));
+}
+
+/// Compares nested types of depth <code>state.range(0)</code> with an equal copy, a clone, and a type
+/// that only differs in its innermost primitives.
+static void BM_TypeEquality(benchmark::State& state)
+{
+    const auto depth = static_cast<size_t>(state.range(0));
+    const auto source = std::make_shared<SourceFile>("bench.sr", "");
+    const SourceFragment position(source, 0, 0);
+    const auto context = make_context();
+
+    // (fn(T[]): T, T) for every level, so the size doubles with the depth
+    std::function<std::unique_ptr<IAstType>(size_t, PrimitiveType)> make_nested;
+    make_nested = [&](const size_t level, const PrimitiveType leaf) -> std::unique_ptr<IAstType>
+    {
+        if (level == 0)
+        {
+            return std::make_unique<AstPrimitiveType>(position, context, leaf);
+        }
+
+        std::vector<std::unique_ptr<IAstType>> parameters;
+        parameters.push_back(std::make_unique<AstArrayType>(position, context, make_nested(level - 1, leaf), 0));
+
+        std::vector<std::unique_ptr<IAstType>> members;
+        members.push_back(std::make_unique<AstFunctionType>(
+            position, context, std::move(parameters), make_nested(level - 1, leaf)));
+        members.push_back(make_nested(level - 1, leaf));
+
+        return std::make_unique<AstTupleType>(position, context, std::move(members));
+    };
+
+    const auto type = make_nested(depth, PrimitiveType::INT32);
+    const auto copy = make_nested(depth, PrimitiveType::INT32);
+    const auto different = make_nested(depth, PrimitiveType::INT64);
+
+    // Like the types of definitions, which are compared over and over
+    type->intern();
+    copy->intern();
+    different->intern();
+    const auto clone = type->clone_ty();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(type->equals(copy.get()));
+        benchmark::DoNotOptimize(type->equals(clone.get()));
+        benchmark::DoNotOptimize(type->equals(different.get()));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 3));
+}
+
+/// Resolves <code>state.range(0)</code> uses of the same two instantiations of a generic object type.
+static void BM_GenericInstantiation(benchmark::State& state)
+{
+    const auto use_count = static_cast<size_t>(state.range(0));
+    const auto file = std::make_shared<SourceFile>(
+        "bench.sr",
+        "type Pair<T> = { first: T; second: T[]; both: (T, T) -> T; };");
+    const auto tokens = tokenizer::tokenize(file);
+    const SourceFragment position(file, 0, 0);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        const auto context = make_context();
+        auto set = tokens;
+        const auto root = parse_sequential(context, set);
+
+        std::vector<std::unique_ptr<AstAliasType>> uses;
+        uses.reserve(use_count);
+        for (size_t i = 0; i < use_count; ++i)
+        {
+            GenericTypeList arguments;
+            arguments.push_back(std::make_unique<AstPrimitiveType>(
+                position, context, i % 2 == 0 ? PrimitiveType::INT32 : PrimitiveType::FLOAT64));
+            uses.push_back(std::make_unique<AstAliasType>(position, context, "Pair", SRFLAG_NONE, std::move(arguments)));
+        }
+        state.ResumeTiming();
+
+        for (const auto& use : uses)
+        {
+            benchmark::DoNotOptimize(use->get_underlying_type());
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * use_count));
+}
+
+/// Parses one expression of <code>state.range(0)</code> operands, mixing all binary operators.
+static void BM_ParseExpression(benchmark::State& state)
+{
+    static constexpr std::string_view operators[] = {
+        "*", "+", "/", "-", "%", "<", "&&", "==", "||", "!=", ">=", "+"
+    };
+
+    std::string source = "a0";
+    for (int64_t i = 1; i < state.range(0); ++i)
+    {
+        source += std::format(" {} {}", operators[i % std::size(operators)], i % 3 == 0 ? "7" : std::format("a{}", i));
+    }
+    source += ";";
+
+    const auto file = std::make_shared<SourceFile>("bench.sr", source);
+    const auto tokens = tokenizer::tokenize(file);
+
+    for (auto _ : state)
+    {
+        auto set = tokens;
+        auto expression = parse_standalone_expression(std::make_shared<ParsingContext>(), set);
+        benchmark::DoNotOptimize(expression);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file->source.size()));
+}
+
+static void BM_ImportVisitor(benchmark::State& state)
+{
+    benchmark_phase(state, Phase::IMPORT_VISITOR);
+}
+
+static void BM_FunctionVisitor(benchmark::State& state)
+{
+    benchmark_phase(state, Phase::FUNCTION_VISITOR);
+}
+
+static void BM_ExpressionVisitor(benchmark::State& state)
+{
+    benchmark_phase(state, Phase::EXPRESSION_VISITOR);
+}
+
+/// Runs the import, function and expression visitors one traversal at a time, or through a
+/// <code>VisitorPipeline</code> when <code>state.range(3)</code> is set, which fuses the first two.
+static void BM_SemanticAnalysis(benchmark::State& state)
+{
+    const auto file = generate_file(state);
+    const auto tokens = tokenizer::tokenize(file);
+    const bool fused = state.range(3) != 0;
+
+    CompilationState compilation;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        compilation.reset();
+        run_phase(compilation, tokens, Phase::PARSE);
+        state.ResumeTiming();
+
+        ImportVisitor import_visitor;
+        FunctionVisitor function_visitor;
+        ExpressionVisitor type_visitor;
+        AstBlock* root = compilation.root.get();
+
+        if (fused)
+        {
+            VisitorPipeline pipeline;
+            pipeline.add(&import_visitor);
+            pipeline.add(&function_visitor);
+            pipeline.add(&type_visitor, { &import_visitor, &function_visitor });
+            pipeline.on_complete(&import_visitor, [&] { runtime::register_runtime_symbols(root->get_context()); });
+            pipeline.run("bench.sr", root);
+        }
+        else
+        {
+            AstNodeTraverser traverser;
+            import_visitor.set_current_file_name("bench.sr");
+            traverser.visit_block(&import_visitor, root);
+            traverser.visit_block(&function_visitor, root);
+            runtime::register_runtime_symbols(root->get_context());
+            traverser.visit_block(&type_visitor, root);
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file->source.size()));
+}
+
+static void BM_Validate(benchmark::State& state)
+{
+    benchmark_phase(state, Phase::VALIDATE);
+}
+
+static void BM_Codegen(benchmark::State& state)
+{
+    benchmark_phase(state, Phase::CODEGEN);
+}
+
+static void BM_OptimizeO3(benchmark::State& state)
+{
+    benchmark_phase(state, Phase::OPTIMIZE);
+}
+
+/// The default pipelines of the other optimization levels; -O0 runs no pipeline at all
+static void BM_OptimizeLevel(benchmark::State& state)
+{
+    static const std::array levels = {
+        std::pair{ "O1", llvm::OptimizationLevel::O1 },
+        std::pair{ "O2", llvm::OptimizationLevel::O2 },
+        std::pair{ "O3", llvm::OptimizationLevel::O3 },
+        std::pair{ "Os", llvm::OptimizationLevel::Os },
+        std::pair{ "Oz", llvm::OptimizationLevel::Oz },
+    };
+
+    const auto& [name, level] = levels.at(state.range(3));
+    state.SetLabel(name);
+    benchmark_phase(state, Phase::OPTIMIZE, level);
+}
+
+/// Program sizes, at a fixed nesting depth
+static void program_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({ "functions", "structs", "depth" });
+    for (const int64_t functions : { 10, 100, 1000 })
+    {
+        benchmark->Args({ functions, functions / 10, 4 });
+    }
+}
+
+/// Program sizes, traversed once per visitor and fused
+static void fused_program_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({ "functions", "structs", "depth", "fused" });
+    for (const int64_t functions : { 10, 100, 1000 })
+    {
+        for (const int64_t fused : { 0, 1 })
+        {
+            benchmark->Args({ functions, functions / 10, 4, fused });
+        }
+    }
+}
+
+/// Nesting depths, at a fixed program size. Parse time should scale linearly with depth.
+static void nesting_depths(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({ "functions", "structs", "depth" });
+    for (const int64_t depth : { 1, 8, 32, 128 })
+    {
+        benchmark->Args({ 50, 5, depth });
+    }
+}
+
+BENCHMARK(BM_Tokenize)->Apply(program_sizes);
+BENCHMARK(BM_ParseSequential)->Apply(program_sizes)->Apply(nesting_depths);
+BENCHMARK(BM_ParseSequentialArena)->Apply(program_sizes)->Apply(nesting_depths);
+BENCHMARK(BM_ParseFiles)->ArgName("threads")->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+BENCHMARK(BM_ParseFilesCached)->ArgName("threads")->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+BENCHMARK(BM_ParseFilesLazy)->ArgName("lazy")->Arg(0)->Arg(1)->UseRealTime();
+BENCHMARK(BM_GlobalSymbolLookup)->ArgName("symbols")->RangeMultiplier(10)->Range(100, 100000);
+BENCHMARK(BM_OverloadResolution)->ArgName("overloads")->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK(BM_TypeEquality)->ArgName("depth")->DenseRange(2, 10, 4);
+BENCHMARK(BM_GenericInstantiation)->ArgName("uses")->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK(BM_ParseExpression)->ArgName("operands")->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_ImportVisitor)->Apply(program_sizes);
+BENCHMARK(BM_FunctionVisitor)->Apply(program_sizes);
+BENCHMARK(BM_ExpressionVisitor)->Apply(program_sizes);
+BENCHMARK(BM_SemanticAnalysis)->Apply(fused_program_sizes);
+BENCHMARK(BM_Validate)->Apply(program_sizes);
+BENCHMARK(BM_Codegen)->Apply(program_sizes);
+BENCHMARK(BM_OptimizeO3)->Apply(program_sizes);
+BENCHMARK(BM_OptimizeLevel)->ArgNames({ "functions", "structs", "depth", "level" })->ArgsProduct({ { 100 }, { 10 }, { 4 }, { 0, 1, 2, 3, 4 } });
+
+int main(int argc, char** argv)
+{
+    // Emit JSON results by default, so runs can be compared per phase over time
+    std::vector<char*> arguments(argv, argv + argc);
+
+    std::string out_argument = "--benchmark_out=cstride_bench.json";
+    std::string format_argument = "--benchmark_out_format=json";
+
+    const auto has_argument = [&](const std::string_view prefix)
+    {
+        return std::ranges::any_of(
+            arguments,
+            [&](const char* argument)
+            {
+                return std::string_view(argument).starts_with(prefix);
+            });
+    };
+
+    if (!has_argument("--benchmark_out="))
+    {
+        arguments.push_back(out_argument.data());
+    }
+    if (!has_argument("--benchmark_out_format="))
+    {
+        arguments.push_back(format_argument.data());
+    }
+
+    int argument_count = static_cast<int>(arguments.size());
+
+    benchmark::Initialize(&argument_count, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(argument_count, arguments.data()))
+    {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "source_generator.h"
+
+#include <algorithm>
+#include <format>
+#include <random>
+#include <vector>
+
+using namespace stride::bench;
+
+namespace
+{
+    void append_indent(std::string& out, const size_t level)
+    {
+        out.append(level * 4, ' ');
+    }
+
+    /// Emits `depth` levels of alternating if-statements and for-loops, all mutating `acc`.
+    void append_nested_body(std::string& out, std::mt19937& rng, const size_t depth, const size_t level)
+    {
+        if (depth == 0)
+        {
+            append_indent(out, level);
+            out += std::format("acc = acc + {};\n", rng() % 100);
+            return;
+        }
+
+        append_indent(out, level);
+        if (depth % 2 == 0)
+        {
+            out += std::format("if (acc > {}) {{\n", rng() % 1000);
+        }
+        else
+        {
+            out += std::format("for (let i{}: i32 = 0; i{} < {}; i{}++) {{\n", depth, depth, rng() % 10 + 1, depth);
+        }
+
+        append_indent(out, level + 1);
+        out += std::format("acc = acc * {} + x;\n", rng() % 7 + 1);
+
+        append_nested_body(out, rng, depth - 1, level + 1);
+
+        append_indent(out, level);
+        out += "}\n";
+    }
+}
+
+std::string stride::bench::generate_source(const GeneratorOptions& options)
+{
+    std::mt19937 rng(options.seed);
+    std::string out;
+
+    const auto struct_count = std::max<size_t>(options.structs, 1);
+
+    std::vector<size_t> field_counts;
+
+    for (size_t i = 0; i < struct_count; ++i)
+    {
+        const auto field_count = field_counts.emplace_back(2 + rng() % 4);
+
+        out += std::format("type Struct{} = {{\n", i);
+        for (size_t field = 0; field < field_count; ++field)
+        {
+            out += std::format("    field{}: i32;\n", field);
+        }
+        out += "};\n\n";
+    }
+
+    for (size_t i = 0; i < options.functions; ++i)
+    {
+        const auto struct_index = rng() % struct_count;
+
+        out += std::format("// Generated function {}\n", i);
+        out += std::format("fn function{}(x: i32, y: i32): i32 {{\n", i);
+        out += std::format("    const value: Struct{} = Struct{}::{{ field0: x, field1: y", struct_index, struct_index);
+        for (size_t field = 2; field < field_counts[struct_index]; ++field)
+        {
+            out += std::format(", field{}: {}", field, rng() % 100);
+        }
+        out += " };\n";
+        out += "    let acc: i32 = value.field0 + value.field1;\n";
+
+        append_nested_body(out, rng, options.depth, 1);
+
+        if (i > 0)
+        {
+            out += std::format("    acc = acc + function{}(acc, {});\n", i - 1, rng() % 100);
+        }
+
+        out += "    return acc;\n";
+        out += "}\n\n";
+    }
+
+    return out;
+}
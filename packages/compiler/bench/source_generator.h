@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace stride::bench
+{
+    struct GeneratorOptions
+    {
+        /// Number of functions to generate
+        size_t functions = 100;
+
+        /// Number of struct types to generate
+        size_t structs = 10;
+
+        /// How deep control flow is nested inside each function body
+        size_t depth = 4;
+
+        /// Seed for the pseudo-random choices; equal options always produce equal sources
+        uint32_t seed = 0x5eed;
+    };
+
+    /**
+     * Generates a syntactically and semantically valid Stride program of the given shape.
+     * Every function declares a struct instance, some locals and a chain of nested
+     * conditionals and loops, and calls the previously generated function.
+     */
+    std::string generate_source(const GeneratorOptions& options);
+} // namespace stride::bench
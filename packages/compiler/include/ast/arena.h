@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace stride::ast
+{
+    /**
+     * @brief Bump-pointer memory for the AST nodes, types and contexts of one compilation.
+     *
+     * Memory is handed out from large chunks, and all chunks are released at once when the arena
+     * is destroyed. Objects are still destroyed individually, as their members may own memory of
+     * their own, but freeing them doesn't touch the allocator.
+     *
+     * Every thread allocating from an arena bumps its own cursor, so the arena only takes a lock
+     * when a thread needs a new chunk. Objects are allocated from the arena installed on the
+     * calling thread with <code>AstArena::Scope</code>, or from the heap if there is none.
+     *
+     * The arena must outlive everything allocated from it, and everything referring to that by raw
+     * pointer. Within a compilation, it is owned by the <code>Ast</code>, which destroys its files first.
+     * Generic instantiations and the canonical types aliases point at are owned by type definitions,
+     * thus by contexts in the same arena. Interned types only hold ids, and the JIT only holds LLVM IR,
+     * so neither refers to the arena. Destroying an arena while a thread still has it installed is
+     * a bug, which is asserted.
+     */
+    class AstArena
+    {
+        struct ChunkDeleter
+        {
+            void operator()(std::byte* chunk) const noexcept;
+        };
+
+        std::mutex _mutex;
+        std::vector<std::unique_ptr<std::byte[], ChunkDeleter>> _chunks;
+        std::atomic<size_t> _allocated_bytes = 0;
+
+        /// Number of <code>Scope</code>s installing this arena, on any thread
+        std::atomic<size_t> _installed_scopes = 0;
+
+    public:
+        /// Size of the chunks allocations are bumped from. Larger allocations get a chunk of their own.
+        static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+        AstArena() = default;
+
+        ~AstArena();
+
+        AstArena(const AstArena&) = delete;
+        AstArena& operator=(const AstArena&) = delete;
+
+        /// Allocates <code>size</code> bytes aligned to <code>alignof(std::max_align_t)</code>.
+        /// The memory is never aligned to twice that, which is how <code>deallocate_ast_memory</code>
+        /// tells it apart from memory of the heap.
+        void* allocate(size_t size);
+
+        /// Total number of bytes allocated from this arena.
+        [[nodiscard]]
+        size_t get_allocated_bytes() const
+        {
+            return this->_allocated_bytes.load(std::memory_order_relaxed);
+        }
+
+        /// The arena installed on the calling thread, if any.
+        static AstArena* current();
+
+        /// Installs an arena on the calling thread for the lifetime of the scope.
+        class Scope
+        {
+            AstArena* _previous_arena;
+            std::byte* _previous_cursor;
+            std::byte* _previous_end;
+
+        public:
+            explicit Scope(AstArena& arena);
+
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+
+    private:
+        std::byte* allocate_chunk(size_t size);
+    };
+
+    /// Allocates memory for an AST object from the current arena, or from the heap if no arena is
+    /// installed on the calling thread.
+    void* allocate_ast_memory(size_t size);
+
+    /// Releases memory obtained from <code>allocate_ast_memory</code>. Memory belonging to an arena is
+    /// only released together with its arena.
+    void deallocate_ast_memory(void* memory) noexcept;
+
+    /// Allocator that places objects with <code>allocate_ast_memory</code>, e.g. for <code>std::allocate_shared</code>.
+    template <typename T>
+    struct AstAllocator
+    {
+        using value_type = T;
+
+        static_assert(alignof(T) <= alignof(std::max_align_t), "AST objects can't be over-aligned");
+
+        AstAllocator() = default;
+
+        template <typename U>
+        AstAllocator(const AstAllocator<U>&) noexcept {}
+
+        T* allocate(const size_t count)
+        {
+            return static_cast<T*>(allocate_ast_memory(count * sizeof(T)));
+        }
+
+        void deallocate(T* memory, size_t) noexcept
+        {
+            deallocate_ast_memory(memory);
+        }
+
+        template <typename U>
+        bool operator==(const AstAllocator<U>&) const noexcept
+        {
+            return true;
+        }
+    };
+} // namespace stride::ast
@@ -1,4 +1,5 @@
 #pragma once
+#include "arena.h"
 #include "parsing_context.h"
 
 #include <map>
@@ -8,10 +9,12 @@
 namespace stride
 {
     struct SourceFile;
+    class ThreadPool;
 }
 
 namespace stride::ast
 {
+    class AstCache;
     class TokenSet;
 }
 
@@ -21,15 +24,48 @@ namespace stride::ast
 
     class Ast
     {
+        /// Owns the memory of every node, type and context of the parsed files.
+        /// Declared first, so it is released only after all files have been destroyed.
+        std::unique_ptr<AstArena> _arena = std::make_unique<AstArena>();
+
         std::map<FilePath, std::unique_ptr<AstBlock>> _files{};
 
-        static std::pair<FilePath, std::unique_ptr<AstBlock>> parse_file(const FilePath& path);
+        static std::pair<FilePath, std::unique_ptr<AstBlock>> parse_file(
+            const FilePath& path,
+            const AstCache* cache,
+            bool lazy_function_bodies
+        );
 
     public:
+        /// Parses all files on the shared thread pool.
         static std::unique_ptr<Ast> parse_files(
             const std::vector<FilePath>& files
         );
 
+        /// Parses all files on <code>pool</code>, largest files first, so that they don't end up
+        /// being the last ones still parsing. Files found in <code>cache</code> are loaded from it
+        /// instead, and all others are stored in it once parsed. With <code>lazy_function_bodies</code>,
+        /// function bodies are only parsed by <code>parse_reachable_functions</code>.
+        static std::unique_ptr<Ast> parse_files(
+            const std::vector<FilePath>& files,
+            ThreadPool& pool,
+            const AstCache* cache = nullptr,
+            bool lazy_function_bodies = false
+        );
+
+        /**
+         * @brief Parses the deferred bodies of all functions that may be called.
+         *
+         * Starting from <code>main</code>, the public functions and everything that was parsed
+         * right away, every function that is referred to by name has its body parsed, after which
+         * its body is searched for references as well. Functions are matched by name only, so all
+         * overloads of a referenced function are parsed. Bodies that are still deferred afterwards
+         * are never analyzed or generated.
+         *
+         * @return The number of bodies that were parsed.
+         */
+        size_t parse_reachable_functions() const;
+
         void optimize(); // TODO: Implement
 
         void print() const;
@@ -38,6 +74,14 @@ namespace stride::ast
         {
             return this->_files;
         }
+
+        /// Nodes created while analyzing the parsed files should be allocated here too,
+        /// see <code>AstArena::Scope</code>.
+        [[nodiscard]]
+        AstArena& get_arena() const
+        {
+            return *this->_arena;
+        }
     };
 
     std::unique_ptr<IAstNode> parse_next_statement(
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cassert>
+#include <concepts>
+#include <cstdint>
 #include <type_traits>
 
 namespace stride::ast
@@ -7,6 +10,97 @@ namespace stride::ast
     class IAstExpression;
     class IAstType;
     class IAstNode;
+    enum class AstNodeKind : uint8_t;
+
+    /// Concrete node classes, identified by a single <code>AstNodeKind</code>
+    template <typename T>
+    concept HasNodeKind = requires
+    {
+        { T::KIND } -> std::convertible_to<AstNodeKind>;
+    };
+
+    /// Abstract node classes, whose subclasses have the kinds <code>FIRST_KIND</code> up to and including <code>LAST_KIND</code>
+    template <typename T>
+    concept HasNodeKindRange = requires
+    {
+        { T::FIRST_KIND } -> std::convertible_to<AstNodeKind>;
+        { T::LAST_KIND } -> std::convertible_to<AstNodeKind>;
+    };
+
+    /// Node classes that can't be identified by their kinds, and check nodes with <code>classof</code> instead
+    template <typename T>
+    concept HasNodeClassof = requires(const IAstNode* node)
+    {
+        { T::classof(node) } -> std::same_as<bool>;
+    };
+
+    template <typename T>
+    concept IsNodeClass = HasNodeKind<T> || HasNodeClassof<T> || HasNodeKindRange<T>;
+
+    /**
+     * Whether <code>node</code> is a <code>T</code>, decided by the kind of the node rather than RTTI.
+     * <code>node</code> must not be null.
+     */
+    template <typename T, typename From>
+        requires IsNodeClass<T>
+    [[nodiscard]] bool isa(const From* node)
+    {
+        assert(node != nullptr && "isa<T> on a null node");
+
+        // Subclasses inherit the members of their base, so the most specific check comes first
+        if constexpr (HasNodeKind<T>)
+        {
+            return node->get_kind() == T::KIND;
+        }
+        else if constexpr (HasNodeClassof<T>)
+        {
+            return T::classof(node);
+        }
+        else
+        {
+            const auto kind = node->get_kind();
+            return kind >= T::FIRST_KIND && kind <= T::LAST_KIND;
+        }
+    }
+
+    /**
+     * Casts a node pointer to <code>To</code> (a pointer type) if the node is of that class, or returns
+     * <code>nullptr</code> otherwise. Node classes are checked by their kind; interfaces that aren't
+     * node classes, such as <code>IAstContainer</code>, fall back to <code>dynamic_cast</code>.
+     */
+    template <typename To, typename From>
+    [[nodiscard]] To dyn_cast(From* node)
+    {
+        static_assert(std::is_pointer_v<To>, "Template parameter To must be a pointer type");
+        using Target = std::remove_cv_t<std::remove_pointer_t<To>>;
+        using Source = std::remove_cv_t<From>;
+
+        if constexpr (std::is_base_of_v<Target, Source>)
+        {
+            return node;
+        }
+        else if constexpr (std::is_base_of_v<IAstNode, Source> && IsNodeClass<Target>)
+        {
+            if (node == nullptr || !isa<Target>(node))
+            {
+                return nullptr;
+            }
+            return static_cast<To>(node);
+        }
+        else
+        {
+            return dynamic_cast<To>(node);
+        }
+    }
+
+    /// Casts a node pointer to <code>To</code>, which the node must be an instance of.
+    template <typename To, typename From>
+    [[nodiscard]] To cast(From* node)
+    {
+        const auto result = dyn_cast<To>(node);
+        assert((node == nullptr || result != nullptr) && "cast<To> on a node of a different class");
+        return result;
+    }
 
     template <typename To, typename From>
     [[nodiscard]] decltype(auto) cast_expr(From&& expr)
@@ -14,7 +108,7 @@ namespace stride::ast
         static_assert(
             std::is_base_of_v<IAstExpression, std::remove_pointer_t<To>>,
             "Template parameter From must be derived from IAstExpression");
-        return dynamic_cast<To>(expr);
+        return dyn_cast<To>(expr);
     }
 
     template <typename To, typename From>
@@ -23,7 +117,7 @@ namespace stride::ast
         static_assert(
             std::is_base_of_v<IAstType, std::remove_pointer_t<To>>,
             "Template parameter From must be derived from IAstType");
-        return dynamic_cast<To>(type);
+        return dyn_cast<To>(type);
     }
 
     template <typename To, typename From>
@@ -32,6 +126,6 @@ namespace stride::ast
         static_assert(
             std::is_base_of_v<IAstNode, std::remove_pointer_t<To>>,
             "Template parameter From must be derived from IAstNode");
-        return dynamic_cast<To>(type);
+        return dyn_cast<To>(type);
     }
 } // namespace stride::ast
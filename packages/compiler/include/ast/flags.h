@@ -26,3 +26,6 @@
 
 #define SRFLAG_FN_PARAM_DEF_VARIADIC (0x1)
 #define SRFLAG_FN_PARAM_DEF_MUTABLE (0x2)
+
+// Set on string literal tokens containing escape sequences; their unescaped value is stored in the source file
+#define SRFLAG_TOKEN_ESCAPED_LITERAL (0x1)
@@ -1,5 +1,12 @@
 #pragma once
+#include "files.h"
+#include "ast/nodes/type_interner.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -25,6 +32,58 @@ namespace stride::ast
 #define EMPTY_GENERIC_PARAMETER_LIST (GenericParameterList{})
 #define EMPTY_GENERIC_TYPE_LIST (GenericTypeList{})
 
+    /**
+     * Instantiations of one generic type definition, by their type arguments.
+     *
+     * Every distinct list of type arguments is instantiated once, and all uses with those arguments
+     * share the resulting canonical type, so the cost of a generic type doesn't grow with the number
+     * of times it is used. Type arguments are told apart by their interned type ids, which identify
+     * aliases by name only. As type definitions may appear in any block or module, aliases among the
+     * arguments are also told apart by the definitions they resolve to. Arguments with aliases that
+     * don't resolve are instantiated on every use, rather than cached.
+     *
+     * Instantiations only live until the analysis they were made for is discarded, see
+     * <code>get_analysis_generation</code>, as the definitions of their arguments may be gone by then.
+     *
+     * Instantiations may be requested from the threads analyzing different files at once.
+     */
+    class GenericInstantiationCache
+    {
+        /// The type ids of the arguments, and the definitions of the aliases among them, in order
+        using Key = std::pair<std::vector<TypeId>, std::vector<const definition::TypeDefinition*>>;
+
+        std::mutex _mutex;
+        std::map<Key, std::unique_ptr<IAstType>> _instantiations;
+        std::vector<std::unique_ptr<IAstType>> _uncached_instantiations;
+
+        /// The analysis generation the instantiations were made in
+        uint64_t _generation = 0;
+
+    public:
+        /// Returns the canonical instantiation for <code>type_arguments</code>, creating it with
+        /// <code>instantiate</code> on first use. Throws if creating it requires the instantiation itself,
+        /// i.e. if the generic type resolves to itself.
+        IAstType* get_or_instantiate(
+            const GenericTypeList& type_arguments,
+            const std::function<std::unique_ptr<IAstType>()>& instantiate,
+            const std::string& type_name,
+            const SourceFragment& use_site
+        );
+
+        [[nodiscard]]
+        size_t size();
+    };
+
+    /**
+     * @brief The number of times analysis results have been discarded, see <code>ParsingContext::discard_analysis</code>.
+     *
+     * Generic instantiations, and the pointers to them cached by the nodes using them, are only valid in the
+     * generation they were looked up in. Analysis must not run while a generation is advanced.
+     */
+    uint64_t get_analysis_generation();
+
+    void advance_analysis_generation();
+
     GenericParameterList parse_generic_declaration(TokenSet& set);
 
     GenericTypeList parse_generic_type_arguments(const std::shared_ptr<ParsingContext>& context, TokenSet& set);
@@ -45,4 +104,14 @@ namespace stride::ast
         AstObjectType* type,
         const definition::TypeDefinition* type_definition
     );
+
+    /// The instantiation of <code>type_definition</code> with <code>type_arguments</code>, with every
+    /// alias it resolves to followed, shared by all uses with the same arguments.
+    /// See <code>GenericInstantiationCache</code>.
+    IAstType* get_generic_instantiation(
+        const definition::TypeDefinition* type_definition,
+        const std::string& type_name,
+        const GenericTypeList& type_arguments,
+        const SourceFragment& use_site
+    );
 }
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "files.h"
+#include "ast/tokens/token_set.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace stride::ast
+{
+    class AstBlock;
+    class IAstNode;
+    class ParsingContext;
+
+    namespace tokenizer
+    {
+        struct RetokenizedSet;
+    }
+
+    /**
+     * @brief Keeps the tree of a single file up to date while it is being edited.
+     *
+     * After an edit, only the edited region is lexed again, and only the top-level statements
+     * (functions, types, modules, ...) overlapping it are parsed again. All other statements are
+     * reused, together with the definitions they made while being parsed.
+     *
+     * Reused statements keep referring to the revision of the file they were parsed from. Their
+     * text is the same in the current revision, as statements are only reused if they don't share a
+     * line with the edit. Lines moved by an edit are numbered as in the current revision, see
+     * <code>SourceFile::add_revision</code>.
+     *
+     * Definitions made by semantic analysis are discarded on every update, so the tree returned by
+     * <code>get_root</code> can be analyzed again after each update.
+     */
+    class IncrementalParser
+    {
+        struct Statement
+        {
+            std::unique_ptr<IAstNode> node;
+
+            /// Tokens <code>[first_token, end_token)</code> of the current token set
+            int64_t first_token;
+            int64_t end_token;
+
+            /// Number of definitions this statement made in the root context while being parsed
+            size_t definition_count;
+        };
+
+        std::shared_ptr<SourceFile> _source;
+
+        /// Tokens of the current revision, unless it failed to lex
+        std::optional<TokenSet> _tokens;
+
+        std::shared_ptr<ParsingContext> _context;
+
+        /// Top-level statements in source order. Tokens not covered by a statement still have to be
+        /// parsed, which is the case after an update failed to parse.
+        std::vector<Statement> _statements;
+
+        /// Owns the nodes of all statements, if the current revision parsed successfully
+        std::unique_ptr<AstBlock> _root;
+
+        size_t _reused_statement_count = 0;
+        size_t _parsed_statement_count = 0;
+
+    public:
+        /// Nothing is parsed until <code>parse</code> is called.
+        explicit IncrementalParser(std::shared_ptr<SourceFile> source);
+
+        ~IncrementalParser();
+
+        IncrementalParser(const IncrementalParser&) = delete;
+        IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+        /**
+         * @brief Parses every part of the current revision that hasn't been parsed yet.
+         *
+         * Throws a <code>parsing_error</code> if the file doesn't parse. Statements that did parse are
+         * kept, so the next update only has to continue from where parsing failed.
+         */
+        void parse();
+
+        /**
+         * @brief Applies an edit to the current revision, and updates the tree accordingly.
+         *
+         * The edit is applied even if the edited file fails to parse, in which case a
+         * <code>parsing_error</code> is thrown and <code>get_root</code> returns nullptr until a
+         * later edit fixes it. The previous root is invalidated either way.
+         */
+        void update(const SourceEdit& edit);
+
+        /// The tree of the current revision, or nullptr if it doesn't parse.
+        [[nodiscard]]
+        AstBlock* get_root() const
+        {
+            return this->_root.get();
+        }
+
+        [[nodiscard]]
+        std::shared_ptr<SourceFile> get_source() const
+        {
+            return this->_source;
+        }
+
+        [[nodiscard]]
+        std::shared_ptr<ParsingContext> get_context() const
+        {
+            return this->_context;
+        }
+
+        /// Number of top-level statements the last update reused.
+        [[nodiscard]]
+        size_t get_reused_statement_count() const
+        {
+            return this->_reused_statement_count;
+        }
+
+        /// Number of top-level statements the last update had to parse.
+        [[nodiscard]]
+        size_t get_parsed_statement_count() const
+        {
+            return this->_parsed_statement_count;
+        }
+
+    private:
+        void parse_statements();
+
+        void reclaim_nodes();
+
+        void discard_statements();
+
+        void retain_statements(const SourceEdit& edit, const tokenizer::RetokenizedSet& retokenized);
+    };
+} // namespace stride::ast
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace stride::ast
+{
+    using InternedId = uint32_t;
+
+    /**
+     * Global, thread-safe string interner.
+     *
+     * Every distinct string is stored exactly once and identified by a small integer id, so
+     * comparing interned strings is an integer comparison. Interned strings live until the
+     * process exits. The empty string always has id 0.
+     */
+    namespace interner
+    {
+        /// Returns the id of the given string, storing it if it hasn't been interned before.
+        InternedId intern(std::string_view value);
+
+        /// Returns the id of the given string, if it has been interned before.
+        std::optional<InternedId> find(std::string_view value);
+
+        /// Returns the string belonging to an id obtained from <code>intern</code>.
+        const std::string& resolve(InternedId id);
+
+        /// The number of distinct strings interned so far.
+        size_t size();
+    } // namespace interner
+
+    /**
+     * Handle to an interned string. Equality is decided by comparing ids,
+     * and the handle converts to the string it refers to where a string is expected.
+     */
+    class InternedString
+    {
+        InternedId _id;
+
+        explicit InternedString(const InternedId id, std::nullptr_t) :
+            _id(id) {}
+
+    public:
+        InternedString() :
+            _id(0) {}
+
+        explicit InternedString(const std::string_view value) :
+            _id(interner::intern(value)) {}
+
+        /// Returns a handle to <code>value</code> without interning it, if it has been interned before.
+        /// If it hasn't, no interned string can be equal to it either.
+        static std::optional<InternedString> find(const std::string_view value)
+        {
+            if (const auto id = interner::find(value))
+            {
+                return InternedString(id.value(), nullptr);
+            }
+            return std::nullopt;
+        }
+
+        [[nodiscard]]
+        InternedId id() const
+        {
+            return this->_id;
+        }
+
+        [[nodiscard]]
+        const std::string& str() const
+        {
+            return interner::resolve(this->_id);
+        }
+
+        [[nodiscard]]
+        bool empty() const
+        {
+            return this->_id == 0;
+        }
+
+        operator const std::string&() const
+        {
+            return this->str();
+        }
+
+        bool operator==(const InternedString& other) const
+        {
+            return this->_id == other._id;
+        }
+
+        bool operator==(const std::string_view other) const
+        {
+            return this->str() == other;
+        }
+    };
+} // namespace stride::ast
+
+template <>
+struct std::hash<stride::ast::InternedString>
+{
+    size_t operator()(const stride::ast::InternedString& value) const noexcept
+    {
+        return std::hash<stride::ast::InternedId>{}(value.id());
+    }
+};
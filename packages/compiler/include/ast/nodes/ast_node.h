@@ -1,7 +1,11 @@
 #pragma once
 
 #include "files.h"
+#include "ast/arena.h"
+#include "ast/casting.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 
 namespace llvm
@@ -19,21 +23,119 @@ namespace stride::ast
     class AstBlock;
     class ParsingContext;
 
+    /**
+     * Concrete class of a node, for checking the type of a node with a single comparison, see
+     * <code>casting.h</code>. Every concrete node class declares its kind as <code>KIND</code>.
+     * Subclasses of the same abstract class are listed together, so that the abstract class can
+     * check for a range of kinds.
+     */
+    enum class AstNodeKind : uint8_t
+    {
+        // IAstType
+        PRIMITIVE_TYPE,
+        ALIAS_TYPE,
+        FUNCTION_TYPE,
+        ARRAY_TYPE,
+        OBJECT_TYPE,
+        TUPLE_TYPE,
+
+        // IAstExpression
+        ARRAY,
+        IDENTIFIER,
+        ARRAY_MEMBER_ACCESSOR,
+        CHAINED_EXPRESSION,
+        INDIRECT_CALL,
+        FUNCTION_CALL,
+        VARIABLE_DECLARATION,
+        UNARY_OP,
+        VARIABLE_REASSIGNMENT,
+        OBJECT_INITIALIZER,
+        VARIADIC_ARG_REFERENCE,
+        TUPLE_INITIALIZER,
+        TYPE_CAST_OP,
+
+        // IBinaryOp
+        BINARY_ARITHMETIC_OP,
+        LOGICAL_OP,
+        COMPARISON_OP,
+
+        // AstLiteral
+        STRING_LITERAL,
+        INT_LITERAL,
+        FP_LITERAL,
+        BOOLEAN_LITERAL,
+        CHAR_LITERAL,
+        NIL_LITERAL,
+
+        // IAstFunction, which is instantiated itself when cloning functions
+        FUNCTION,
+        FUNCTION_DECLARATION,
+        LAMBDA_FUNCTION_EXPRESSION,
+
+        // IAstControlFlowStatement
+        CONTINUE_STATEMENT,
+        BREAK_STATEMENT,
+
+        FUNCTION_PARAMETER,
+        BLOCK,
+        CONDITIONAL_STATEMENT,
+        SWITCH_BRANCH,
+        SWITCH,
+        WHILE_LOOP,
+        FOR_LOOP,
+        RETURN_STATEMENT,
+        IMPORT,
+        PACKAGE,
+        MODULE,
+        TYPE_DEFINITION,
+        ENUMERABLE_MEMBER,
+        ENUMERABLE,
+    };
+
+    /// Number of node kinds, for checking that every kind belongs to a class
+    constexpr size_t AST_NODE_KIND_COUNT = static_cast<size_t>(AstNodeKind::ENUMERABLE) + 1;
+
+    /// Whether <code>kind</code> lies within the kinds <code>first</code> up to and including <code>last</code>
+    constexpr bool is_node_kind_in_range(const AstNodeKind kind, const AstNodeKind first, const AstNodeKind last)
+    {
+        return kind >= first && kind <= last;
+    }
+
     class IAstNode
     {
         const SourceFragment _source_position;
         const std::shared_ptr<ParsingContext> _context;
+        const AstNodeKind _kind;
 
     public:
         explicit IAstNode(
+            const AstNodeKind kind,
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context
         ) :
             _source_position(source),
-            _context(context) {}
+            _context(context),
+            _kind(kind) {}
 
         virtual ~IAstNode() = default;
 
+        [[nodiscard]]
+        AstNodeKind get_kind() const
+        {
+            return this->_kind;
+        }
+
+        /// Nodes are placed in the arena of the current compilation, if one is installed
+        static void* operator new(const size_t size)
+        {
+            return allocate_ast_memory(size);
+        }
+
+        static void operator delete(void* memory) noexcept
+        {
+            deallocate_ast_memory(memory);
+        }
+
         virtual std::string to_string() = 0;
 
         virtual void validate() {}
@@ -45,13 +147,13 @@ namespace stride::ast
         }
 
         [[nodiscard]]
-        std::shared_ptr<ParsingContext> get_context() const
+        const std::shared_ptr<ParsingContext>& get_context() const
         {
             return this->_context;
         }
 
         [[nodiscard]]
-        SourceFragment get_source_fragment() const
+        const SourceFragment& get_source_fragment() const
         {
             return this->_source_position;
         }
@@ -76,7 +178,7 @@ namespace stride::ast
                           "T must be a subclass of IAstNode");
 
             auto base = this->clone();
-            if (const auto ptr = dynamic_cast<T*>(base.get()))
+            if (const auto ptr = dyn_cast<T*>(base.get()))
             {
                 base.release();
                 return std::unique_ptr<T>(ptr);
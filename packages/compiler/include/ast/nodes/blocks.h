@@ -3,11 +3,12 @@
 #include "ast/nodes/ast_node.h"
 
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace stride::ast
 {
-    enum class TokenType;
+    enum class TokenType : uint8_t;
     class TokenSet;
 
     class AstBlock
@@ -16,12 +17,14 @@ namespace stride::ast
         std::vector<std::unique_ptr<IAstNode>> _children;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::BLOCK;
+
         explicit AstBlock(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::vector<std::unique_ptr<IAstNode>> children
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _children(std::move(children)) {}
 
         std::string to_string() override;
@@ -46,6 +49,12 @@ namespace stride::ast
             return this->_children;
         }
 
+        /// Moves all children out of this block, leaving it empty.
+        std::vector<std::unique_ptr<IAstNode>> release_children()
+        {
+            return std::exchange(this->_children, {});
+        }
+
         ~AstBlock() override = default;
 
         static std::unique_ptr<AstBlock> create_empty(
@@ -16,6 +16,8 @@ namespace stride::ast
         std::unique_ptr<AstBlock> _else_body;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::CONDITIONAL_STATEMENT;
+
         explicit AstConditionalStatement(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -23,7 +25,7 @@ namespace stride::ast
             std::unique_ptr<AstBlock> body,
             std::unique_ptr<AstBlock> else_body
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _condition(std::move(condition)),
             _body(std::move(body)),
             _else_body(std::move(else_body)) {}
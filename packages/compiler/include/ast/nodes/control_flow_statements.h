@@ -9,21 +9,28 @@ namespace stride::ast
     {
     public:
         explicit IAstControlFlowStatement(
+            const AstNodeKind kind,
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context
         ) :
-            IAstNode(source, context) {}
+            IAstNode(kind, source, context) {}
+
+        /// Kinds of the concrete subclasses
+        static constexpr AstNodeKind FIRST_KIND = AstNodeKind::CONTINUE_STATEMENT;
+        static constexpr AstNodeKind LAST_KIND = AstNodeKind::BREAK_STATEMENT;
     };
 
     class AstContinueStatement
         : public IAstControlFlowStatement
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::CONTINUE_STATEMENT;
+
         explicit AstContinueStatement(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context
         ) :
-            IAstControlFlowStatement(source, context) {}
+            IAstControlFlowStatement(KIND, source, context) {}
 
         llvm::Value* codegen(llvm::Module* module, llvm::IRBuilderBase* builder) override;
 
@@ -41,11 +48,13 @@ namespace stride::ast
         : public IAstControlFlowStatement
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::BREAK_STATEMENT;
+
         explicit AstBreakStatement(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context
         ) :
-            IAstControlFlowStatement(source, context) {}
+            IAstControlFlowStatement(KIND, source, context) {}
 
         llvm::Value* codegen(llvm::Module* module, llvm::IRBuilderBase* builder) override;
 
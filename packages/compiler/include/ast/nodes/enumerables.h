@@ -16,13 +16,15 @@ namespace stride::ast
         std::unique_ptr<AstLiteral> _value;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::ENUMERABLE_MEMBER;
+
         explicit AstEnumerableMember(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::string name,
             std::unique_ptr<AstLiteral> value
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _name(std::move(name)),
             _value(std::move(value)) {}
 
@@ -55,13 +57,15 @@ namespace stride::ast
         std::string _name;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::ENUMERABLE;
+
         explicit AstEnumerable(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::vector<std::unique_ptr<AstEnumerableMember>> members,
             std::string name
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _members(std::move(members)),
             _name(std::move(name)) {}
 
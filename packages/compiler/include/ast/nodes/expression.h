@@ -13,7 +13,7 @@ namespace llvm
 namespace stride::ast
 {
     enum class VisibilityModifier;
-    enum class TokenType;
+    enum class TokenType : uint8_t;
     class AstLiteral;
     class AstFunctionParameter;
     class ParsingContext;
@@ -89,13 +89,18 @@ namespace stride::ast
 
     public:
         explicit IAstExpression(
+            const AstNodeKind kind,
             const SourceFragment& source_position,
             const std::shared_ptr<ParsingContext>& context
         ) :
-            IAstNode(source_position, context) {}
+            IAstNode(kind, source_position, context) {}
 
         ~IAstExpression() override = default;
 
+        /// Kinds of the concrete subclasses
+        static constexpr AstNodeKind FIRST_KIND = AstNodeKind::ARRAY;
+        static constexpr AstNodeKind LAST_KIND = AstNodeKind::LAMBDA_FUNCTION_EXPRESSION;
+
         llvm::Value* codegen(
             llvm::Module* module,
             llvm::IRBuilderBase* builder) override;
@@ -142,12 +147,14 @@ namespace stride::ast
         ExpressionList _elements;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::ARRAY;
+
         explicit AstArray(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             ExpressionList elements
         ) :
-            IAstExpression(source, context),
+            IAstExpression(KIND, source, context),
             _elements(std::move(elements)) {}
 
         [[nodiscard]]
@@ -179,11 +186,13 @@ namespace stride::ast
         Symbol _symbol;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::IDENTIFIER;
+
         explicit AstIdentifier(
             const std::shared_ptr<ParsingContext>& context,
             Symbol symbol
         ) :
-            IAstExpression(symbol.symbol_position, context),
+            IAstExpression(KIND, symbol.symbol_position, context),
             _symbol(std::move(symbol)) {}
 
         [[nodiscard]]
@@ -228,13 +237,15 @@ namespace stride::ast
         std::unique_ptr<IAstExpression> _index_accessor_expr;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::ARRAY_MEMBER_ACCESSOR;
+
         explicit AstArrayMemberAccessor(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::unique_ptr<IAstExpression> array_base,
             std::unique_ptr<IAstExpression> index_expr
         ) :
-            IAstExpression(source, context),
+            IAstExpression(KIND, source, context),
             _array_base(std::move(array_base)),
             _index_accessor_expr(std::move(index_expr)) {}
 
@@ -275,13 +286,15 @@ namespace stride::ast
         std::unique_ptr<IAstExpression> _followup; // always AstIdentifier at each leaf
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::CHAINED_EXPRESSION;
+
         explicit AstChainedExpression(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::unique_ptr<IAstExpression> base,
             std::unique_ptr<IAstExpression> followup
         ) :
-            IAstExpression(source, context),
+            IAstExpression(KIND, source, context),
             _base(std::move(base)),
             _followup(std::move(followup)) {}
 
@@ -328,13 +341,15 @@ namespace stride::ast
         ExpressionList _args;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::INDIRECT_CALL;
+
         explicit AstIndirectCall(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::unique_ptr<IAstExpression> callee,
             ExpressionList args
         ) :
-            IAstExpression(source, context),
+            IAstExpression(KIND, source, context),
             _callee(std::move(callee)),
             _args(std::move(args)) {}
 
@@ -380,13 +395,15 @@ namespace stride::ast
         int _flags;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::FUNCTION_CALL;
+
         explicit AstFunctionCall(
             const std::shared_ptr<ParsingContext>& context,
             std::unique_ptr<AstIdentifier> function_name_identifier,
             ExpressionList arguments,
             const int flags = SRFLAG_NONE
         ) :
-            IAstExpression(function_name_identifier->get_source_fragment(), context),
+            IAstExpression(KIND, function_name_identifier->get_source_fragment(), context),
             _arguments(std::move(arguments)),
             _function_name_identifier(std::move(function_name_identifier)),
             _flags(flags) {}
@@ -424,6 +441,12 @@ namespace stride::ast
             return (this->_flags & SRFLAG_FN_TYPE_VARIADIC) != 0;
         }
 
+        [[nodiscard]]
+        int get_flags() const
+        {
+            return this->_flags;
+        }
+
         std::string to_string() override;
 
         llvm::Value* codegen(
@@ -479,6 +502,8 @@ namespace stride::ast
         const int _flags;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::VARIABLE_DECLARATION;
+
         explicit AstVariableDeclaration(
             const std::shared_ptr<ParsingContext>& context,
             Symbol symbol,
@@ -487,7 +512,7 @@ namespace stride::ast
             VisibilityModifier visibility,
             const int flags = SRFLAG_NONE
         ) :
-            IAstExpression(symbol.symbol_position, context),
+            IAstExpression(KIND, symbol.symbol_position, context),
             _annotated_type(std::move(variable_type)),
             _initial_value(std::move(initial_value)),
             _visibility(visibility),
@@ -573,15 +598,20 @@ namespace stride::ast
         friend class AstComparisonOp;
 
         explicit IBinaryOp(
+            const AstNodeKind kind,
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::unique_ptr<IAstExpression> lsh,
             std::unique_ptr<IAstExpression> rsh
         ) :
-            IAstExpression(source, context),
+            IAstExpression(kind, source, context),
             _lhs(std::move(lsh)),
             _rhs(std::move(rsh)) {}
 
+        /// Kinds of the concrete subclasses
+        static constexpr AstNodeKind FIRST_KIND = AstNodeKind::BINARY_ARITHMETIC_OP;
+        static constexpr AstNodeKind LAST_KIND = AstNodeKind::COMPARISON_OP;
+
         [[nodiscard]]
         IAstExpression* get_left() const
         {
@@ -601,6 +631,8 @@ namespace stride::ast
         const BinaryOpType _op_type;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::BINARY_ARITHMETIC_OP;
+
         explicit AstBinaryArithmeticOp(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -608,7 +640,7 @@ namespace stride::ast
             const BinaryOpType op,
             std::unique_ptr<IAstExpression> right
         ) :
-            IBinaryOp(
+            IBinaryOp(KIND,
                 source,
                 context,
                 std::move(left),
@@ -643,6 +675,8 @@ namespace stride::ast
         LogicalOpType _op_type;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::LOGICAL_OP;
+
         explicit AstLogicalOp(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -650,7 +684,7 @@ namespace stride::ast
             const LogicalOpType op,
             std::unique_ptr<IAstExpression> right
         ) :
-            IBinaryOp(source, context, std::move(left), std::move(right)),
+            IBinaryOp(KIND, source, context, std::move(left), std::move(right)),
             _op_type(op) {}
 
         [[nodiscard]]
@@ -676,6 +710,8 @@ namespace stride::ast
         ComparisonOpType _op_type;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::COMPARISON_OP;
+
         explicit AstComparisonOp(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -683,7 +719,7 @@ namespace stride::ast
             const ComparisonOpType op,
             std::unique_ptr<IAstExpression> right
         ) :
-            IBinaryOp(source, context, std::move(left), std::move(right)),
+            IBinaryOp(KIND, source, context, std::move(left), std::move(right)),
             _op_type(op) {}
 
         [[nodiscard]]
@@ -710,13 +746,15 @@ namespace stride::ast
         std::unique_ptr<IAstExpression> _operand;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::UNARY_OP;
+
         explicit AstUnaryOp(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             const UnaryOpType op,
             std::unique_ptr<IAstExpression> operand
         ) :
-            IAstExpression(source, context),
+            IAstExpression(KIND, source, context),
             _op_type(op),
             _operand(std::move(operand)) {}
 
@@ -765,6 +803,8 @@ namespace stride::ast
         std::optional<std::string> _internal_name;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::VARIABLE_REASSIGNMENT;
+
         explicit AstVariableReassignment(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -772,7 +812,7 @@ namespace stride::ast
             const MutativeAssignmentType op,
             std::unique_ptr<IAstExpression> value
         ) :
-            IAstExpression(source, context),
+            IAstExpression(KIND, source, context),
             _identifier(std::move(identifier)),
             _value(std::move(value)),
             _operator(op) {}
@@ -829,10 +869,16 @@ namespace stride::ast
         std::vector<StructMemberInitializerPair> _member_initializers;
         GenericTypeList _generic_type_arguments;
 
-        // Instantiated type, if initializer is generic
-        std::unique_ptr<AstObjectType> _object_type = nullptr;
+        // Instantiated type, either owned by this initializer, or shared by all uses of a generic instantiation
+        AstObjectType* _object_type = nullptr;
+        std::unique_ptr<AstObjectType> _owned_object_type = nullptr;
+
+        // The analysis generation a shared instantiation was looked up in, after which it may be gone
+        uint64_t _instantiation_generation = 0;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::OBJECT_INITIALIZER;
+
         explicit AstObjectInitializer(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -840,7 +886,7 @@ namespace stride::ast
             std::vector<StructMemberInitializerPair> member_initializers,
             GenericTypeList generic_type_arguments = {}
         ) :
-            IAstExpression(source, context),
+            IAstExpression(KIND, source, context),
             _object_type_name(std::move(struct_name)),
             _member_initializers(std::move(member_initializers)),
             _generic_type_arguments(std::move(generic_type_arguments)) {}
@@ -880,17 +926,19 @@ namespace stride::ast
         void resolve_forward_references(llvm::Module* module, llvm::IRBuilderBase* builder) override;
 
     private:
-        std::unique_ptr<AstObjectType> get_instantiated_object_type();
+        AstObjectType* get_instantiated_object_type();
     };
 
     class AstVariadicArgReference
         : public IAstExpression
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::VARIADIC_ARG_REFERENCE;
+
         explicit AstVariadicArgReference(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context) :
-            IAstExpression(source, context) {}
+            IAstExpression(KIND, source, context) {}
 
         llvm::Value* codegen(
             llvm::Module* module,
@@ -918,12 +966,14 @@ namespace stride::ast
         ExpressionList _members;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::TUPLE_INITIALIZER;
+
         explicit AstTupleInitializer(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             ExpressionList members
         ) :
-            IAstExpression(source, context),
+            IAstExpression(KIND, source, context),
             _members(std::move(members)) {}
 
         [[nodiscard]]
@@ -950,13 +1000,15 @@ namespace stride::ast
         std::unique_ptr<IAstType> _target_type;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::TYPE_CAST_OP;
+
         explicit AstTypeCastOp(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::unique_ptr<IAstExpression> value,
             std::unique_ptr<IAstType> target_type
         ) :
-            IAstExpression(source, context),
+            IAstExpression(KIND, source, context),
             _value(std::move(value)),
             _target_type(std::move(target_type)) {}
 
@@ -1029,12 +1081,11 @@ namespace stride::ast
         AstIdentifier* identifier,
         TokenSet& set);
 
-    /// Parses a binary arithmetic operation using precedence climbing
-    std::optional<std::unique_ptr<IAstExpression>>
-    parse_arithmetic_binary_operation_optional(
+    /// Parses binary, comparison, logical and type cast operations whose operators bind at least
+    /// as tight as <code>min_precedence</code>. Pass 1 to parse a complete expression.
+    std::unique_ptr<IAstExpression> parse_binary_expression(
         const std::shared_ptr<ParsingContext>& context,
         TokenSet& set,
-        std::unique_ptr<IAstExpression> lhs,
         int min_precedence
     );
 
@@ -1090,10 +1141,11 @@ namespace stride::ast
         TokenSet& set
     );
 
-    std::optional<std::unique_ptr<IAstExpression>> parse_type_cast_op(
+    /// Parses a type cast: consumes `as <type>` and wraps the value being cast
+    std::unique_ptr<IAstExpression> parse_type_cast_op(
         const std::shared_ptr<ParsingContext>& context,
         TokenSet& set,
-        IAstExpression* lhs
+        std::unique_ptr<IAstExpression> lhs
     );
 
     /* # * # * # * # * # * # * # * # * # * # * # * # * # * # * # *
@@ -1102,9 +1154,6 @@ namespace stride::ast
      #                                                           #
      * # * # * # * # * # * # * # * # * # * # * # * # * # * # * # */
 
-    /// Returns the precedence value for a binary arithmetic operator
-    int get_binary_operator_precedence(BinaryOpType type);
-
     /// Converts a token type to its corresponding logical operator type
     std::optional<LogicalOpType> get_logical_op_type(TokenType type);
 
@@ -15,6 +15,8 @@ namespace stride::ast
         std::unique_ptr<IAstExpression> _incrementor;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::FOR_LOOP;
+
         explicit AstForLoop(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -23,7 +25,7 @@ namespace stride::ast
             std::unique_ptr<IAstExpression> increment,
             std::unique_ptr<AstBlock> body
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _body(std::move(body)),
             _initializer(std::move(initiator)),
             _condition(std::move(condition)),
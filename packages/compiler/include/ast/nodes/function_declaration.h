@@ -4,7 +4,10 @@
 #include "blocks.h"
 #include "expression.h"
 #include "ast/modifiers.h"
+#include "ast/tokens/token_set.h"
 
+#include <algorithm>
+#include <optional>
 #include <utility>
 
 namespace llvm
@@ -28,13 +31,15 @@ namespace stride::ast
         std::unique_ptr<IAstType> _type;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::FUNCTION_PARAMETER;
+
         explicit AstFunctionParameter(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::string param_name,
             std::unique_ptr<IAstType> param_type
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _name(std::move(param_name)),
             _type(std::move(param_type)) {}
 
@@ -86,11 +91,15 @@ namespace stride::ast
         /// a numeric ID), so we must track them by pointer instead.
         llvm::Function* _llvm_function = nullptr;
 
+        /// Tokens of the body, braces included, while parsing it is deferred, see <code>LazyParsingScope</code>.
+        std::optional<TokenSet> _deferred_body;
+
         friend class AstFunctionDeclaration;
         friend class AstFunctionParameter;
 
     public:
         explicit IAstFunction(
+            const AstNodeKind kind,
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             Symbol symbol,
@@ -101,7 +110,7 @@ namespace stride::ast
             const int flags,
             const GenericParameterList& generic_parameters
         ) :
-            IAstExpression(source, context),
+            IAstExpression(kind, source, context),
             _body(std::move(body)),
             _symbol(std::move(symbol)),
             _parameters(std::move(parameters)),
@@ -110,6 +119,10 @@ namespace stride::ast
             _generic_parameters(generic_parameters),
             _flags(flags) {}
 
+        /// Kinds of the concrete subclasses
+        static constexpr AstNodeKind FIRST_KIND = AstNodeKind::FUNCTION;
+        static constexpr AstNodeKind LAST_KIND = AstNodeKind::LAMBDA_FUNCTION_EXPRESSION;
+
         [[nodiscard]]
         const std::string& get_function_name() const
         {
@@ -210,6 +223,26 @@ namespace stride::ast
             return !this->_generic_parameters.empty();
         }
 
+        /// Whether the body was skipped while parsing, and hasn't been parsed since.
+        [[nodiscard]]
+        bool has_deferred_body() const
+        {
+            return this->_deferred_body.has_value();
+        }
+
+        /// Tokens of the deferred body, braces included, or nothing if the body isn't deferred.
+        [[nodiscard]]
+        const std::optional<TokenSet>& get_deferred_body() const
+        {
+            return this->_deferred_body;
+        }
+
+        /// Keeps the tokens of the body, braces included, so it can be parsed once the function is needed.
+        void defer_body(TokenSet body_tokens);
+
+        /// Parses the deferred body, if there is one.
+        void parse_deferred_body();
+
         [[nodiscard]]
         const std::vector<Symbol>& get_captured_variables() const
         {
@@ -218,6 +251,17 @@ namespace stride::ast
 
         void add_captured_variable(const Symbol& symbol)
         {
+            // Validation runs again when a reused tree is analyzed after an incremental reparse
+            if (std::ranges::any_of(
+                this->_captured_variables,
+                [&](const Symbol& captured)
+                {
+                    return captured.internal_name == symbol.internal_name;
+                }))
+            {
+                return;
+            }
+
             this->_captured_variables.push_back(symbol);
         }
 
@@ -245,6 +289,8 @@ namespace stride::ast
           public IAstStatement
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::FUNCTION_DECLARATION;
+
         using IAstStatement::IAstStatement;
 
         explicit AstFunctionDeclaration(
@@ -257,7 +303,7 @@ namespace stride::ast
             const int flags,
             const GenericParameterList& generic_parameters
         ) :
-            IAstFunction(
+            IAstFunction(KIND,
                 symbol.symbol_position,
                 context,
                 std::move(symbol),
@@ -278,6 +324,8 @@ namespace stride::ast
         : public IAstFunction
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::LAMBDA_FUNCTION_EXPRESSION;
+
         explicit AstLambdaFunctionExpression(
             const std::shared_ptr<ParsingContext>& context,
             Symbol symbol,
@@ -287,7 +335,7 @@ namespace stride::ast
             const VisibilityModifier visibility,
             const int flags
         ) :
-            IAstFunction(
+            IAstFunction(KIND,
                 symbol.symbol_position,
                 context,
                 std::move(symbol),
@@ -306,6 +354,31 @@ namespace stride::ast
         std::string get_mangled_name() const { return ""; }; // TODO: Implement
     };
 
+    /**
+     * @brief Defers parsing the bodies of top-level and module functions on the calling thread, for
+     * the lifetime of the scope.
+     *
+     * Only the braces of a deferred body are matched. It is parsed, analyzed and generated once
+     * <code>Ast::parse_reachable_functions</code> finds that it may be called, so errors in functions
+     * that are never used aren't reported.
+     */
+    class LazyParsingScope
+    {
+        bool _previous;
+
+    public:
+        explicit LazyParsingScope(bool enabled);
+
+        ~LazyParsingScope();
+
+        LazyParsingScope(const LazyParsingScope&) = delete;
+        LazyParsingScope& operator=(const LazyParsingScope&) = delete;
+
+        /// Whether function bodies are deferred on the calling thread.
+        [[nodiscard]]
+        static bool is_active();
+    };
+
     std::unique_ptr<AstFunctionDeclaration> parse_fn_declaration(
         const std::shared_ptr<ParsingContext>& context,
         TokenSet& set,
@@ -25,13 +25,15 @@ namespace stride::ast
         std::vector<std::unique_ptr<AstIdentifier>> _import_list;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::IMPORT;
+
         explicit AstImport(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::unique_ptr<AstIdentifier> package_identifier,
             std::vector<std::unique_ptr<AstIdentifier>> import_list
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _package_identifier(std::move(package_identifier)),
             _import_list(std::move(import_list)) {}
 
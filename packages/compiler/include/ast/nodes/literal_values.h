@@ -17,15 +17,20 @@ namespace stride::ast
 
     public:
         explicit AstLiteral(
+            const AstNodeKind kind,
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             const PrimitiveType type
         ) :
-            IAstExpression(source, context),
+            IAstExpression(kind, source, context),
             _primitive_type(type) {}
 
         ~AstLiteral() override = default;
 
+        /// Kinds of the concrete subclasses
+        static constexpr AstNodeKind FIRST_KIND = AstNodeKind::STRING_LITERAL;
+        static constexpr AstNodeKind LAST_KIND = AstNodeKind::NIL_LITERAL;
+
         std::string to_string() override = 0;
 
         [[nodiscard]]
@@ -49,14 +54,21 @@ namespace stride::ast
 
     public:
         explicit IAstLiteralBase(
+            const AstNodeKind kind,
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             const PrimitiveType type,
             T value
         ) :
-            AstLiteral(source, context, type),
+            AstLiteral(kind, source, context, type),
             _value(std::move(value)) {}
 
+        /// Literals holding the same value type don't share a range of kinds
+        static bool classof(const IAstNode* node)
+        {
+            return dynamic_cast<const IAstLiteralBase*>(node) != nullptr;
+        }
+
         [[nodiscard]]
         const T& value() const
         {
@@ -68,6 +80,8 @@ namespace stride::ast
         : public IAstLiteralBase<std::string>
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::STRING_LITERAL;
+
         explicit AstStringLiteral(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -75,7 +89,7 @@ namespace stride::ast
         ) :
             // Strings are only considered to be a single byte,
             // as they're pointing to a memory location
-            IAstLiteralBase(source, context, PrimitiveType::STRING, std::move(val)) {}
+            IAstLiteralBase(KIND, source, context, PrimitiveType::STRING, std::move(val)) {}
 
         ~AstStringLiteral() override = default;
 
@@ -94,6 +108,8 @@ namespace stride::ast
         const int _flags;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::INT_LITERAL;
+
         explicit AstIntLiteral(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -101,7 +117,7 @@ namespace stride::ast
             const int64_t value,
             const int flags = SRFLAG_TYPE_INT_SIGNED
         ) :
-            IAstLiteralBase(source, context, type, value),
+            IAstLiteralBase(KIND, source, context, type, value),
             _flags(flags) {}
 
         [[nodiscard]]
@@ -129,13 +145,15 @@ namespace stride::ast
         : public IAstLiteralBase<long double>
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::FP_LITERAL;
+
         explicit AstFpLiteral(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             const PrimitiveType type,
             const long double value
         ) :
-            IAstLiteralBase(source, context, type, value) {}
+            IAstLiteralBase(KIND, source, context, type, value) {}
 
         std::string to_string() override;
 
@@ -151,12 +169,14 @@ namespace stride::ast
         : public IAstLiteralBase<bool>
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::BOOLEAN_LITERAL;
+
         explicit AstBooleanLiteral(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             const bool value
         ) :
-            IAstLiteralBase(source, context, PrimitiveType::BOOL, value) {}
+            IAstLiteralBase(KIND, source, context, PrimitiveType::BOOL, value) {}
 
         std::string to_string() override;
 
@@ -171,12 +191,14 @@ namespace stride::ast
     class AstCharLiteral : public IAstLiteralBase<char>
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::CHAR_LITERAL;
+
         explicit AstCharLiteral(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             const char value
         ) :
-            IAstLiteralBase(source, context, PrimitiveType::CHAR, value) {}
+            IAstLiteralBase(KIND, source, context, PrimitiveType::CHAR, value) {}
 
         std::string to_string() override;
 
@@ -192,11 +214,13 @@ namespace stride::ast
         : public AstLiteral
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::NIL_LITERAL;
+
         AstNilLiteral(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context
         ) :
-            AstLiteral(source, context, PrimitiveType::NIL) {}
+            AstLiteral(KIND, source, context, PrimitiveType::NIL) {}
 
         std::string to_string() override
         {
@@ -237,6 +261,6 @@ namespace stride::ast
 
     inline bool is_literal_ast_node(IAstNode* node)
     {
-        return dynamic_cast<AstLiteral*>(node) != nullptr;
+        return node != nullptr && isa<AstLiteral>(node);
     }
 } // namespace stride::ast
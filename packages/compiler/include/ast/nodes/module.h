@@ -15,6 +15,8 @@ namespace stride::ast
         std::unique_ptr<AstBlock> _body;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::MODULE;
+
         std::string to_string() override;
 
         explicit AstModule(
@@ -23,7 +25,7 @@ namespace stride::ast
             std::string name,
             std::unique_ptr<AstBlock> body
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _name(std::move(name)),
             _body(std::move(body)) {}
 
@@ -12,12 +12,14 @@ namespace stride::ast
         std::string _name;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::PACKAGE;
+
         explicit AstPackage(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::string package_name
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _name(std::move(package_name)) {}
 
         [[nodiscard]]
@@ -26,12 +26,14 @@ namespace stride::ast
         std::optional<std::unique_ptr<IAstExpression>> _value;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::RETURN_STATEMENT;
+
         explicit AstReturnStatement(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::optional<std::unique_ptr<IAstExpression>> value
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _value(std::move(value)) {}
 
         std::string to_string() override;
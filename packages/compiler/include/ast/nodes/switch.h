@@ -13,10 +13,12 @@ namespace stride::ast
         : public IAstNode
     {
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::SWITCH_BRANCH;
+
         AstSwitchBranch(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context) :
-            IAstNode(source, context) {}
+            IAstNode(KIND, source, context) {}
     };
 
     class AstSwitch
@@ -26,11 +28,13 @@ namespace stride::ast
         std::vector<std::unique_ptr<AstSwitchBranch>> _branches;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::SWITCH;
+
         explicit AstSwitch(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::string name) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _name(std::move(name)) {}
 
         std::string to_string() override;
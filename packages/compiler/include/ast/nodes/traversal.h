@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 namespace stride::ast
 {
     class AstPackage;
@@ -22,6 +24,17 @@ namespace stride::ast
     public:
         virtual ~IVisitor() = default;
 
+        /// Called before the root block of a file is traversed, see <code>VisitorPipeline</code>.
+        virtual void begin_file(const std::string&, AstBlock*) {}
+
+        /// Whether several files may be visited at once, each on its own thread. This holds for visitors
+        /// that keep no state between nodes, and only define symbols in the contexts of the visited file.
+        [[nodiscard]]
+        virtual bool is_thread_safe() const
+        {
+            return false;
+        }
+
         /// Called for every expression node, after its sub-expressions have been visited.
         virtual void accept(IAstExpression* expr) {};
 
@@ -20,6 +20,8 @@ namespace stride:: ast
         GenericParameterList _generic_parameters;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::TYPE_DEFINITION;
+
         explicit AstTypeDefinition(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -28,7 +30,7 @@ namespace stride:: ast
             const VisibilityModifier visibility,
             GenericParameterList  generic_parameters
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _name(std::move(name)),
             _type(std::move(type)),
             _visibility(visibility),
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "ast/interner.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace stride::ast
+{
+    using TypeId = uint32_t;
+
+    enum class TypeKind : uint8_t
+    {
+        PRIMITIVE,
+        ALIAS,
+        FUNCTION,
+        ARRAY,
+        OBJECT,
+        TUPLE,
+    };
+
+    /// Structure of a type, with its nested types referred to by their ids.
+    struct TypeKey
+    {
+        TypeKind kind = TypeKind::PRIMITIVE;
+        int flags = 0;
+
+        /// The <code>PrimitiveType</code> of primitives, or the interned name of aliases and objects
+        uint32_t detail = 0;
+
+        /// Initial length of arrays
+        size_t length = 0;
+
+        /// The element type of arrays, the return and then parameter types of functions, the members of
+        /// tuples, the member types and then generic arguments of objects, and the generic arguments of aliases
+        std::vector<TypeId> children;
+
+        /// Field names of objects, in the order of their member types
+        std::vector<InternedId> member_names;
+
+        bool operator==(const TypeKey& other) const = default;
+    };
+
+    struct InternedType
+    {
+        TypeId id;
+
+        /**
+         * The type with everything <code>IAstType::equals</code> ignores left out: flags, array lengths,
+         * and the names and generic arguments of objects. Types of the same shape are equal.
+         */
+        TypeId shape;
+
+        /**
+         * Whether types of this shape only equal types of the same shape. Aliases, object types and
+         * <code>nil</code> can equal types of other shapes, so types containing them aren't exact.
+         */
+        bool is_exact;
+    };
+
+    /**
+     * Global, thread-safe type interner.
+     *
+     * Every distinct type is stored exactly once, as a <code>TypeKey</code> referring to its nested
+     * types by id, so comparing interned types is an integer comparison. Like interned strings,
+     * interned types live until the process exits.
+     */
+    namespace type_interner
+    {
+        /// Returns the interned type with the given structure, storing it if it hasn't been interned before.
+        /// The reference stays valid for the lifetime of the process.
+        const InternedType& intern(const TypeKey& key);
+
+        /// Returns the structure of a type obtained from <code>intern</code>.
+        const TypeKey& resolve(TypeId id);
+
+        /// The number of distinct types interned so far, including shapes.
+        size_t size();
+    } // namespace type_interner
+} // namespace stride::ast
@@ -2,9 +2,11 @@
 
 #include "ast_node.h"
 #include "formatting.h"
+#include "type_interner.h"
 #include "ast/flags.h"
 #include "ast/generics.h"
 
+#include <atomic>
 #include <format>
 #include <memory>
 #include <optional>
@@ -58,20 +60,30 @@ namespace stride::ast
     {
         int _flags;
 
+        /// Interned identity of this type, computed on first use and shared with clones
+        std::atomic<const InternedType*> _interned_type = nullptr;
+
     public:
         explicit IAstType(
+            const AstNodeKind kind,
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             const int flags
         ) :
-            IAstNode(source, context),
+            IAstNode(kind, source, context),
             _flags(flags) {}
 
         ~IAstType() override = default;
 
+        /// Kinds of the concrete subclasses
+        static constexpr AstNodeKind FIRST_KIND = AstNodeKind::PRIMITIVE_TYPE;
+        static constexpr AstNodeKind LAST_KIND = AstNodeKind::TUPLE_TYPE;
+
         std::unique_ptr<IAstType> clone_ty()
         {
-            return this->clone_as<IAstType>();
+            auto clone = this->clone_as<IAstType>();
+            clone->_interned_type.store(this->_interned_type.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return clone;
         }
 
         [[nodiscard]]
@@ -125,6 +137,31 @@ namespace stride::ast
         void set_flags(const int flags)
         {
             this->_flags = flags;
+            this->_interned_type.store(nullptr, std::memory_order_relaxed);
+        }
+
+        /// The interned identity of this type. Types with the same id are identical, including their flags.
+        /// The type is interned on first use.
+        [[nodiscard]]
+        const InternedType& get_interned_type();
+
+        /// Interns this type up front, for types that are compared often, like those of definitions.
+        /// Comparing two interned types usually only compares their shapes.
+        void intern()
+        {
+            static_cast<void>(this->get_interned_type());
+        }
+
+        [[nodiscard]]
+        bool is_interned() const
+        {
+            return this->_interned_type.load(std::memory_order_relaxed) != nullptr;
+        }
+
+        [[nodiscard]]
+        TypeId get_type_id()
+        {
+            return this->get_interned_type().id;
         }
 
         [[nodiscard]]
@@ -136,8 +173,10 @@ namespace stride::ast
         [[nodiscard]]
         virtual std::string get_type_name() = 0;
 
+        /// Whether both types are the same, ignoring their flags. If both types are interned and of the
+        /// same shape, they are equal. Anything else is decided by <code>equals_impl</code>.
         [[nodiscard]]
-        virtual bool equals(IAstType* other) = 0;
+        bool equals(IAstType* other);
 
         /// Checks whether other type is assignable to this one.
         /// Lower bit-count primitives are assignable to higher ones, e.g.,
@@ -160,6 +199,11 @@ namespace stride::ast
         llvm::Type* get_llvm_type(llvm::Module* module);
 
     private:
+        virtual bool equals_impl(IAstType* other) = 0;
+
+        /// Structure of this type for the type interner, with nested types referred to by their ids.
+        virtual TypeKey get_type_key() = 0;
+
         virtual bool is_assignable_to_impl(IAstType* other)
         {
             return false;
@@ -180,13 +224,15 @@ namespace stride::ast
         PrimitiveType _type;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::PRIMITIVE_TYPE;
+
         explicit AstPrimitiveType(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             const PrimitiveType type,
             const int flags = SRFLAG_NONE
         ) :
-            IAstType(source, context, flags),
+            IAstType(KIND, source, context, flags),
             _type(type) {}
 
         ~AstPrimitiveType() override = default;
@@ -225,9 +271,6 @@ namespace stride::ast
             return this->get_type_name();
         }
 
-        [[nodiscard]]
-        bool equals(IAstType* other) override;
-
         [[nodiscard]]
         bool is_primitive() const override
         {
@@ -246,6 +289,10 @@ namespace stride::ast
         }
 
     private:
+        bool equals_impl(IAstType* other) override;
+
+        TypeKey get_type_key() override;
+
         bool is_assignable_to_impl(IAstType* other) override;
 
         bool is_castable_to_impl(IAstType* other) override;
@@ -260,9 +307,18 @@ namespace stride::ast
         std::string _name;
         GenericTypeList _generic_types;
 
-        std::unique_ptr<IAstType> _underlying_type = nullptr;
+        /// Either owned by this alias, or the canonical instantiation of a generic type, owned by its definition.
+        /// Aliases in the types of definitions are resolved by every file using them, possibly at the same time,
+        /// so the first resolution to be published wins.
+        std::atomic<IAstType*> _underlying_type = nullptr;
+        std::unique_ptr<IAstType> _owned_underlying_type = nullptr;
+
+        /// The analysis generation in which the instantiation of a generic type was looked up, after which it may be gone
+        std::atomic<uint64_t> _instantiation_generation = 0;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::ALIAS_TYPE;
+
         explicit AstAliasType(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -270,7 +326,7 @@ namespace stride::ast
             const int flags = SRFLAG_NONE,
             GenericTypeList generic_parameters = EMPTY_GENERIC_TYPE_LIST
         ) :
-            IAstType(source, context, flags),
+            IAstType(KIND, source, context, flags),
             _name(std::move(name)),
             _generic_types(std::move(generic_parameters)) {}
 
@@ -287,9 +343,6 @@ namespace stride::ast
 
         std::string to_string() override;
 
-        [[nodiscard]]
-        bool equals(IAstType* other) override;
-
         bool is_castable_to(IAstType* other) override
         {
             return IAstType::is_castable_to(other);
@@ -322,7 +375,19 @@ namespace stride::ast
         [[nodiscard]]
         std::optional<definition::TypeDefinition*> get_type_definition() const;
 
+        /// Follows the aliases <code>base_type</code> resolves to, including the types nested in it,
+        /// until it is no longer an alias. <code>name</code> and <code>source</code> are used for errors.
+        static std::unique_ptr<IAstType> resolve_underlying_type(
+            std::unique_ptr<IAstType> base_type,
+            const std::string& name,
+            const SourceFragment& source
+        );
+
     private:
+        bool equals_impl(IAstType* other) override;
+
+        TypeKey get_type_key() override;
+
         bool is_assignable_to_impl(IAstType* other) override;
 
         bool is_castable_to_impl(IAstType* other) override;
@@ -337,6 +402,8 @@ namespace stride::ast
         std::unique_ptr<IAstType> _return_type;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::FUNCTION_TYPE;
+
         explicit AstFunctionType(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -344,7 +411,7 @@ namespace stride::ast
             std::unique_ptr<IAstType> return_type,
             const int flags = SRFLAG_NONE
         ) :
-            IAstType(source, context, flags | SRFLAG_TYPE_FUNCTION | SRFLAG_TYPE_PTR),
+            IAstType(KIND, source, context, flags | SRFLAG_TYPE_FUNCTION | SRFLAG_TYPE_PTR),
             _parameters(std::move(parameters)),
             _return_type(std::move(return_type)) {}
 
@@ -370,15 +437,16 @@ namespace stride::ast
             return get_type_name();
         }
 
-        [[nodiscard]]
-        bool equals(IAstType* other) override;
-
         bool is_castable_to(IAstType* other) override
         {
             return IAstType::is_castable_to(other);
         }
 
     private:
+        bool equals_impl(IAstType* other) override;
+
+        TypeKey get_type_key() override;
+
         bool is_assignable_to_impl(IAstType* other) override
         {
             return false;
@@ -396,6 +464,8 @@ namespace stride::ast
         size_t _initial_length;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::ARRAY_TYPE;
+
         explicit AstArrayType(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -403,7 +473,7 @@ namespace stride::ast
             const size_t initial_length,
             const int flags = SRFLAG_NONE
         ) :
-            IAstType(
+            IAstType(KIND,
                 source,
                 context,
                 (element_type ? element_type->get_flags() : 0)
@@ -437,15 +507,16 @@ namespace stride::ast
             return std::format("[{}]", this->_element_type->get_type_name());
         }
 
-        [[nodiscard]]
-        bool equals(IAstType* other) override;
-
         bool is_castable_to(IAstType* other) override
         {
             return IAstType::is_castable_to(other);
         }
 
     private:
+        bool equals_impl(IAstType* other) override;
+
+        TypeKey get_type_key() override;
+
         bool is_assignable_to_impl(IAstType* other) override;
 
         bool is_castable_to_impl(IAstType* other) override;
@@ -462,6 +533,8 @@ namespace stride::ast
         std::string _type_name;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::OBJECT_TYPE;
+
         explicit AstObjectType(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
@@ -470,7 +543,7 @@ namespace stride::ast
             const int flags = SRFLAG_NONE,
             GenericTypeList instantiated_generics = {}
         ) :
-            IAstType(source, context, flags),
+            IAstType(KIND, source, context, flags),
             _members(std::move(members)),
             _instantiated_generics(std::move(instantiated_generics)),
             _type_name(std::move(type_name)) {}
@@ -479,6 +552,13 @@ namespace stride::ast
 
         [[nodiscard]] ObjectTypeMemberList get_members() const;
 
+        /// Returns a non-owning const reference to the member list, avoiding the
+        /// clone overhead of get_members() when only read access is needed.
+        [[nodiscard]] const ObjectTypeMemberList& get_members_ref() const
+        {
+            return this->_members;
+        }
+
         [[nodiscard]] std::optional<IAstType*> get_member_field_type(const std::string& field_name) const;
 
         [[nodiscard]] std::optional<int> get_member_field_index(const std::string& field_name) const;
@@ -492,9 +572,6 @@ namespace stride::ast
 
         std::string to_string() override;
 
-        [[nodiscard]]
-        bool equals(IAstType* other) override;
-
 
         [[nodiscard]]
         std::unique_ptr<IAstNode> clone() override;
@@ -503,6 +580,10 @@ namespace stride::ast
         std::string get_internalized_name();
 
     private:
+        bool equals_impl(IAstType* other) override;
+
+        TypeKey get_type_key() override;
+
         llvm::Type* get_llvm_type_impl(llvm::Module* module) override;
     };
 
@@ -512,13 +593,15 @@ namespace stride::ast
         std::vector<std::unique_ptr<IAstType>> _members;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::TUPLE_TYPE;
+
         explicit AstTupleType(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::vector<std::unique_ptr<IAstType>> members,
             const int flags = SRFLAG_NONE
         ) :
-            IAstType(source, context, flags),
+            IAstType(KIND, source, context, flags),
             _members(std::move(members)) {}
 
         [[nodiscard]]
@@ -537,9 +620,6 @@ namespace stride::ast
 
         std::string to_string() override;
 
-        [[nodiscard]]
-        bool equals(IAstType* other) override;
-
         bool is_castable_to(IAstType* other) override
         {
             return IAstType::is_castable_to(other);
@@ -548,6 +628,10 @@ namespace stride::ast
         llvm::Value* codegen(llvm::Module* module, llvm::IRBuilderBase* builder) override;
 
     private:
+        bool equals_impl(IAstType* other) override;
+
+        TypeKey get_type_key() override;
+
         bool is_assignable_to_impl(IAstType* other) override
         {
             return false;
@@ -18,13 +18,15 @@ namespace stride::ast
         std::unique_ptr<IAstExpression> _condition;
 
     public:
+        static constexpr AstNodeKind KIND = AstNodeKind::WHILE_LOOP;
+
         explicit AstWhileLoop(
             const SourceFragment& source,
             const std::shared_ptr<ParsingContext>& context,
             std::unique_ptr<IAstExpression> condition,
             std::unique_ptr<AstBlock> body
         ) :
-            IAstNode(source, context),
+            IAstNode(KIND, source, context),
             _body(std::move(body)),
             _condition(std::move(condition)) {}
 
@@ -2,10 +2,14 @@
 
 #include "modifiers.h"
 #include "symbols.h"
+#include "ast/arena.h"
 #include "ast/nodes/types.h"
 
 #include <memory>
+#include <optional>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <llvm/IR/Function.h>
@@ -56,13 +60,19 @@ namespace stride::ast
             virtual ~IDefinition() = default;
 
             [[nodiscard]]
-            std::string get_internal_symbol_name() const
+            const std::string& get_internal_symbol_name() const
             {
                 return this->_symbol.internal_name;
             }
 
             [[nodiscard]]
-            Symbol get_symbol() const
+            InternedString get_internal_symbol() const
+            {
+                return this->_symbol.internal_name;
+            }
+
+            [[nodiscard]]
+            const Symbol& get_symbol() const
             {
                 return this->_symbol;
             }
@@ -108,6 +118,9 @@ namespace stride::ast
             std::unique_ptr<IAstType> _type;
             GenericParameterList _generics;
 
+            /// Instantiations of this type, if it is generic
+            mutable GenericInstantiationCache _instantiations;
+
         public:
             explicit TypeDefinition(
                 Symbol type_name_symbol,
@@ -117,7 +130,13 @@ namespace stride::ast
             ) :
                 IDefinition(std::move(type_name_symbol), visibility),
                 _type(std::move(type)),
-                _generics(std::move(generics)) {}
+                _generics(std::move(generics))
+            {
+                if (this->_type != nullptr)
+                {
+                    this->_type->intern();
+                }
+            }
 
             [[nodiscard]]
             IAstType* get_type() const
@@ -137,6 +156,12 @@ namespace stride::ast
                 return !this->_generics.empty();
             }
 
+            [[nodiscard]]
+            GenericInstantiationCache& get_instantiations() const
+            {
+                return this->_instantiations;
+            }
+
             [[nodiscard]]
             std::unique_ptr<IDefinition> clone() const override
             {
@@ -160,7 +185,14 @@ namespace stride::ast
                 const VisibilityModifier visibility
             ) :
                 IDefinition(symbol, visibility),
-                _type(std::move(type)) {}
+                _type(std::move(type))
+            {
+                // Field types are compared whenever the field is used
+                if (this->_type != nullptr)
+                {
+                    this->_type->intern();
+                }
+            }
 
             [[nodiscard]]
             IAstType* get_type() const
@@ -169,7 +201,7 @@ namespace stride::ast
             }
 
             [[nodiscard]]
-            std::string get_field_name() const
+            const std::string& get_field_name() const
             {
                 return this->get_symbol().name;
             }
@@ -181,6 +213,15 @@ namespace stride::ast
             }
         };
 
+        /**
+         * Hash of a list of parameter types. Lists that are equal according to
+         * <code>FunctionDefinition::matches_parameter_signature</code> have the same hash.
+         *
+         * Aliases, object types and <code>nil</code> can equal types of another shape, so lists
+         * containing them have no hash and must be compared structurally.
+         */
+        std::optional<size_t> hash_parameter_types(const std::vector<std::unique_ptr<IAstType>>& parameter_types);
+
         class FunctionDefinition
             : public IDefinition
         {
@@ -188,6 +229,10 @@ namespace stride::ast
             int _flags;
             llvm::Function* _llvm_function = nullptr;
 
+            /// Hash of the parameter types, if calls can be matched by it, see <code>hash_parameter_types</code>.
+            /// Variadic functions also accept longer argument lists, so these have none.
+            std::optional<size_t> _parameter_hash;
+
         public:
             explicit FunctionDefinition(
                 std::unique_ptr<AstFunctionType> function_type,
@@ -197,7 +242,14 @@ namespace stride::ast
             ) :
                 IDefinition(symbol, visibility),
                 _function_type(std::move(function_type)),
-                _flags(flags) {}
+                _flags(flags),
+                _parameter_hash(
+                    (flags & SRFLAG_FN_TYPE_VARIADIC) != 0
+                    ? std::nullopt
+                    : hash_parameter_types(this->_function_type->get_parameter_types()))
+            {
+                this->_function_type->intern();
+            }
 
             [[nodiscard]]
             AstFunctionType* get_type() const
@@ -206,7 +258,7 @@ namespace stride::ast
             }
 
             [[nodiscard]]
-            std::string get_function_name() const
+            const std::string& get_function_name() const
             {
                 return this->get_symbol().name;
             }
@@ -223,9 +275,15 @@ namespace stride::ast
                 return (this->_flags & SRFLAG_FN_TYPE_VARIADIC) != 0;
             }
 
+            [[nodiscard]]
+            std::optional<size_t> get_parameter_hash() const
+            {
+                return this->_parameter_hash;
+            }
+
             ~FunctionDefinition() override = default;
 
-            bool matches_type_signature(const std::string& name, const AstFunctionType* signature) const;
+            bool matches_type_signature(InternedString name, const AstFunctionType* signature) const;
 
             void set_llvm_function(llvm::Function* function)
             {
@@ -240,7 +298,7 @@ namespace stride::ast
 
             [[nodiscard]]
             bool matches_parameter_signature(
-                const std::string& internal_function_name,
+                InternedString internal_function_name,
                 const std::vector<std::unique_ptr<IAstType>>& other_parameter_types
             ) const;
 
@@ -267,9 +325,59 @@ namespace stride::ast
 
         std::vector<std::unique_ptr<definition::IDefinition>> _symbols;
 
+        /// All functions defined with the same internal name.
+        struct OverloadSet
+        {
+            /// Positions of overloads that have a parameter hash, by that hash
+            std::unordered_multimap<size_t, size_t> by_parameter_hash;
+
+            /// Positions of overloads without a parameter hash, in definition order
+            std::vector<size_t> unhashed;
+
+            /// Positions of all overloads, in definition order
+            std::vector<size_t> all;
+        };
+
+        /// Positions in <code>_symbols</code> of the definitions made in this context, by name, so
+        /// that lookups don't have to scan all of them. Each map holds the first definition of its
+        /// kind with a given name, which is what a scan in definition order would find, except for
+        /// <code>functions</code>, which holds the overload set of every internal name.
+        struct DefinitionIndex
+        {
+            std::unordered_map<InternedString, size_t> by_internal_name;
+            std::unordered_map<InternedString, size_t> by_name;
+            std::unordered_map<InternedString, size_t> fields;
+            std::unordered_map<InternedString, size_t> fields_by_name;
+            std::unordered_map<InternedString, size_t> types;
+            std::unordered_map<InternedString, size_t> identifiable_symbols;
+            std::unordered_map<InternedString, OverloadSet> functions;
+        };
+
+        DefinitionIndex _index;
+
+        /// Number of leading definitions in <code>_symbols</code> that were made while parsing, see <code>mark_parsed</code>.
+        size_t _parsed_symbol_count = 0;
+
+        /// All contexts below a root context are linked into a list starting at the root, so that
+        /// definitions can be reset for a whole file. The contexts of a file are all created by the
+        /// thread parsing it.
+        ParsingContext* _previous_scope = nullptr;
+        ParsingContext* _next_scope = nullptr;
+
+        /**
+         * Guards the definitions of a root context while files are analyzed concurrently.
+         * Every context of a file is only written by the thread analyzing that file, and only the root
+         * context is read by other files: types cloned into an importing file still resolve their names
+         * through the contexts of the file defining them. Hence, additions to a root context take this
+         * exclusively, and type lookups that reach a root context take it shared. Lookups made by the
+         * owning thread need no lock, as no other thread writes to its contexts.
+         */
+        mutable std::shared_mutex _root_mutex;
+
         // Stack of loop blocks for break and continue: pair<continue_block, break_block>
         // This isn't used during parsing, hence it not needing to be moved when creating a new ParsingContext.
-        static inline
+        // Files are lowered on threads of their own, so each thread keeps a stack of its own.
+        static inline thread_local
         std::vector<std::pair<llvm::BasicBlock*, llvm::BasicBlock*>> control_flow_loop_blocks;
 
     public:
@@ -279,7 +387,13 @@ namespace stride::ast
             std::shared_ptr<ParsingContext> parent) :
             _context_name(std::move(context_name)),
             _context_type(type),
-            _parent_registry(std::move(parent)) {}
+            _parent_registry(std::move(parent))
+        {
+            if (this->_parent_registry)
+            {
+                this->link_scope();
+            }
+        }
 
         /// Non-specific scope context definitions, e.g., for/while-loop blocks
         explicit ParsingContext(
@@ -293,6 +407,10 @@ namespace stride::ast
         explicit ParsingContext() :
             ParsingContext("", ContextType::GLOBAL, nullptr) {}
 
+        ~ParsingContext();
+
+        ParsingContext(const ParsingContext&) = delete;
+
         ParsingContext& operator=(const ParsingContext&) = delete;
 
         [[nodiscard]]
@@ -422,6 +540,39 @@ namespace stride::ast
 
         void define(std::unique_ptr<definition::IDefinition> definition);
 
+        /// Records every definition made so far in this file, i.e. in the root of this context and all
+        /// contexts below it, as a result of parsing.
+        void mark_parsed();
+
+        /// Removes every definition made in this file since <code>mark_parsed</code>. This undoes the
+        /// definitions made by semantic analysis, so that a tree can be analyzed again after parts of
+        /// it have been reparsed. Generic instantiations are made anew as well, see <code>get_analysis_generation</code>.
+        void discard_analysis();
+
+        [[nodiscard]]
+        size_t get_symbol_count() const
+        {
+            return this->_symbols.size();
+        }
+
+        /// All definitions made in this context, in the order they were made.
+        [[nodiscard]]
+        const std::vector<std::unique_ptr<definition::IDefinition>>& get_definitions() const
+        {
+            return this->_symbols;
+        }
+
+        /// Removes all definitions from this context, and returns them in the order they were made.
+        std::vector<std::unique_ptr<definition::IDefinition>> take_symbols();
+
+        /// Re-adds definitions taken out with <code>take_symbols</code>. If <code>check_duplicates</code> is set,
+        /// type definitions are rejected if the type is already defined, like <code>define_type</code> does.
+        /// The definitions are only moved out of <code>definitions</code> once all of them were accepted.
+        void restore_symbols(
+            std::vector<std::unique_ptr<definition::IDefinition>>&& definitions,
+            bool check_duplicates
+        );
+
         /// Checks whether the provided variable name is defined in the current context.
         [[nodiscard]]
         bool is_field_defined_in_scope(const std::string& variable_name) const;
@@ -448,7 +599,104 @@ namespace stride::ast
     private:
         [[nodiscard]]
         const ParsingContext& traverse_to_root() const;
+
+        void link_scope();
+
+        /// Appends <code>definition</code> to <code>_symbols</code> and indexes it.
+        void add_definition(std::unique_ptr<definition::IDefinition> definition);
+
+        void index_definition(size_t position);
+
+        /// Indexes <code>_symbols</code> from scratch, after definitions were removed.
+        void rebuild_index();
+
+        /**
+         * First function defined in this context with the internal name <code>name</code>, for which
+         * <code>matches</code> holds. For larger overload sets, if <code>parameter_types</code> have a hash,
+         * only overloads with that hash and overloads without a hash are considered.
+         */
+        template <typename Predicate>
+        definition::FunctionDefinition* find_function(
+            const InternedString name,
+            const std::vector<std::unique_ptr<IAstType>>& parameter_types,
+            Predicate matches
+        ) const
+        {
+            // Below this, comparing all overloads is cheaper than hashing the parameter types
+            static constexpr size_t min_hashed_overload_count = 8;
+
+            const auto overloads = this->_index.functions.find(name);
+            if (overloads == this->_index.functions.end())
+            {
+                return nullptr;
+            }
+
+            const auto parameter_hash = overloads->second.all.size() < min_hashed_overload_count
+                ? std::nullopt
+                : definition::hash_parameter_types(parameter_types);
+
+            const auto matches_at = [&](const size_t position)
+            {
+                return matches(static_cast<definition::FunctionDefinition*>(this->_symbols[position].get()));
+            };
+
+            std::optional<size_t> first_match = std::nullopt;
+            if (!parameter_hash.has_value())
+            {
+                for (const auto position : overloads->second.all)
+                {
+                    if (matches_at(position))
+                    {
+                        first_match = position;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                // Equal hashes are verified, in case of collisions
+                const auto [begin, end] = overloads->second.by_parameter_hash.equal_range(parameter_hash.value());
+                for (auto candidate = begin; candidate != end; ++candidate)
+                {
+                    if ((!first_match.has_value() || candidate->second < first_match.value())
+                        && matches_at(candidate->second))
+                    {
+                        first_match = candidate->second;
+                    }
+                }
+
+                for (const auto position : overloads->second.unhashed)
+                {
+                    if (first_match.has_value() && position > first_match.value())
+                    {
+                        break;
+                    }
+                    if (matches_at(position))
+                    {
+                        first_match = position;
+                        break;
+                    }
+                }
+            }
+
+            if (!first_match.has_value())
+            {
+                return nullptr;
+            }
+
+            return static_cast<definition::FunctionDefinition*>(this->_symbols[first_match.value()].get());
+        }
+
+        /// Throws if <code>type_name</code> is already defined in the root context.
+        void ensure_type_undefined(const Symbol& type_name) const;
     };
 
     std::string scope_type_to_str(const ContextType& scope_type);
+
+    /// Creates a context in the arena of the current compilation, if one is installed.
+    template <typename... Args>
+    std::shared_ptr<ParsingContext> make_context(Args&&... args)
+    {
+        return std::allocate_shared<ParsingContext>(AstAllocator<ParsingContext>(), std::forward<Args>(args)...);
+    }
 } // namespace stride::ast
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "files.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace stride::ast
+{
+    class AstBlock;
+
+    /// Version of the binary AST format. Entries written with another version are ignored.
+    static constexpr uint32_t AST_FORMAT_VERSION = 2;
+
+    /// Hash of the contents of a source file, used as the key of its cache entry.
+    uint64_t hash_source(std::string_view source);
+
+    /**
+     * @brief Writes a parsed file in a compact binary form.
+     *
+     * Besides the nodes, this stores the contexts of the file together with the definitions that
+     * were made in them while parsing, like type definitions and enum symbols. It must therefore
+     * be called before the file is analyzed. Source positions are stored as offsets into the source
+     * file of <code>root</code>.
+     *
+     * Returns nothing if the tree contains nodes that can't be written.
+     */
+    std::optional<std::string> serialize_ast(AstBlock* root);
+
+    /**
+     * @brief Rebuilds a file written with <code>serialize_ast</code>.
+     *
+     * The nodes refer to <code>source</code>, which must hold the contents the tree was parsed from.
+     * Local variables and anonymous functions get fresh unique names, just like they would if the
+     * file was parsed again.
+     *
+     * Returns nullptr if <code>data</code> is malformed, or wasn't written for <code>source</code>.
+     */
+    std::unique_ptr<AstBlock> deserialize_ast(std::string_view data, const std::shared_ptr<SourceFile>& source);
+
+    /**
+     * @brief On-disk cache of parsed files, keyed by the hash of their contents.
+     *
+     * Files whose contents didn't change since they were stored are loaded from their entry,
+     * instead of being tokenized and parsed again. Entries are memory-mapped and read in place.
+     *
+     * The cache is best-effort: entries that can't be read or written are ignored, in which case
+     * the file is simply parsed. Semantic analysis always runs, as its outcome depends on the
+     * other files of the program.
+     *
+     * Files parsed with <code>lazy_function_bodies</code> keep the tokens of their deferred bodies,
+     * and are stored apart from files parsed eagerly, whose entries hold every body.
+     */
+    class AstCache
+    {
+        std::filesystem::path _directory;
+
+    public:
+        /// Uses <code>directory</code> for the entries, creating it if needed.
+        explicit AstCache(std::filesystem::path directory);
+
+        /// Loads the tree of <code>source</code>, or returns nullptr if it isn't cached.
+        [[nodiscard]]
+        std::unique_ptr<AstBlock> load(
+            const std::shared_ptr<SourceFile>& source,
+            bool lazy_function_bodies = false
+        ) const;
+
+        /// Stores the freshly parsed tree of <code>source</code>.
+        void store(const SourceFile& source, AstBlock* root, bool lazy_function_bodies = false) const;
+
+        [[nodiscard]]
+        std::filesystem::path get_entry_path(uint64_t source_hash, bool lazy_function_bodies = false) const;
+
+        [[nodiscard]]
+        const std::filesystem::path& get_directory() const
+        {
+            return this->_directory;
+        }
+    };
+} // namespace stride::ast
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "interner.h"
 #include "nodes/types.h"
 
 #include <string>
@@ -13,21 +14,21 @@ namespace stride::ast
     struct Symbol
     {
         /// Human-readable name of this symbol
-        std::string name;
+        InternedString name;
 
         /// Internalized name of this symbol.
         /// Can be the same as `name`, if there's no need for internalization.
-        std::string internal_name;
+        InternedString internal_name;
 
         SourceFragment symbol_position;
 
         explicit Symbol(
             const SourceFragment& position,
             const std::string& context_name,
-            std::string name,
+            const std::string& name,
             const std::string& internal_name
         ) :
-            name(std::move(name)),
+            name(name),
             internal_name(
                 context_name.empty()
                 ? internal_name
@@ -67,4 +68,9 @@ namespace stride::ast
         const SymbolNameSegments& segments);
 
     std::string resolve_internal_name(const SymbolNameSegments& segments);
+
+    /// Returns a number that is unique within this process, for symbols whose internal name must
+    /// not clash with any other, such as local variables and anonymous functions.
+    /// Safe to call while files are parsed in parallel.
+    size_t next_unique_symbol_id();
 } // namespace stride::ast
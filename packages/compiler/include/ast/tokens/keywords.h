@@ -0,0 +1,137 @@
+#pragma once
+
+#include "token.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace stride::ast::keywords
+{
+    struct KeywordEntry
+    {
+        std::string_view lexeme;
+        TokenType type;
+    };
+
+    /// Every reserved word of the language, including primitive type names and boolean literals.
+    /// Keep this in sync with the keyword patterns in `tokenTypes` (token_types.cpp).
+    inline constexpr std::array<KeywordEntry, 51> KEYWORDS = { {
+        { "const", TokenType::KEYWORD_CONST },
+        { "let", TokenType::KEYWORD_LET },
+        { "use", TokenType::KEYWORD_USE },
+        { "package", TokenType::KEYWORD_PACKAGE },
+        { "fn", TokenType::KEYWORD_FN },
+        { "if", TokenType::KEYWORD_IF },
+        { "else", TokenType::KEYWORD_ELSE },
+        { "while", TokenType::KEYWORD_WHILE },
+        { "for", TokenType::KEYWORD_FOR },
+        { "return", TokenType::KEYWORD_RETURN },
+        { "break", TokenType::KEYWORD_BREAK },
+        { "continue", TokenType::KEYWORD_CONTINUE },
+        { "struct", TokenType::KEYWORD_STRUCT },
+        { "enum", TokenType::KEYWORD_ENUM },
+        { "case", TokenType::KEYWORD_CASE },
+        { "default", TokenType::KEYWORD_DEFAULT },
+        { "import", TokenType::KEYWORD_IMPORT },
+        { "nil", TokenType::KEYWORD_NIL },
+        { "class", TokenType::KEYWORD_CLASS },
+        { "this", TokenType::KEYWORD_THIS },
+        { "pub", TokenType::KEYWORD_PUBLIC },
+        { "private", TokenType::KEYWORD_PRIVATE },
+        { "module", TokenType::KEYWORD_MODULE },
+        { "extern", TokenType::KEYWORD_EXTERN },
+        { "type", TokenType::KEYWORD_TYPE },
+        { "override", TokenType::KEYWORD_OVERRIDE },
+        { "as", TokenType::KEYWORD_AS },
+        { "async", TokenType::KEYWORD_ASYNC },
+        { "do", TokenType::KEYWORD_DO },
+        { "switch", TokenType::KEYWORD_SWITCH },
+        { "try", TokenType::KEYWORD_TRY },
+        { "catch", TokenType::KEYWORD_CATCH },
+        { "throw", TokenType::KEYWORD_THROW },
+        { "new", TokenType::KEYWORD_NEW },
+        { "bool", TokenType::PRIMITIVE_BOOL },
+        { "i8", TokenType::PRIMITIVE_INT8 },
+        { "i16", TokenType::PRIMITIVE_INT16 },
+        { "i32", TokenType::PRIMITIVE_INT32 },
+        { "i64", TokenType::PRIMITIVE_INT64 },
+        { "u8", TokenType::PRIMITIVE_UINT8 },
+        { "u16", TokenType::PRIMITIVE_UINT16 },
+        { "u32", TokenType::PRIMITIVE_UINT32 },
+        { "u64", TokenType::PRIMITIVE_UINT64 },
+        { "f32", TokenType::PRIMITIVE_FLOAT32 },
+        { "f64", TokenType::PRIMITIVE_FLOAT64 },
+        { "char", TokenType::PRIMITIVE_CHAR },
+        { "string", TokenType::PRIMITIVE_STRING },
+        { "void", TokenType::PRIMITIVE_VOID },
+        { "auto", TokenType::PRIMITIVE_AUTO },
+        { "true", TokenType::BOOLEAN_LITERAL },
+        { "false", TokenType::BOOLEAN_LITERAL },
+    } };
+
+    inline constexpr size_t MIN_KEYWORD_LENGTH = 2;
+    inline constexpr size_t MAX_KEYWORD_LENGTH = 8;
+
+    /// Size of the hash table, must be a power of two.
+    inline constexpr size_t TABLE_SIZE = 128;
+
+    /// Seed for which `hash` maps every entry of `KEYWORDS` to a distinct slot.
+    /// If the keyword list changes, the static_assert below will fail and a new seed has to be picked.
+    inline constexpr uint32_t HASH_SEED = 45592;
+
+    constexpr uint32_t hash(const std::string_view word)
+    {
+        uint32_t hash = HASH_SEED;
+        for (const char c : word)
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x01000193u;
+        }
+        hash ^= hash >> 15;
+        return hash & (TABLE_SIZE - 1);
+    }
+
+    /// Slot table mapping a hash to an index in `KEYWORDS` (or -1 for empty slots).
+    inline constexpr auto SLOTS = []
+    {
+        std::array<int8_t, TABLE_SIZE> slots{};
+        slots.fill(-1);
+
+        for (size_t i = 0; i < KEYWORDS.size(); ++i)
+        {
+            slots[hash(KEYWORDS[i].lexeme)] = static_cast<int8_t>(i);
+        }
+        return slots;
+    }();
+
+    static_assert(
+        []
+        {
+            size_t occupied = 0;
+            for (const auto slot : SLOTS)
+            {
+                occupied += slot >= 0 ? 1 : 0;
+            }
+            return occupied == KEYWORDS.size();
+        }(),
+        "Keyword hash is not perfect, pick a different HASH_SEED");
+
+    /// Resolves a word (a run of `[a-zA-Z0-9_]`) to its keyword token type, if it is one.
+    /// Requires a single hash and at most one string comparison.
+    constexpr std::optional<TokenType> lookup(const std::string_view word)
+    {
+        if (word.size() < MIN_KEYWORD_LENGTH || word.size() > MAX_KEYWORD_LENGTH)
+        {
+            return std::nullopt;
+        }
+
+        const auto slot = SLOTS[hash(word)];
+        if (slot < 0 || KEYWORDS[slot].lexeme != word)
+        {
+            return std::nullopt;
+        }
+
+        return KEYWORDS[slot].type;
+    }
+} // namespace stride::ast::keywords
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/*
+ * Bulk scanning primitives for the lexer.
+ *
+ * These cover the parts of a source file that aren't tokens themselves, or whose content
+ * doesn't need to be inspected character by character: whitespace runs, comments and the
+ * bodies of string literals. Each primitive has a scalar implementation and vectorized ones
+ * that process 16 (SSE2) or 32 (AVX2) bytes at a time. The best one the CPU supports is
+ * selected once at runtime; all of them must return exactly the same results.
+ */
+namespace stride::ast::scanner
+{
+    enum class ScannerIsa
+    {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    struct Scanner
+    {
+        ScannerIsa isa;
+
+        /// Returns the index of the first non-whitespace character at or after `index`,
+        /// or `src.size()` if there is none.
+        size_t (*skip_whitespace)(std::string_view src, size_t index);
+
+        /// Returns the index of the first `\n` at or after `index`, or `src.size()` if there is none.
+        size_t (*find_line_end)(std::string_view src, size_t index);
+
+        /// Returns the index of the first `*/` at or after `index`, or `std::string_view::npos`
+        /// if the comment is never closed.
+        size_t (*find_block_comment_end)(std::string_view src, size_t index);
+
+        /// Returns the index of the first `"` at or after `index` that isn't escaped by a
+        /// backslash, or a value `>= src.size()` if the string is never closed.
+        size_t (*find_string_end)(std::string_view src, size_t index);
+    };
+
+    /// Returns the scanner used by the lexer, which is the fastest one supported by this CPU
+    /// unless overridden through <code>force_isa</code>.
+    const Scanner& get_scanner();
+
+    /// Returns the scanner for the given instruction set. The instruction set must be supported.
+    const Scanner& get_scanner(ScannerIsa isa);
+
+    /// All instruction sets the current CPU can run, starting with <code>SCALAR</code>.
+    std::vector<ScannerIsa> supported_isas();
+
+    /// Overrides the scanner returned by <code>get_scanner()</code>. Meant for differential testing.
+    void force_isa(ScannerIsa isa);
+} // namespace stride::ast::scanner
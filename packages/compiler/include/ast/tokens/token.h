@@ -1,15 +1,20 @@
 #pragma once
 
 #include "files.h"
+#include "ast/flags.h"
 
+#include <array>
+#include <cstdint>
 #include <regex>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
 #define TOKEN(type, pattern) { TokenDefinition(type, std::regex(pattern)) }
 
 namespace stride::ast
 {
-    enum class TokenType
+    enum class TokenType : uint8_t
     {
         COMMENT,           // //
         COMMENT_MULTILINE, // /* */
@@ -400,9 +405,53 @@ namespace stride::ast
         }
     }
 
-    extern std::vector<TokenType> operatorPrecedence;
+    /// Binding power of an infix operator. Operators with a precedence of 0 aren't infix operators.
+    struct OperatorPrecedence
+    {
+        uint8_t precedence = 0;
+        bool right_associative = false;
+    };
+
+    /// Infix operator precedences, from lowest to highest, indexed by <code>TokenType</code>.
+    /// The cast operator <code>as</code> binds tighter than all binary operators.
+    inline constexpr auto operatorPrecedence = []
+    {
+        std::array<OperatorPrecedence, 1 << 8 * sizeof(TokenType)> table{};
+        const auto set = [&table](const TokenType type, const uint8_t precedence)
+        {
+            table[std::to_underlying(type)] = { precedence, false };
+        };
 
-    bool precedes(TokenType lhs, TokenType rhs);
+        set(TokenType::DOUBLE_PIPE, 1);
+        set(TokenType::DOUBLE_AMPERSAND, 2);
+        set(TokenType::DOUBLE_EQUALS, 3);
+        set(TokenType::BANG_EQUALS, 3);
+        set(TokenType::LT, 4);
+        set(TokenType::LEQUALS, 4);
+        set(TokenType::GT, 4);
+        set(TokenType::GEQUALS, 4);
+        set(TokenType::PLUS, 5);
+        set(TokenType::MINUS, 5);
+        set(TokenType::STAR, 6);
+        set(TokenType::SLASH, 6);
+        set(TokenType::PERCENT, 6);
+        set(TokenType::KEYWORD_AS, 7);
+
+        return table;
+    }();
+
+    [[nodiscard]]
+    constexpr OperatorPrecedence get_operator_precedence(const TokenType type)
+    {
+        return operatorPrecedence[std::to_underlying(type)];
+    }
+
+    /// Whether the operator <code>lhs</code> binds tighter than <code>rhs</code>.
+    [[nodiscard]]
+    constexpr bool precedes(const TokenType lhs, const TokenType rhs)
+    {
+        return get_operator_precedence(lhs).precedence > get_operator_precedence(rhs).precedence;
+    }
 
     class TokenDefinition
     {
@@ -427,39 +476,100 @@ namespace stride::ast
         }
     };
 
+    /**
+     * Compact token representation. Tokens don't own their lexeme; it is a view into the
+     * source of the file they were lexed from, which is resolved through its registry id.
+     * Tokens of a destroyed <code>SourceFile</code> resolve to no file, and thus to an empty lexeme.
+     */
     class Token
     {
-        SourceFragment _position;
-        std::string _lexeme{};
+        uint32_t _offset;
+        uint32_t _length;
+        SourceFileId _file_id;
         TokenType _type;
+        uint8_t _flags;
 
     public:
         explicit Token(
             const TokenType type,
-            const SourceFragment& position,
-            std::string lexeme) :
-            _position(position),
-            _lexeme(std::move(lexeme)),
-            _type(type) {}
-
-        ~Token() = default;
+            const SourceFileId file_id,
+            const size_t offset,
+            const size_t length,
+            const uint8_t flags = 0) :
+            _offset(static_cast<uint32_t>(offset)),
+            _length(static_cast<uint32_t>(length)),
+            _file_id(file_id),
+            _type(type),
+            _flags(flags) {}
 
         [[nodiscard]]
-        const TokenType& get_type() const
+        TokenType get_type() const
         {
             return _type;
         }
 
+        /// Returns the text of this token. For string literals, this is the (unescaped) content
+        /// between the quotes.
+        /// Resolves the file through the registry; parsers holding the file use the overload taking it.
         [[nodiscard]]
-        const std::string& get_lexeme() const
+        std::string_view get_lexeme() const
         {
-            return _lexeme;
+            const auto* file = get_source_file(_file_id);
+            if (file == nullptr)
+            {
+                return {};
+            }
+
+            return this->get_lexeme(*file);
         }
 
+        /// Returns the text of this token, which has been lexed from <code>file</code>.
         [[nodiscard]]
-        const SourceFragment& get_source_fragment() const
+        std::string_view get_lexeme(const SourceFile& file) const
         {
-            return _position;
+            if (_type == TokenType::STRING_LITERAL)
+            {
+                if (_flags & SRFLAG_TOKEN_ESCAPED_LITERAL)
+                {
+                    return file.get_unescaped_literal(_offset);
+                }
+                return file.source.substr(_offset + 1, _length - 2);
+            }
+
+            return file.source.substr(_offset, _length);
+        }
+
+        /// The fragment of the file this token was lexed from. Its source is null if the file has been
+        /// destroyed, or isn't owned by a <code>std::shared_ptr</code>.
+        [[nodiscard]]
+        SourceFragment get_source_fragment() const
+        {
+            auto* file = get_source_file(_file_id);
+            auto source = file == nullptr ? nullptr : file->weak_from_this().lock();
+
+            return {
+                source,
+                source == nullptr ? static_cast<size_t>(-1) : _offset,
+                _length
+            };
+        }
+
+        [[nodiscard]]
+        size_t get_offset() const
+        {
+            return _offset;
+        }
+
+        [[nodiscard]]
+        size_t get_length() const
+        {
+            return _length;
+        }
+
+        [[nodiscard]]
+        uint8_t get_flags() const
+        {
+            return _flags;
         }
 
         bool operator==(const TokenType& other) const
@@ -468,10 +578,11 @@ namespace stride::ast
         }
     };
 
+    static_assert(sizeof(Token) == 16, "Tokens are expected to fit in 16 bytes");
+    static_assert(std::is_trivially_copyable_v<Token>);
+
     extern std::vector<TokenDefinition> tokenTypes;
 
-    static auto END_OF_FILE =
-        Token(TokenType::END_OF_FILE,
-              { nullptr, static_cast<size_t>(-1), 0 },
-              "");
+    static const auto END_OF_FILE =
+        Token(TokenType::END_OF_FILE, INVALID_SOURCE_FILE_ID, 0, 0);
 } // namespace stride::ast
@@ -3,6 +3,8 @@
 #include "ast/tokens/token.h"
 
 #include <algorithm>
+#include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -15,39 +17,66 @@ namespace stride
 namespace stride::ast
 {
 
+    /**
+     * @brief A cursor over a range of tokens.
+     *
+     * The tokens themselves live in a buffer that is shared between a set and every
+     * subset created from it, so creating a subset never copies or allocates tokens.
+     * Each set only carries its own <code>[begin, end)</code> range into that buffer
+     * and a cursor relative to <code>begin</code>.
+     */
     class TokenSet
     {
-        std::shared_ptr<SourceFile> _source;
+        struct TokenBuffer
+        {
+            std::shared_ptr<SourceFile> source;
+            std::vector<Token> tokens;
 
+            /// For every opening bracket, the absolute index of its closing bracket,
+            /// or -1 if it is never closed. Unused for all other tokens.
+            std::vector<int64_t> closing_brackets;
+        };
+
+        std::shared_ptr<const TokenBuffer> _buffer;
+
+        int64_t _begin;
+        int64_t _end;
         int64_t _cursor;
-        int64_t _size;
 
-        std::vector<Token> _tokens;
+        explicit TokenSet(std::shared_ptr<const TokenBuffer> buffer, int64_t begin, int64_t end);
 
     public:
         explicit TokenSet(
             std::shared_ptr<SourceFile> source,
             std::vector<Token>& tokens
-        ) :
-            _source(std::move(source)),
-            _cursor(0),
-            _size(static_cast<int64_t>(tokens.size())),
-            _tokens(std::move(tokens)) {}
+        );
 
         [[nodiscard]]
         TokenSet create_subset(int64_t offset, int64_t length) const;
 
+        /**
+         * @brief Finds the bracket that closes the opening bracket at the given index.
+         *
+         * Only brackets of the same kind are counted, i.e. <code>(</code> is closed by the first
+         * <code>)</code> at the same nesting level of parentheses.
+         *
+         * @return The index of the closing bracket relative to the start of this set, or -1 if
+         * the token at <code>index</code> isn't an opening bracket or isn't closed within this set.
+         */
+        [[nodiscard]]
+        int64_t find_closing_bracket(int64_t index) const;
+
         [[nodiscard]]
-        Token last() const;
+        const Token& last() const;
 
         [[nodiscard]]
-        Token at(int64_t index) const;
+        const Token& at(int64_t index) const;
 
         [[nodiscard]]
-        Token peek(int64_t offset) const;
+        const Token& peek(int64_t offset) const;
 
         [[nodiscard]]
-        Token peek_next() const;
+        const Token& peek_next() const;
 
         [[nodiscard]]
         TokenType peek_next_type() const;
@@ -60,11 +89,11 @@ namespace stride::ast
 
         void skip(int64_t amount);
 
-        Token expect(TokenType type);
+        const Token& expect(TokenType type);
 
-        Token expect(TokenType type, const std::string& message);
+        const Token& expect(TokenType type, const std::string& message);
 
-        Token next();
+        const Token& next();
 
         [[nodiscard]]
         int64_t size() const;
@@ -81,6 +110,17 @@ namespace stride::ast
         [[nodiscard]]
         std::shared_ptr<SourceFile> get_source() const;
 
+        /// The lexeme of a token of this set, read from the source of the set without a registry lookup.
+        [[nodiscard]]
+        std::string_view get_lexeme(const Token& token) const
+        {
+            return token.get_lexeme(*this->_buffer->source);
+        }
+
+        /// All tokens in this set, regardless of the cursor.
+        [[nodiscard]]
+        std::span<const Token> get_tokens() const;
+
         [[noreturn]]
         static void throw_error(const Token& token,
                          ErrorType error_type,
@@ -5,12 +5,53 @@
 
 namespace stride::ast::tokenizer
 {
+    /**
+     * @brief Selects the lexer implementation used by <code>tokenize</code>.
+     *
+     * - <code>STATE_MACHINE</code>: Single-pass, table-driven lexer. This is the default.
+     * - <code>REGEX</code>: The original lexer, trying every pattern in <code>tokenTypes</code>
+     *   at each position. Kept around for differential testing only.
+     */
+    enum class LexerBackend
+    {
+        STATE_MACHINE,
+        REGEX
+    };
+
     static bool isWhitespace(const char c)
     {
         return c == ' ' || c == '\t' || c == '\n' || c == '\r';
     }
 
-    TokenSet tokenize(const std::shared_ptr<SourceFile>& source_file);
+    TokenSet tokenize(
+        const std::shared_ptr<SourceFile>& source_file,
+        LexerBackend backend = LexerBackend::STATE_MACHINE);
+
+    /// Result of <code>retokenize</code>.
+    struct RetokenizedSet
+    {
+        TokenSet tokens;
+
+        /// Tokens <code>[damage_begin, damage_end)</code> were lexed again. Tokens before them are the
+        /// same as in the previous set, tokens after them correspond one to one with the previous
+        /// tokens from <code>previous_damage_end</code> on, moved by the length difference of the edit.
+        int64_t damage_begin;
+        int64_t damage_end;
+        int64_t previous_damage_end;
+    };
+
+    /**
+     * @brief Tokenizes an edited file by lexing only the region affected by the edit.
+     *
+     * @param previous The complete token set of the file before the edit.
+     * @param source_file The file after the edit, e.g. as returned by <code>apply_edit</code>.
+     * @param edit The edit that turned the previous revision into <code>source_file</code>.
+     * @return The same tokens <code>tokenize(source_file)</code> would produce.
+     */
+    RetokenizedSet retokenize(
+        const TokenSet& previous,
+        const std::shared_ptr<SourceFile>& source_file,
+        const SourceEdit& edit);
 
     std::string escape_string(const std::string& raw_string);
 } // namespace stride::ast::tokenizer
@@ -12,6 +12,7 @@ namespace stride::ast
     class AstPackage;
     class AstFunctionDeclaration;
     class IAstExpression;
+    class AstBlock;
     class Ast;
 
     /// Visitor that infers and assigns types to every expression node in the AST.
@@ -28,6 +29,14 @@ namespace stride::ast
         /// For AstVariableDeclaration: also registers the variable in its context.
         /// For IAstFunction: also registers the function in its context.
         void accept(IAstExpression* expr) override;
+
+        /// Expressions only refer to the contexts of their own file, and to the root contexts of
+        /// other files for the types they import, which are locked for concurrent lookups.
+        [[nodiscard]]
+        bool is_thread_safe() const override
+        {
+            return true;
+        }
     };
 
     class FunctionVisitor : public IVisitor
@@ -57,6 +66,11 @@ namespace stride::ast
             this->_current_file_name = file_name;
         }
 
+        void begin_file(const std::string& file_name, AstBlock*) override
+        {
+            this->set_current_file_name(file_name);
+        }
+
         void accept(AstImport* node) override;
 
         void accept(AstPackage* node) override;
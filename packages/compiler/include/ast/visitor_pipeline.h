@@ -0,0 +1,103 @@
+#pragma once
+
+#include "nodes/traversal.h"
+#include "thread_pool.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stride::ast
+{
+    /// Forwards every node to several visitors in turn, so that they share a single traversal.
+    /// Each node reaches the visitors in the order they were added.
+    class CompositeVisitor : public IVisitor
+    {
+        std::vector<IVisitor*> _visitors;
+
+    public:
+        CompositeVisitor() = default;
+
+        explicit CompositeVisitor(std::vector<IVisitor*> visitors) :
+            _visitors(std::move(visitors)) {}
+
+        void add(IVisitor* visitor)
+        {
+            this->_visitors.push_back(visitor);
+        }
+
+        [[nodiscard]]
+        const std::vector<IVisitor*>& get_visitors() const
+        {
+            return this->_visitors;
+        }
+
+        void begin_file(const std::string& file_name, AstBlock* root) override;
+
+        void accept(IAstExpression* expr) override;
+
+        void accept(IAstFunction* fn) override;
+
+        void accept(AstImport* node) override;
+
+        void accept(AstPackage* node) override;
+    };
+
+    /**
+     * Runs a set of visitors over the files of a program in as few traversals as possible.
+     *
+     * Every visitor declares the visitors it depends on: those must have visited every file before it
+     * visits its first node, for instance because it looks up symbols that other files define. A
+     * dependency is a barrier between phases. Visitors that don't depend on each other, directly or
+     * indirectly, share a phase and are fused into a single traversal of each file.
+     *
+     * Given a thread pool, the files are traversed concurrently, one task per file, in phases where
+     * every visitor is thread-safe. Errors raised by those tasks are reported once all of them have
+     * finished, in the order of their position, so they don't depend on the scheduling of the tasks.
+     */
+    class VisitorPipeline
+    {
+        struct Pass
+        {
+            IVisitor* visitor;
+            size_t phase;
+            std::vector<std::function<void()>> completion_actions;
+            std::vector<std::function<void(const std::string&, AstBlock*)>> file_actions;
+        };
+
+        std::vector<Pass> _passes;
+
+        Pass& get_pass(const IVisitor* visitor);
+
+        /// Runs the phases in order, traversing the files of thread-safe phases on <code>pool</code>, if any.
+        void run_phases(const std::vector<std::pair<std::string, AstBlock*>>& files, ThreadPool* pool);
+
+    public:
+        /// Adds a visitor that starts once every visitor in <code>dependencies</code> has visited every file.
+        /// Dependencies have to be added to the pipeline first.
+        void add(IVisitor* visitor, const std::vector<const IVisitor*>& dependencies = {});
+
+        /// Runs <code>action</code> once the phase of <code>visitor</code> is complete, before the next phase starts.
+        /// This is where results gathered from all files are combined.
+        void on_complete(const IVisitor* visitor, std::function<void()> action);
+
+        /// Runs <code>action</code> on each file once the phase of <code>visitor</code> has traversed it.
+        /// In concurrent phases, this happens on the thread that traversed the file.
+        void on_file_complete(
+            const IVisitor* visitor,
+            std::function<void(const std::string& file_name, AstBlock* root)> action);
+
+        /// The visitors sharing each traversal, in the order the traversals run
+        [[nodiscard]]
+        std::vector<std::vector<IVisitor*>> get_phases() const;
+
+        void run(const std::map<std::string, std::unique_ptr<AstBlock>>& files);
+
+        void run(const std::map<std::string, std::unique_ptr<AstBlock>>& files, ThreadPool& pool);
+
+        void run(const std::string& file_name, AstBlock* root);
+    };
+}
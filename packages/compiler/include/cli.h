@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -21,6 +22,35 @@ namespace stride::cli
         COMPILE
     };
 
+    /**
+     * @brief Optimization levels, set with <code>-O0</code> through <code>-O3</code>, <code>-Os</code> or <code>-Oz</code>.
+     *
+     * They select both the optimization pipeline and the effort of the code generator, as in clang.
+     * <code>O0</code> skips the optimization pipeline altogether, which is the quickest way to run a program.
+     */
+    enum class OptimizationLevel
+    {
+        O0,
+        O1,
+        O2,
+        O3,
+        Os,
+        Oz
+    };
+
+    /**
+     * @brief How the lazy JIT groups functions into the units it compiles, set with <code>--lazy=<partitioning></code>.
+     *
+     * - <code>FUNCTION</code>: every function is compiled on its first call, on its own.
+     * - <code>FILE</code>: the first call of a function compiles its whole file, so that its functions are
+     *   optimized together.
+     */
+    enum class LazyPartitioning
+    {
+        FUNCTION,
+        FILE
+    };
+
     typedef struct CompilationOptions
     {
         /**
@@ -76,6 +106,74 @@ namespace stride::cli
          * Examples: "xtensa-esp32-elf", "riscv32-unknown-elf", "aarch64-linux-gnu".
          */
         std::string target_triple;
+
+        /**
+         * @brief Number of threads the compiler may use, set with <code>-j N</code>.
+         *
+         * When 0, one thread is used per hardware thread.
+         */
+        size_t thread_count;
+
+        /**
+         * @brief Directory of the parsed-file cache, set with <code>--cache-dir <path></code>.
+         *
+         * Files that didn't change since an earlier compilation are loaded from the cache instead
+         * of being parsed again. When empty, no cache is used.
+         */
+        std::string cache_directory;
+
+        /**
+         * @brief Whether function bodies are parsed lazily, set with <code>--lazy-parse</code>.
+         *
+         * Bodies of functions that can't be reached from <code>main</code> or a public function
+         * are then never parsed, analyzed or generated.
+         */
+        bool lazy_parsing;
+
+        /**
+         * @brief The optimization level, set with <code>-O<level></code>. Defaults to <code>O3</code>.
+         */
+        OptimizationLevel optimization_level;
+
+        /**
+         * @brief A custom optimization pipeline, set with <code>--passes=<pipeline></code>.
+         *
+         * It's written in the textual pipeline syntax of LLVM's <code>opt</code>, e.g.
+         * <code>"function(instcombine,simplifycfg)"</code>, and replaces the pipeline of the
+         * optimization level. The level still applies to the code generator.
+         */
+        std::string pass_pipeline;
+
+        /**
+         * @brief Whether the JIT compiles in tiers, set with <code>--tiered</code>.
+         *
+         * Functions are first compiled without optimizations, so the program starts right away. Those
+         * called <code>tier_up_threshold</code> times are then recompiled in the background at the
+         * optimization level, and later calls run the optimized code.
+         */
+        bool tiered_compilation;
+
+        /**
+         * @brief Calls after which a function is recompiled with optimizations, set with
+         * <code>--tier-up-threshold=<calls></code>.
+         */
+        size_t tier_up_threshold;
+
+        /**
+         * @brief Whether the JIT compiles functions on their first call, set with <code>--lazy</code>.
+         *
+         * Functions that are never called, such as most of the standard library, are then never
+         * optimized or compiled. Partitions are compiled on <code>thread_count</code> threads of LLVM's own,
+         * which only start compiling once the shared pool is done lowering the program.
+         * Can't be combined with <code>tiered_compilation</code>.
+         */
+        bool lazy_compilation;
+
+        /**
+         * @brief The units compiled by the lazy JIT, set with <code>--lazy=function</code> (the default) or
+         * <code>--lazy=file</code>.
+         */
+        LazyPartitioning lazy_partitioning;
     } CompilationOptions;
 
     /**
@@ -1,6 +1,8 @@
 #pragma once
 #include "files.h"
 
+#include <exception>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -53,6 +55,9 @@ namespace stride
     {
         std::string what_msg;
 
+        /// Where the error occurred, if it was raised for a position in a source file
+        std::optional<SourceFragment> source_position;
+
     public:
         explicit parsing_error(const char* str) :
             std::runtime_error(str),
@@ -67,14 +72,29 @@ namespace stride
             const SourceFragment& source,
             const std::string& suggestion = ""
         ) :
-            parsing_error(make_source_error(error_type, error, source, suggestion)) {}
+            parsing_error(make_source_error(error_type, error, source, suggestion))
+        {
+            this->source_position = source;
+        }
 
         explicit parsing_error(
             const ErrorType error_type,
             const std::string& error,
             const std::vector<ErrorSourceReference>& references
         ) :
-            parsing_error(make_source_error(error_type, error, references)) {}
+            parsing_error(make_source_error(error_type, error, references))
+        {
+            if (!references.empty())
+            {
+                this->source_position = references.front().source_position;
+            }
+        }
+
+        [[nodiscard]]
+        const std::optional<SourceFragment>& get_source_position() const
+        {
+            return this->source_position;
+        }
 
         [[nodiscard]]
         const char* what() const noexcept override
@@ -82,4 +102,14 @@ namespace stride
             return what_msg.c_str();
         }
     };
+
+    /**
+     * Rethrows the errors of work that ran concurrently, in an order that doesn't depend on which
+     * work finished first: by the path of their source file, then by offset. Errors without a position
+     * come last, in the order given. A single error is rethrown as is. Several parsing errors are
+     * combined into one reporting all of them; otherwise the first error is rethrown.
+     * <code>errors</code> must not be empty.
+     */
+    [[noreturn]]
+    void rethrow_sorted_errors(std::vector<std::exception_ptr> errors);
 } // namespace stride
@@ -1,19 +1,114 @@
 #pragma once
 
+#include <cstdint>
 #include <fstream>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace stride
 {
-    struct SourceFile
+    /// Compact handle of a <code>SourceFile</code>, used by locations that can't afford to hold a
+    /// <code>std::shared_ptr</code>, such as tokens.
+    using SourceFileId = uint32_t;
+
+    static constexpr SourceFileId INVALID_SOURCE_FILE_ID = std::numeric_limits<SourceFileId>::max();
+
+    /// Files at least this large are memory-mapped by <code>read_file</code> instead of being read.
+    static constexpr size_t SOURCE_MMAP_THRESHOLD = 64 * 1024;
+
+    /// A line in a source file. <code>[start, end)</code> spans the line without its line break.
+    struct SourceLine
+    {
+        /// 1-based line number
+        size_t number;
+        size_t start;
+        size_t end;
+    };
+
+    struct SourceEdit;
+
+    struct SourceFile : std::enable_shared_from_this<SourceFile>
     {
         std::string path;
-        std::string source;
 
-        SourceFile(std::string path, std::string source) :
-            path(std::move(path)),
-            source(std::move(source)) {}
+        /// Contents of the file. Points either into a buffer owned by this file,
+        /// or into a read-only memory mapping of it.
+        std::string_view source;
+
+        /// Registry id of this file, see <code>get_source_file</code>.
+        /// The registry slot of a destroyed file is reused under a new generation, so the id isn't.
+        const SourceFileId id;
+
+        SourceFile(std::string path, std::string source);
+
+        /// Takes ownership of a read-only memory mapping of <code>mapped_length</code> bytes,
+        /// which is unmapped once the file is destroyed.
+        SourceFile(std::string path, const char* mapped_data, size_t mapped_length);
+
+        ~SourceFile();
+
+        SourceFile(const SourceFile&) = delete;
+        SourceFile& operator=(const SourceFile&) = delete;
+
+        /// Stores the unescaped contents of the string literal starting at <code>offset</code>.
+        /// Only literals containing escape sequences are stored; all others are views into <code>source</code>.
+        void set_unescaped_literal(size_t offset, std::string value);
+
+        [[nodiscard]]
+        std::string_view get_unescaped_literal(size_t offset) const;
+
+        [[nodiscard]]
+        bool is_memory_mapped() const
+        {
+            return this->_mapped_data != nullptr;
+        }
+
+        /// Returns the line containing <code>offset</code>. A line break belongs to the line it ends.
+        /// The line index is built on first use, after which lookups are a binary search.
+        ///
+        /// Once later revisions have been recorded with <code>add_revision</code>, lines are numbered
+        /// as in the latest one, while <code>start</code> and <code>end</code> remain offsets into this file.
+        [[nodiscard]]
+        SourceLine get_line(size_t offset) const;
+
+        /**
+         * @brief Records that <code>edit</code> turned this file, the latest revision, into <code>revision</code>.
+         *
+         * Lines of this file and of every earlier revision that follow the edit are then numbered by
+         * where they moved to, so that nodes parsed from an earlier revision report the lines of the
+         * latest one. Revisions share their history, which must not be extended while lines are looked up.
+         */
+        void add_revision(SourceFile& revision, const SourceEdit& edit);
+
+    private:
+        /// An edit made to a later revision, in the offsets of the revision it was made to.
+        struct LineShift
+        {
+            size_t offset;
+            size_t removed_end;
+            size_t inserted_length;
+            int64_t line_delta;
+        };
+
+        /// Offsets at which each line starts, built lazily by <code>get_line</code>.
+        mutable std::vector<size_t> _line_starts;
+        mutable std::once_flag _line_starts_built;
+
+        /// Edits made to all revisions of this file, of which those from <code>_first_later_edit</code>
+        /// on were made after this one.
+        std::shared_ptr<std::vector<LineShift>> _edits;
+        size_t _first_later_edit = 0;
+
+        std::string _owned_source;
+        const char* _mapped_data = nullptr;
+        size_t _mapped_length = 0;
+
+        std::unordered_map<size_t, std::string> _unescaped_literals;
     };
 
     struct SourceFragment
@@ -46,5 +141,45 @@ namespace stride
         static SourceFragment combine(const SourceFragment& source_fragment, const SourceFragment& get_source_fragment);
     };
 
+    /// Replacement of <code>removed_length</code> bytes at <code>offset</code> by <code>replacement</code>.
+    struct SourceEdit
+    {
+        size_t offset;
+        size_t removed_length;
+        std::string replacement;
+
+        /// End of the replaced range, in the file before the edit
+        [[nodiscard]]
+        size_t removed_end() const
+        {
+            return this->offset + this->removed_length;
+        }
+
+        /// End of the replacement, in the file after the edit
+        [[nodiscard]]
+        size_t inserted_end() const
+        {
+            return this->offset + this->replacement.size();
+        }
+
+        /// How far everything after the edit moves
+        [[nodiscard]]
+        int64_t delta() const
+        {
+            return static_cast<int64_t>(this->replacement.size()) - static_cast<int64_t>(this->removed_length);
+        }
+    };
+
+    /// Returns a new revision of <code>file</code> with <code>edit</code> applied. The original file is left untouched,
+    /// so tokens and AST nodes referring to it stay valid.
+    std::shared_ptr<SourceFile> apply_edit(const SourceFile& file, const SourceEdit& edit);
+
+    /// Loads a source file. Regular files of at least <code>SOURCE_MMAP_THRESHOLD</code> bytes are
+    /// memory-mapped; smaller files, pipes and other special files are read into memory.
     std::shared_ptr<SourceFile> read_file(const std::string& path);
+
+    /// Resolves a source file by its registry id.
+    /// Returns nullptr if the id is invalid, or if the file has already been destroyed, even once another
+    /// file has taken its place in the registry.
+    SourceFile* get_source_file(SourceFileId id);
 } // namespace stride
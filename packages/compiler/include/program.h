@@ -5,6 +5,7 @@
 #include "ast/nodes/ast_node.h"
 #include "ast/nodes/blocks.h"
 
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/Target/TargetMachine.h>
 
 namespace stride
@@ -39,7 +40,8 @@ namespace stride
             _ast(std::move(ast)) {}
 
     public:
-        static Program from_sources(const std::vector<std::string>& files);
+        /// Parses the source files of <code>options</code>, using the parsed-file cache if one is set.
+        static Program from_sources(const cli::CompilationOptions& options);
 
         ~Program() = default;
 
@@ -58,11 +60,47 @@ namespace stride
             return this->_ast.get();
         }
 
-    private:
-        std::unique_ptr<llvm::Module> prepare_module(
-            llvm::LLVMContext& context,
+        /// Runs the pipeline of <code>--passes</code> if one is given, or the default pipeline of the optimization
+        /// level of <code>options</code>. At <code>-O0</code>, nothing runs.
+        static void optimize_module(
+            llvm::Module& module,
+            llvm::TargetMachine* target_machine,
+            const cli::CompilationOptions& options
+        );
+
+        /// Throws if the pipeline of <code>--passes</code> can't be parsed for <code>target_machine</code>.
+        static void validate_pass_pipeline(
             const cli::CompilationOptions& options,
-            llvm::TargetMachine* target_machine
+            const llvm::TargetMachine* target_machine
+        );
+
+        /**
+         * Analyzes the program, then lowers every file into a module of its own, in an LLVMContext of its own.
+         *
+         * Files are lowered and optimized concurrently on the shared thread pool. Functions and globals of other
+         * files are only declared in the modules referring to them, and are resolved when the modules are linked.
+         * The modules are returned in the order of their files. An invalid <code>--passes</code> pipeline is
+         * reported before anything is analyzed.
+         */
+        std::vector<llvm::orc::ThreadSafeModule> prepare_modules(
+            const cli::CompilationOptions& options,
+            const llvm::TargetMachine* target_machine
         ) const;
+
+        /// A target machine configured like <code>target_machine</code>.
+        /// Target machines aren't meant to be shared by threads generating code, so each thread makes a copy.
+        static std::unique_ptr<llvm::TargetMachine> clone_target_machine(const llvm::TargetMachine* target_machine);
+
+    private:
+        /// Emits an object file per module, concurrently, and returns their paths.
+        /// The object file of a program made of a single file is named after the program.
+        static std::vector<std::string> emit_object_files(
+            const std::vector<llvm::orc::ThreadSafeModule>& modules,
+            const cli::CompilationOptions& options,
+            const llvm::TargetMachine* target_machine
+        );
+
+        /// The effort of the code generator at <code>level</code>, matching clang
+        static llvm::CodeGenOptLevel get_codegen_opt_level(cli::OptimizationLevel level);
     };
 } // namespace stride
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace stride
+{
+    /**
+     * @brief A fixed-size pool of worker threads that balance their work by stealing.
+     *
+     * Every worker owns a queue. Tasks submitted from a worker go to its own queue, which it
+     * runs newest-first, while idle workers steal the oldest tasks from the queues of others.
+     * Tasks submitted from any other thread go to a shared queue that is run in submission order,
+     * so callers can decide which tasks start first.
+     *
+     * Tasks may submit and wait for other tasks: <code>wait</code> runs pending tasks on the
+     * waiting worker instead of blocking it, so nested parallelism can't deadlock the pool.
+     */
+    class ThreadPool
+    {
+        using Task = std::function<void()>;
+
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        /// One queue per worker, followed by the queue of tasks submitted from other threads
+        std::vector<std::unique_ptr<WorkQueue>> _queues;
+        std::vector<std::thread> _workers;
+
+        /// Number of tasks that have been submitted but not yet taken by a worker
+        std::atomic<size_t> _queued_task_count = 0;
+
+        std::mutex _idle_mutex;
+        std::condition_variable _idle_condition;
+        bool _stopping = false;
+
+    public:
+        /// Starts <code>thread_count</code> workers, or one per hardware thread if it is 0.
+        explicit ThreadPool(size_t thread_count = 0);
+
+        /// Finishes all queued tasks, then joins the workers.
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// Schedules <code>task</code>. Its result, or the exception it throws, is delivered through
+        /// the returned future.
+        template <typename Fn>
+        std::future<std::invoke_result_t<Fn>> submit(Fn&& task)
+        {
+            using Result = std::invoke_result_t<Fn>;
+
+            // std::function must be copyable, so the move-only task is shared instead
+            auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(task));
+            auto future = packaged->get_future();
+
+            this->push([packaged] { (*packaged)(); });
+            return future;
+        }
+
+        /// Waits for <code>future</code> and returns its result. When called from a worker of this
+        /// pool, queued tasks are run in the meantime.
+        template <typename T>
+        T wait(std::future<T>& future)
+        {
+            if (this->is_worker_thread())
+            {
+                while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                {
+                    if (!this->run_pending_task())
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            return future.get();
+        }
+
+        [[nodiscard]]
+        size_t get_thread_count() const
+        {
+            return this->_workers.size();
+        }
+
+        /// Whether the calling thread is one of the workers of this pool.
+        [[nodiscard]]
+        bool is_worker_thread() const;
+
+        /**
+         * @brief The pool shared by all compiler phases.
+         *
+         * It is created on first use, with the number of threads last passed to
+         * <code>set_shared_thread_count</code>, or one per hardware thread.
+         */
+        static ThreadPool& shared();
+
+        /// Sets the size of the shared pool. Must be called before it is first used.
+        static void set_shared_thread_count(size_t thread_count);
+
+    private:
+        void push(Task task);
+
+        /// Takes a task from the queue of the calling worker, or steals one from another queue,
+        /// and runs it. Returns false if there was nothing to run.
+        bool run_pending_task();
+
+        bool try_pop(size_t queue_index, Task& task, bool steal);
+
+        void run_worker(size_t index);
+    };
+} // namespace stride
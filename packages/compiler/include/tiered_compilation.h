@@ -0,0 +1,97 @@
+#pragma once
+#include "cli.h"
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <llvm/ExecutionEngine/Orc/IndirectionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Target/TargetMachine.h>
+
+namespace stride
+{
+    /**
+     * @brief Runs a program unoptimized right away, and optimizes the functions it calls most while it runs.
+     *
+     * Every function is called through a stub, which jumps to the address held by a pointer of its own. The
+     * first tier of a function is its unoptimized code, which counts its calls. Once a function has been
+     * called <code>tier_up_threshold</code> times, a copy of its unoptimized IR is optimized and compiled on
+     * the shared thread pool, after which its pointer is redirected to the optimized code. Calls that are
+     * already running finish in the first tier; every later call, from any module, runs the second tier.
+     *
+     * Functions are recompiled one at a time, each in a module of its own that only declares the rest of
+     * the program. Private symbols are made hidden ones beforehand, so that these modules can refer to them.
+     */
+    class TieredCompilation
+    {
+        struct TieredFunction
+        {
+            /// Symbol of the stub, which is the name of the function
+            std::string name;
+
+            /// Module whose unoptimized IR holds the function
+            size_t module_index;
+        };
+
+        llvm::orc::LLJIT* _jit;
+
+        /// Generates the code of the second tier; copied by every recompilation
+        std::unique_ptr<llvm::TargetMachine> _target_machine;
+
+        cli::CompilationOptions _options;
+
+        /// The unoptimized IR of each module, as it was before calls were counted
+        std::vector<llvm::orc::ThreadSafeModule> _sources;
+
+        std::vector<TieredFunction> _functions;
+
+        /// Gives private symbols unique names of all modules, so it's shared by them
+        llvm::orc::SymbolLinkagePromoter _promoter;
+
+        std::mutex _recompilations_mutex;
+        std::vector<std::future<void>> _recompilations;
+        std::atomic<size_t> _recompiled_count = 0;
+
+    public:
+        /// Tiers the modules added to <code>jit</code>. Hot functions are optimized at the optimization
+        /// level of <code>options</code>, and compiled for <code>target_machine</code>.
+        TieredCompilation(
+            llvm::orc::LLJIT* jit,
+            std::unique_ptr<llvm::TargetMachine> target_machine,
+            const cli::CompilationOptions& options
+        );
+
+        /// Waits for the recompilations that are still running, as they add code to the JIT
+        ~TieredCompilation();
+
+        TieredCompilation(const TieredCompilation&) = delete;
+        TieredCompilation& operator=(const TieredCompilation&) = delete;
+
+        /// Adds an unoptimized module to the JIT as the first tier of its functions
+        void add_module(llvm::orc::ThreadSafeModule module);
+
+        /// Waits for the recompilations that have been requested so far
+        void wait();
+
+        /// Number of functions that run optimized code by now
+        [[nodiscard]]
+        size_t get_recompiled_count() const
+        {
+            return this->_recompiled_count.load(std::memory_order_relaxed);
+        }
+
+    private:
+        /// Routes the calls of every eligible function of <code>module</code> through a stub, and counts them
+        void instrument(llvm::Module& module, size_t module_index);
+
+        /// Called by the first tier of a function once it has become hot
+        static void tier_up(TieredCompilation* compilation, uint64_t function_index);
+
+        void recompile(const TieredFunction& function);
+    };
+} // namespace stride
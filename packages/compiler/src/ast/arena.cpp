@@ -0,0 +1,130 @@
+#include "ast/arena.h"
+
+#include <cassert>
+#include <cstdint>
+
+using namespace stride::ast;
+
+namespace
+{
+    constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+    /*
+     * Memory of the heap and of arenas is told apart by its address, so neither needs a header.
+     * Heap memory and chunks are aligned to twice the alignment objects need. Arena memory starts
+     * one alignment into its chunk, and every allocation is a multiple of twice the alignment, so
+     * arena memory is never aligned to twice the alignment, and heap memory always is.
+     */
+    constexpr size_t STRIDE = 2 * ALIGNMENT;
+
+    bool is_arena_memory(const void* memory)
+    {
+        return reinterpret_cast<uintptr_t>(memory) % STRIDE == ALIGNMENT;
+    }
+
+    /// The arena installed on this thread, and the part of its current chunk this thread bumps through
+    thread_local AstArena* current_arena = nullptr;
+    thread_local std::byte* current_cursor = nullptr;
+    thread_local std::byte* current_end = nullptr;
+
+    size_t align_size(const size_t size)
+    {
+        return (size + STRIDE - 1) & ~(STRIDE - 1);
+    }
+}
+
+void AstArena::ChunkDeleter::operator()(std::byte* chunk) const noexcept
+{
+    ::operator delete(chunk, std::align_val_t{ STRIDE });
+}
+
+AstArena::~AstArena()
+{
+    assert(this->_installed_scopes.load() == 0 && "AST arena destroyed while a thread still allocates from it");
+}
+
+AstArena* AstArena::current()
+{
+    return current_arena;
+}
+
+AstArena::Scope::Scope(AstArena& arena) :
+    _previous_arena(current_arena),
+    _previous_cursor(current_cursor),
+    _previous_end(current_end)
+{
+    arena._installed_scopes.fetch_add(1, std::memory_order_relaxed);
+
+    current_arena = &arena;
+    current_cursor = nullptr;
+    current_end = nullptr;
+}
+
+AstArena::Scope::~Scope()
+{
+    current_arena->_installed_scopes.fetch_sub(1, std::memory_order_relaxed);
+
+    current_arena = this->_previous_arena;
+    current_cursor = this->_previous_cursor;
+    current_end = this->_previous_end;
+}
+
+std::byte* AstArena::allocate_chunk(const size_t size)
+{
+    std::unique_ptr<std::byte[], ChunkDeleter> chunk(
+        static_cast<std::byte*>(::operator new(ALIGNMENT + size, std::align_val_t{ STRIDE })));
+
+    // The usable part of the chunk starts one alignment in, see is_arena_memory
+    auto* memory = chunk.get() + ALIGNMENT;
+
+    std::lock_guard lock(this->_mutex);
+    this->_chunks.push_back(std::move(chunk));
+    return memory;
+}
+
+void* AstArena::allocate(size_t size)
+{
+    size = align_size(size);
+    this->_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    // Only the installing thread bumps through its part of the arena
+    if (current_arena == this)
+    {
+        if (static_cast<size_t>(current_end - current_cursor) < size)
+        {
+            if (size > CHUNK_SIZE / 4)
+            {
+                return this->allocate_chunk(size);
+            }
+
+            current_cursor = this->allocate_chunk(CHUNK_SIZE);
+            current_end = current_cursor + CHUNK_SIZE;
+        }
+
+        auto* memory = current_cursor;
+        current_cursor += size;
+        return memory;
+    }
+
+    return this->allocate_chunk(size);
+}
+
+void* stride::ast::allocate_ast_memory(const size_t size)
+{
+    if (auto* arena = current_arena)
+    {
+        return arena->allocate(size);
+    }
+
+    return ::operator new(size, std::align_val_t{ STRIDE });
+}
+
+void stride::ast::deallocate_ast_memory(void* memory) noexcept
+{
+    if (memory == nullptr || is_arena_memory(memory))
+    {
+        return;
+    }
+
+    ::operator delete(memory, std::align_val_t{ STRIDE });
+}
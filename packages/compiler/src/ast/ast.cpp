@@ -1,8 +1,11 @@
 #include "ast/ast.h"
 
+#include "errors.h"
 #include "files.h"
+#include "thread_pool.h"
 #include "ast/modifiers.h"
 #include "ast/parsing_context.h"
+#include "ast/serialization.h"
 #include "ast/nodes/blocks.h"
 #include "ast/nodes/conditional_statement.h"
 #include "ast/nodes/control_flow_statements.h"
@@ -17,50 +20,112 @@
 #include "ast/nodes/while_loop.h"
 #include "ast/tokens/tokenizer.h"
 
+#include <algorithm>
+#include <filesystem>
 #include <future>
 #include <iostream>
+#include <ranges>
 
 using namespace stride::ast;
 
 std::unique_ptr<Ast> Ast::parse_files(const std::vector<FilePath>& files)
+{
+    return parse_files(files, ThreadPool::shared());
+}
+
+std::unique_ptr<Ast> Ast::parse_files(
+    const std::vector<FilePath>& files,
+    ThreadPool& pool,
+    const AstCache* cache,
+    const bool lazy_function_bodies
+)
 {
     auto ast = std::make_unique<Ast>();
 
+    std::vector<std::pair<uintmax_t, const FilePath*>> files_by_size;
+    files_by_size.reserve(files.size());
+
+    for (const auto& file : files)
+    {
+        // Files that can't be sized are scheduled last, reading them reports the actual error
+        std::error_code error;
+        const auto size = std::filesystem::file_size(file, error);
+        files_by_size.emplace_back(error ? 0 : size, &file);
+    }
+
+    std::ranges::stable_sort(
+        files_by_size,
+        std::ranges::greater{},
+        &std::pair<uintmax_t, const FilePath*>::first);
+
     std::vector<std::future<std::pair<FilePath, std::unique_ptr<AstBlock>>>> futures;
     futures.reserve(files.size());
 
-    for (const auto& file : files)
+    for (const auto* file : files_by_size | std::views::values)
     {
         futures.push_back(
-            std::async(
-                std::launch::async,
-                [file]
+            pool.submit(
+                [file = *file, arena = ast->_arena.get(), cache, lazy_function_bodies]
                 {
-                    return parse_file(file);
+                    AstArena::Scope arena_scope(*arena);
+                    return parse_file(file, cache, lazy_function_bodies);
                 }
             )
         );
     }
 
+    // Every task has to finish before the errors are reported, as they allocate from the arena of the AST
+    std::vector<std::exception_ptr> errors;
     for (auto& future : futures)
     {
-        auto [file_path, node] = future.get();
+        try
+        {
+            auto [file_path, node] = pool.wait(future);
+
+            ast->_files.emplace(file_path, std::move(node));
+        }
+        catch (...)
+        {
+            errors.push_back(std::current_exception());
+        }
+    }
 
-        ast->_files.emplace(file_path, std::move(node));
+    if (!errors.empty())
+    {
+        rethrow_sorted_errors(std::move(errors));
     }
 
     return ast;
 }
 
-std::pair<FilePath, std::unique_ptr<AstBlock>> Ast::parse_file(const FilePath& path)
+std::pair<FilePath, std::unique_ptr<AstBlock>> Ast::parse_file(
+    const FilePath& path,
+    const AstCache* cache,
+    const bool lazy_function_bodies
+)
 {
     const auto source_file = read_file(path);
+
+    if (cache != nullptr)
+    {
+        if (auto cached_node = cache->load(source_file, lazy_function_bodies))
+        {
+            return { path, std::move(cached_node) };
+        }
+    }
+
     auto tokens = tokenizer::tokenize(source_file);
 
-    const auto context = std::make_shared<ParsingContext>();
+    const auto context = make_context();
+    const LazyParsingScope lazy_scope(lazy_function_bodies);
 
     auto file_node = parse_sequential(context, tokens);
 
+    if (cache != nullptr)
+    {
+        cache->store(*source_file, file_node.get(), lazy_function_bodies);
+    }
+
     return { path, std::move(file_node) };
 }
 
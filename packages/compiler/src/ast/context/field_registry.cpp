@@ -2,6 +2,7 @@
 #include "ast/parsing_context.h"
 
 #include <algorithm>
+#include <optional>
 
 using namespace stride::ast;
 
@@ -10,35 +11,47 @@ const definition::FieldDefinition* ParsingContext::get_variable_def(
     const bool use_raw_name
 ) const
 {
-    for (const auto& symbol_def : this->_symbols)
+    // Names that were never interned can't belong to any definition
+    const auto interned_name = InternedString::find(variable_name);
+    if (!interned_name.has_value())
     {
-        if (const auto* field_definition = dynamic_cast<const definition::FieldDefinition*>(
-            symbol_def.get()))
-        {
-            if (field_definition->get_internal_symbol_name() == variable_name
-                || (use_raw_name && field_definition->get_field_name() == variable_name))
-            {
-                return field_definition;
-            }
-        }
+        return nullptr;
     }
-    return nullptr;
+
+    const auto& fields = this->_index.fields;
+    const auto& fields_by_name = this->_index.fields_by_name;
+
+    std::optional<size_t> position = std::nullopt;
+    if (const auto field = fields.find(interned_name.value()); field != fields.end())
+    {
+        position = field->second;
+    }
+
+    // Whichever field was defined first matches, like when scanning the definitions in order
+    if (const auto field = fields_by_name.find(interned_name.value());
+        use_raw_name && field != fields_by_name.end())
+    {
+        position = std::min(position.value_or(field->second), field->second);
+    }
+
+    if (!position.has_value())
+    {
+        return nullptr;
+    }
+
+    return static_cast<const definition::FieldDefinition*>(this->_symbols[position.value()].get());
 }
 
 bool ParsingContext::is_field_defined_in_scope(
     const std::string& variable_name) const
 {
-    return std::ranges::any_of(
-        this->_symbols,
-        [&](const auto& symbol_def)
-        {
-            if (const auto* var_def = dynamic_cast<const definition::FieldDefinition*>(symbol_def.
-                get()))
-            {
-                return var_def->get_internal_symbol_name() == variable_name;
-            }
-            return false;
-        });
+    const auto interned_name = InternedString::find(variable_name);
+    if (!interned_name.has_value())
+    {
+        return false;
+    }
+
+    return this->_index.fields.contains(interned_name.value());
 }
 
 bool ParsingContext::is_field_defined_globally(
@@ -66,13 +79,13 @@ void ParsingContext::define_variable_globally(
     {
         throw parsing_error(
             ErrorType::SEMANTIC_ERROR,
-            std::format("Variable '{}' is already defined in global scope", variable_symbol.name),
+            std::format("Variable '{}' is already defined in global scope", variable_symbol.name.str()),
             type->get_source_fragment()
         );
     }
 
     auto& global_scope = const_cast<ParsingContext&>(this->traverse_to_root());
-    global_scope._symbols.push_back(
+    global_scope.add_definition(
         std::make_unique<definition::FieldDefinition>(
             std::move(variable_symbol),
             std::move(type),
@@ -101,11 +114,11 @@ void ParsingContext::define_variable(
     {
         throw parsing_error(
             ErrorType::SEMANTIC_ERROR,
-            std::format("Variable '{}' is already defined in this scope", variable_sym.name),
+            std::format("Variable '{}' is already defined in this scope", variable_sym.name.str()),
             type->get_source_fragment());
     }
 
-    this->_symbols.push_back(
+    this->add_definition(
         std::make_unique<definition::FieldDefinition>(
             std::move(variable_sym),
             std::move(type),
@@ -2,26 +2,55 @@
 #include "ast/casting.h"
 #include "ast/parsing_context.h"
 
-#include <algorithm>
-
 using namespace stride::ast;
 using namespace stride::ast::definition;
 
+namespace
+{
+    void hash_combine(size_t& seed, const size_t value)
+    {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+}
+
+std::optional<size_t> stride::ast::definition::hash_parameter_types(
+    const std::vector<std::unique_ptr<IAstType>>& parameter_types
+)
+{
+    size_t seed = parameter_types.size();
+    for (const auto& parameter_type : parameter_types)
+    {
+        // Parameters are compared with equals, which only decides by shape for exact types
+        const auto& interned_type = parameter_type->get_interned_type();
+        if (!interned_type.is_exact)
+        {
+            return std::nullopt;
+        }
+        hash_combine(seed, interned_type.shape);
+    }
+    return seed;
+}
+
 std::optional<FunctionDefinition*> ParsingContext::get_function_definition(
     const std::string& function_name,
     const std::vector<std::unique_ptr<IAstType>>& parameter_types
 ) const
 {
-    for (const auto& global_scope = this->traverse_to_root();
-         const auto& symbol_def : global_scope._symbols)
+    const auto interned_name = InternedString::find(function_name);
+    if (!interned_name.has_value())
     {
-        if (auto* fn_def = dynamic_cast<FunctionDefinition*>(symbol_def.get()))
+        return std::nullopt;
+    }
+
+    if (auto* fn_def = this->traverse_to_root().find_function(
+        interned_name.value(),
+        parameter_types,
+        [&](const FunctionDefinition* candidate)
         {
-            if (fn_def->matches_parameter_signature(function_name, parameter_types))
-            {
-                return fn_def;
-            }
-        }
+            return candidate->matches_parameter_signature(interned_name.value(), parameter_types);
+        }))
+    {
+        return fn_def;
     }
     return std::nullopt;
 }
@@ -33,27 +62,27 @@ std::optional<FunctionDefinition*> ParsingContext::get_function_definition(
 {
     const auto signature = cast_type<AstFunctionType*>(function_type);
 
-    if (!signature)
+    const auto interned_name = InternedString::find(function_name);
+    if (!signature || !interned_name.has_value())
     {
         return std::nullopt;
     }
 
-    for (const auto& global_scope = this->traverse_to_root();
-         const auto& symbol_def : global_scope._symbols)
-    {
-        if (auto* fn_def = dynamic_cast<FunctionDefinition*>(symbol_def.get()))
+    if (auto* fn_def = this->traverse_to_root().find_function(
+        interned_name.value(),
+        signature->get_parameter_types(),
+        [&](const FunctionDefinition* candidate)
         {
-            if (fn_def->matches_type_signature(function_name, signature))
-            {
-                return fn_def;
-            }
-        }
+            return candidate->matches_type_signature(interned_name.value(), signature);
+        }))
+    {
+        return fn_def;
     }
     return std::nullopt;
 }
 
 bool FunctionDefinition::matches_type_signature(
-    const std::string& name,
+    const InternedString name,
     const AstFunctionType* signature
 ) const
 {
@@ -67,12 +96,12 @@ bool FunctionDefinition::matches_type_signature(
 }
 
 bool FunctionDefinition::matches_parameter_signature(
-    const std::string& internal_function_name,
+    const InternedString internal_function_name,
     const std::vector<std::unique_ptr<IAstType>>& other_parameter_types
 )
 const
 {
-    if (this->get_internal_symbol_name() != internal_function_name)
+    if (this->get_internal_symbol() != internal_function_name)
         return false;
 
     const auto& self_params = this->_function_type->get_parameter_types();
@@ -116,12 +145,12 @@ void ParsingContext::define_function(
     {
         throw parsing_error(
             ErrorType::SEMANTIC_ERROR,
-            std::format("Function '{}' already defined globally", function_name.name),
+            std::format("Function '{}' already defined globally", function_name.name.str()),
             function_name.symbol_position
         );
     }
 
-    global_scope._symbols.push_back(
+    global_scope.add_definition(
         std::make_unique<FunctionDefinition>(std::move(function_type), function_name, visibility, flags)
     );
 }
@@ -131,15 +160,17 @@ bool ParsingContext::is_function_defined_globally(
     const AstFunctionType* function_type
 ) const
 {
-    return std::ranges::any_of(
-        this->traverse_to_root()._symbols,
-        [&](const auto& symbol)
+    const auto interned_name = InternedString::find(function_name);
+    if (!interned_name.has_value())
+    {
+        return false;
+    }
+
+    return this->traverse_to_root().find_function(
+        interned_name.value(),
+        function_type->get_parameter_types(),
+        [&](const FunctionDefinition* candidate)
         {
-            if (const auto* fn_def = dynamic_cast<const FunctionDefinition*>(symbol.get()))
-            {
-                return fn_def->matches_type_signature(function_name, function_type);
-            }
-            return false;
-        }
-    );
+            return candidate->matches_type_signature(interned_name.value(), function_type);
+        }) != nullptr;
 }
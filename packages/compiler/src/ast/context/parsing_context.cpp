@@ -1,10 +1,13 @@
 #include "ast/parsing_context.h"
 
 #include "errors.h"
+#include "ast/generics.h"
 #include "ast/symbols.h"
 
 #include <algorithm>
-#include <ranges>
+#include <limits>
+#include <mutex>
+#include <utility>
 
 using namespace stride::ast;
 using namespace stride::ast::definition;
@@ -37,29 +40,173 @@ const ParsingContext& ParsingContext::traverse_to_root() const
     return *current;
 }
 
+void ParsingContext::link_scope()
+{
+    auto& root = const_cast<ParsingContext&>(this->traverse_to_root());
+
+    this->_previous_scope = &root;
+    this->_next_scope = root._next_scope;
+    if (root._next_scope != nullptr)
+    {
+        root._next_scope->_previous_scope = this;
+    }
+    root._next_scope = this;
+}
+
+ParsingContext::~ParsingContext()
+{
+    if (this->_previous_scope != nullptr)
+    {
+        this->_previous_scope->_next_scope = this->_next_scope;
+    }
+    if (this->_next_scope != nullptr)
+    {
+        this->_next_scope->_previous_scope = this->_previous_scope;
+    }
+}
+
+void ParsingContext::mark_parsed()
+{
+    for (auto* scope = &const_cast<ParsingContext&>(this->traverse_to_root());
+         scope != nullptr;
+         scope = scope->_next_scope)
+    {
+        scope->_parsed_symbol_count = scope->_symbols.size();
+    }
+}
+
+void ParsingContext::discard_analysis()
+{
+    // Generic instantiations made by the analysis may refer to the definitions removed here
+    advance_analysis_generation();
+
+    for (auto* scope = &const_cast<ParsingContext&>(this->traverse_to_root());
+         scope != nullptr;
+         scope = scope->_next_scope)
+    {
+        if (scope->_symbols.size() > scope->_parsed_symbol_count)
+        {
+            scope->_symbols.resize(scope->_parsed_symbol_count);
+            scope->rebuild_index();
+        }
+    }
+}
+
+std::vector<std::unique_ptr<IDefinition>> ParsingContext::take_symbols()
+{
+    this->_parsed_symbol_count = 0;
+    this->_index = {};
+    return std::exchange(this->_symbols, {});
+}
+
+void ParsingContext::restore_symbols(
+    std::vector<std::unique_ptr<IDefinition>>&& definitions,
+    const bool check_duplicates
+)
+{
+    if (check_duplicates)
+    {
+        for (const auto& definition : definitions)
+        {
+            if (const auto* type_definition = dynamic_cast<TypeDefinition*>(definition.get()))
+            {
+                this->ensure_type_undefined(type_definition->get_symbol());
+            }
+        }
+    }
+
+    this->_symbols.reserve(this->_symbols.size() + definitions.size());
+    for (auto& definition : definitions)
+    {
+        this->add_definition(std::move(definition));
+    }
+    definitions.clear();
+}
+
 void ParsingContext::define_symbol(const Symbol& symbol_name, const SymbolType type)
 {
-    this->_symbols.push_back(
-        std::make_unique<IdentifiableSymbolDef>(type, symbol_name)
-    );
+    this->add_definition(std::make_unique<IdentifiableSymbolDef>(type, symbol_name));
 }
 
 void ParsingContext::define(std::unique_ptr<IDefinition> definition)
 {
+    this->add_definition(std::move(definition));
+}
+
+void ParsingContext::add_definition(std::unique_ptr<IDefinition> definition)
+{
+    std::unique_lock<std::shared_mutex> lock;
+    if (this->_parent_registry == nullptr)
+    {
+        lock = std::unique_lock(this->_root_mutex);
+    }
+
     this->_symbols.push_back(std::move(definition));
+    this->index_definition(this->_symbols.size() - 1);
+}
+
+void ParsingContext::index_definition(const size_t position)
+{
+    const auto* definition = this->_symbols[position].get();
+    const auto& symbol = definition->get_symbol();
+
+    this->_index.by_internal_name.try_emplace(symbol.internal_name, position);
+    this->_index.by_name.try_emplace(symbol.name, position);
+
+    if (dynamic_cast<const FieldDefinition*>(definition))
+    {
+        this->_index.fields.try_emplace(symbol.internal_name, position);
+        this->_index.fields_by_name.try_emplace(symbol.name, position);
+    }
+    else if (const auto* function = dynamic_cast<const FunctionDefinition*>(definition))
+    {
+        auto& overloads = this->_index.functions[symbol.internal_name];
+        overloads.all.push_back(position);
+
+        if (const auto parameter_hash = function->get_parameter_hash(); parameter_hash.has_value())
+        {
+            overloads.by_parameter_hash.emplace(parameter_hash.value(), position);
+        }
+        else
+        {
+            overloads.unhashed.push_back(position);
+        }
+    }
+    else if (dynamic_cast<const TypeDefinition*>(definition))
+    {
+        this->_index.types.try_emplace(symbol.internal_name, position);
+    }
+    else if (dynamic_cast<const IdentifiableSymbolDef*>(definition))
+    {
+        this->_index.identifiable_symbols.try_emplace(symbol.internal_name, position);
+    }
+}
+
+void ParsingContext::rebuild_index()
+{
+    this->_index = {};
+
+    for (size_t position = 0; position < this->_symbols.size(); ++position)
+    {
+        this->index_definition(position);
+    }
 }
 
 std::optional<std::unique_ptr<IDefinition>> ParsingContext::get_definition_by_internal_name(const std::string& internal_name) const
 {
+    const auto interned_name = InternedString::find(internal_name);
+    if (!interned_name.has_value())
+    {
+        return std::nullopt;
+    }
+
     auto current = this;
     while (current != nullptr)
     {
-        for (const auto& symbol_def : current->_symbols)
+        if (const auto position = current->_index.by_internal_name.find(interned_name.value());
+            position != current->_index.by_internal_name.end())
         {
-            if (symbol_def->get_symbol().internal_name == internal_name)
-            {
-                return symbol_def->clone();
-            }
+            return current->_symbols[position->second]->clone();
         }
         current = current->_parent_registry.get();
     }
@@ -69,18 +216,19 @@ std::optional<std::unique_ptr<IDefinition>> ParsingContext::get_definition_by_in
 const IdentifiableSymbolDef* ParsingContext::get_symbol_def(
     const std::string& symbol_name) const
 {
-    for (const auto& symbol_def : this->_symbols)
+    const auto interned_name = InternedString::find(symbol_name);
+    if (!interned_name.has_value())
     {
-        if (const auto* identifier_def =
-            dynamic_cast<const IdentifiableSymbolDef*>(symbol_def.get()))
-        {
-            if (identifier_def->get_internal_symbol_name() == symbol_name)
-            {
-                return identifier_def;
-            }
-        }
+        return nullptr;
     }
-    return nullptr;
+
+    const auto position = this->_index.identifiable_symbols.find(interned_name.value());
+    if (position == this->_index.identifiable_symbols.end())
+    {
+        return nullptr;
+    }
+
+    return static_cast<const IdentifiableSymbolDef*>(this->_symbols[position->second].get());
 }
 
 static size_t levenshtein_distance(const std::string& a, const std::string& b)
@@ -179,15 +327,19 @@ IDefinition* ParsingContext::fuzzy_find(const std::string& symbol_name) const
 
 IDefinition* ParsingContext::lookup_symbol(const std::string& symbol_name) const
 {
+    const auto interned_name = InternedString::find(symbol_name);
+    if (!interned_name.has_value())
+    {
+        return nullptr;
+    }
+
     auto current = this;
     while (current != nullptr)
     {
-        for (const auto& definition : current->_symbols)
+        if (const auto position = current->_index.by_name.find(interned_name.value());
+            position != current->_index.by_name.end())
         {
-            if (definition->get_symbol().name == symbol_name)
-            {
-                return definition.get();
-            }
+            return current->_symbols[position->second].get();
         }
         current = current->_parent_registry.get();
     }
@@ -2,7 +2,9 @@
 #include "ast/casting.h"
 #include "ast/parsing_context.h"
 
+#include <mutex>
 #include <ranges>
+#include <shared_mutex>
 
 using namespace stride::ast;
 using namespace stride::ast::definition;
@@ -22,6 +24,12 @@ bool ParsingContext::is_struct_type_defined(const std::string& struct_name) cons
 
 std::optional<TypeDefinition*> ParsingContext::get_type_definition(const std::string& name) const
 {
+    const auto interned_name = InternedString::find(name);
+    if (!interned_name.has_value())
+    {
+        return std::nullopt;
+    }
+
     auto current = this;
 
     while (current != nullptr)
@@ -33,15 +41,17 @@ std::optional<TypeDefinition*> ParsingContext::get_type_definition(const std::st
             continue;
         }
 
-        for (const auto& symbol_definition : current->_symbols)
+        // Root contexts may be read from the threads analyzing other files, see _root_mutex
+        std::shared_lock<std::shared_mutex> lock;
+        if (current->_parent_registry == nullptr)
         {
-            if (auto* type_definition = dynamic_cast<TypeDefinition*>(symbol_definition.get()))
-            {
-                if (type_definition->get_internal_symbol_name() == name)
-                {
-                    return type_definition;
-                }
-            }
+            lock = std::shared_lock(current->_root_mutex);
+        }
+
+        if (const auto position = current->_index.types.find(interned_name.value());
+            position != current->_index.types.end())
+        {
+            return static_cast<TypeDefinition*>(current->_symbols[position->second].get());
         }
 
         current = current->_parent_registry.get();
@@ -120,12 +130,26 @@ void ParsingContext::define_type(
 {
     auto& root_context = const_cast<ParsingContext&>(this->traverse_to_root());
 
-    if (const auto existing_def = root_context.get_type_definition(type_name.internal_name);
+    this->ensure_type_undefined(type_name);
+
+    root_context.add_definition(
+        std::make_unique<TypeDefinition>(
+            type_name,
+            std::move(type),
+            std::move(generics),
+            visibility
+        )
+    );
+}
+
+void ParsingContext::ensure_type_undefined(const Symbol& type_name) const
+{
+    if (const auto existing_def = this->traverse_to_root().get_type_definition(type_name.internal_name);
         existing_def.has_value())
     {
         throw parsing_error(
             ErrorType::COMPILATION_ERROR,
-            std::format("Type '{}' is already defined in this scope", type_name.name),
+            std::format("Type '{}' is already defined in this scope", type_name.name.str()),
             {
                 ErrorSourceReference(
                     "Previous definition here",
@@ -134,13 +158,4 @@ void ParsingContext::define_type(
             }
         );
     }
-
-    root_context._symbols.push_back(
-        std::make_unique<TypeDefinition>(
-            type_name,
-            std::move(type),
-            std::move(generics),
-            visibility
-        )
-    );
 }
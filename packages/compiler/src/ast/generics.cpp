@@ -8,8 +8,177 @@
 #include "ast/tokens/token.h"
 #include "ast/tokens/token_set.h"
 
+#include <algorithm>
+#include <atomic>
+
+using namespace stride;
 using namespace stride::ast;
 
+namespace
+{
+    std::atomic<uint64_t> analysis_generation = 1;
+
+    using InstantiationKey = std::pair<const GenericInstantiationCache*, std::vector<TypeId>>;
+
+    /// Collects the definitions the aliases in <code>type</code> resolve to, depth-first.
+    /// Returns false if one of them doesn't resolve.
+    bool collect_alias_definitions(IAstType* type, std::vector<const definition::TypeDefinition*>& definitions)
+    {
+        if (auto* alias = cast_type<AstAliasType*>(type))
+        {
+            const auto definition = alias->get_type_definition();
+            if (!definition.has_value())
+            {
+                return false;
+            }
+            definitions.push_back(definition.value());
+
+            return std::ranges::all_of(
+                alias->get_instantiated_generic_types(),
+                [&](const auto& argument) { return collect_alias_definitions(argument.get(), definitions); });
+        }
+
+        if (const auto* array = cast_type<AstArrayType*>(type))
+        {
+            return collect_alias_definitions(array->get_element_type(), definitions);
+        }
+
+        if (const auto* function = cast_type<AstFunctionType*>(type))
+        {
+            return collect_alias_definitions(function->get_return_type().get(), definitions)
+                && std::ranges::all_of(
+                    function->get_parameter_types(),
+                    [&](const auto& parameter) { return collect_alias_definitions(parameter.get(), definitions); });
+        }
+
+        if (const auto* tuple = cast_type<AstTupleType*>(type))
+        {
+            return std::ranges::all_of(
+                tuple->get_members(),
+                [&](const auto& member) { return collect_alias_definitions(member.get(), definitions); });
+        }
+
+        if (const auto* object = cast_type<AstObjectType*>(type))
+        {
+            return std::ranges::all_of(
+                    object->get_members_ref(),
+                    [&](const auto& member) { return collect_alias_definitions(member.second.get(), definitions); })
+                && std::ranges::all_of(
+                    object->get_instantiated_generics(),
+                    [&](const auto& argument) { return collect_alias_definitions(argument.get(), definitions); });
+        }
+
+        return true;
+    }
+
+    /// Instantiations being created on this thread, innermost last, to detect generic types resolving to themselves
+    thread_local std::vector<InstantiationKey> instantiations_in_progress;
+
+    class InstantiationInProgress
+    {
+    public:
+        explicit InstantiationInProgress(InstantiationKey key)
+        {
+            instantiations_in_progress.push_back(std::move(key));
+        }
+
+        ~InstantiationInProgress()
+        {
+            instantiations_in_progress.pop_back();
+        }
+
+        InstantiationInProgress(const InstantiationInProgress&) = delete;
+        InstantiationInProgress& operator=(const InstantiationInProgress&) = delete;
+    };
+}
+
+uint64_t stride::ast::get_analysis_generation()
+{
+    return analysis_generation.load(std::memory_order_relaxed);
+}
+
+void stride::ast::advance_analysis_generation()
+{
+    analysis_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+IAstType* GenericInstantiationCache::get_or_instantiate(
+    const GenericTypeList& type_arguments,
+    const std::function<std::unique_ptr<IAstType>()>& instantiate,
+    const std::string& type_name,
+    const SourceFragment& use_site
+)
+{
+    Key key;
+    auto& [type_ids, alias_definitions] = key;
+
+    bool is_cacheable = true;
+    type_ids.reserve(type_arguments.size());
+    for (const auto& argument : type_arguments)
+    {
+        type_ids.push_back(argument->get_type_id());
+        is_cacheable = is_cacheable && collect_alias_definitions(argument.get(), alias_definitions);
+    }
+
+    const auto generation = get_analysis_generation();
+    {
+        std::lock_guard lock(this->_mutex);
+
+        // Instantiations of earlier analyses may refer to definitions that no longer exist
+        if (this->_generation != generation)
+        {
+            this->_instantiations.clear();
+            this->_uncached_instantiations.clear();
+            this->_generation = generation;
+        }
+
+        if (is_cacheable)
+        {
+            if (const auto it = this->_instantiations.find(key); it != this->_instantiations.end())
+            {
+                return it->second.get();
+            }
+        }
+    }
+
+    if (std::ranges::find(instantiations_in_progress, InstantiationKey(this, type_ids)) != instantiations_in_progress.end())
+    {
+        throw parsing_error(
+            ErrorType::TYPE_ERROR,
+            std::format("Generic type '{}' resolves to itself", type_name),
+            use_site
+        );
+    }
+
+    // Instantiating may instantiate other generic types, so the lock isn't held meanwhile
+    std::unique_ptr<IAstType> instantiation;
+    {
+        InstantiationInProgress in_progress({ this, type_ids });
+        instantiation = instantiate();
+    }
+
+    // Instantiations are compared whenever they are used
+    instantiation->intern();
+
+    std::lock_guard lock(this->_mutex);
+
+    // Instantiations that can't be told apart from others are kept until the analysis is discarded, but never shared
+    if (!is_cacheable)
+    {
+        return this->_uncached_instantiations.emplace_back(std::move(instantiation)).get();
+    }
+
+    // If another thread created the same instantiation in the meantime, the first one is kept
+    const auto [it, inserted] = this->_instantiations.try_emplace(std::move(key), std::move(instantiation));
+    return it->second.get();
+}
+
+size_t GenericInstantiationCache::size()
+{
+    std::lock_guard lock(this->_mutex);
+    return this->_instantiations.size();
+}
+
 GenericParameterList stride::ast::parse_generic_declaration(TokenSet& set)
 {
     GenericParameterList generic_params;
@@ -17,14 +186,14 @@ GenericParameterList stride::ast::parse_generic_declaration(TokenSet& set)
     {
         set.next();
         generic_params.push_back(
-            set.expect(TokenType::IDENTIFIER, "Expected generic parameter name").get_lexeme()
+            std::string(set.get_lexeme(set.expect(TokenType::IDENTIFIER, "Expected generic parameter name")))
         );
 
         while (set.peek_next_eq(TokenType::COMMA))
         {
             set.next();
             generic_params.push_back(
-                set.expect(TokenType::IDENTIFIER, "Expected generic parameter name").get_lexeme()
+                std::string(set.get_lexeme(set.expect(TokenType::IDENTIFIER, "Expected generic parameter name")))
             );
         }
 
@@ -182,12 +351,12 @@ std::unique_ptr<IAstType> stride::ast::resolve_generics(
     return type->clone_ty();
 }
 
-std::unique_ptr<IAstType> stride::ast::instantiate_generic_type(
-    const AstAliasType* alias_type,
-    const definition::TypeDefinition* type_definition)
+static std::unique_ptr<IAstType> substitute_type_arguments(
+    const std::string& type_name,
+    const GenericTypeList& instantiated_types,
+    const definition::TypeDefinition* type_definition,
+    const SourceFragment& use_site)
 {
-
-    const auto& instantiated_types = alias_type->get_instantiated_generic_types();
     const auto& generic_param_names = type_definition->get_generics_parameters();
 
     const auto& base_type = type_definition->get_type();
@@ -201,26 +370,58 @@ std::unique_ptr<IAstType> stride::ast::instantiate_generic_type(
                 ErrorType::TYPE_ERROR,
                 std::format(
                     "Failed to resolve generic for type '{}': type is not generic",
-                    alias_type->get_name()
+                    type_name
                 ),
-                alias_type->get_source_fragment()
+                use_site
             );
         }
         throw parsing_error(
             ErrorType::TYPE_ERROR,
             std::format(
                 "Failed to instantiate generic type '{}': expected {} parameters, got {}",
-                alias_type->get_name(),
+                type_name,
                 generic_param_names.size(),
                 instantiated_types.size()
             ),
-            alias_type->get_source_fragment()
+            use_site
         );
     }
 
     return resolve_generics(base_type, generic_param_names, instantiated_types);
 }
 
+std::unique_ptr<IAstType> stride::ast::instantiate_generic_type(
+    const AstAliasType* alias_type,
+    const definition::TypeDefinition* type_definition)
+{
+    return substitute_type_arguments(
+        alias_type->get_name(),
+        alias_type->get_instantiated_generic_types(),
+        type_definition,
+        alias_type->get_source_fragment());
+}
+
+IAstType* stride::ast::get_generic_instantiation(
+    const definition::TypeDefinition* type_definition,
+    const std::string& type_name,
+    const GenericTypeList& type_arguments,
+    const SourceFragment& use_site
+)
+{
+    return type_definition->get_instantiations().get_or_instantiate(
+        type_arguments,
+        [&]
+        {
+            return AstAliasType::resolve_underlying_type(
+                substitute_type_arguments(type_name, type_arguments, type_definition, use_site),
+                type_name,
+                use_site);
+        },
+        type_name,
+        use_site
+    );
+}
+
 std::unique_ptr<AstObjectType> stride::ast::instantiate_generic_type(
     const AstObjectInitializer* object,
     AstObjectType* type,
@@ -0,0 +1,265 @@
+#include "ast/incremental.h"
+
+#include "errors.h"
+#include "ast/ast.h"
+#include "ast/parsing_context.h"
+#include "ast/nodes/blocks.h"
+#include "ast/tokens/tokenizer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+using namespace stride::ast;
+using namespace stride::ast::definition;
+
+namespace
+{
+    /// How many tokens past its end the parser may look at to decide where a statement ends,
+    /// e.g. to check for an `else` after an if-statement.
+    constexpr int64_t PARSER_LOOKAHEAD = 2;
+}
+
+IncrementalParser::IncrementalParser(std::shared_ptr<SourceFile> source) :
+    _source(std::move(source)),
+    _context(std::make_shared<ParsingContext>()) {}
+
+IncrementalParser::~IncrementalParser() = default;
+
+void IncrementalParser::reclaim_nodes()
+{
+    if (!this->_root)
+    {
+        return;
+    }
+
+    auto nodes = this->_root->release_children();
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        this->_statements[i].node = std::move(nodes[i]);
+    }
+
+    this->_root.reset();
+}
+
+void IncrementalParser::discard_statements()
+{
+    this->_root.reset();
+    this->_statements.clear();
+    this->_context = std::make_shared<ParsingContext>();
+}
+
+void IncrementalParser::parse()
+{
+    this->reclaim_nodes();
+    this->_context->discard_analysis();
+    this->parse_statements();
+}
+
+void IncrementalParser::parse_statements()
+{
+    if (!this->_tokens.has_value())
+    {
+        // Statements can't be mapped onto tokens that don't exist yet
+        this->discard_statements();
+        this->_tokens = tokenizer::tokenize(this->_source);
+    }
+
+    // The root context holds the definitions of every statement, in statement order
+    auto root_definitions = this->_context->take_symbols();
+    auto previous = std::exchange(this->_statements, {});
+
+    std::vector<std::vector<std::unique_ptr<IDefinition>>> previous_definitions;
+    previous_definitions.reserve(previous.size());
+
+    auto next_definition = std::make_move_iterator(root_definitions.begin());
+    for (const auto& statement : previous)
+    {
+        const auto end_definition = next_definition + static_cast<ptrdiff_t>(statement.definition_count);
+        previous_definitions.emplace_back(next_definition, end_definition);
+        next_definition = end_definition;
+    }
+
+    this->_reused_statement_count = 0;
+    this->_parsed_statement_count = 0;
+
+    auto set = this->_tokens.value();
+    size_t definition_count = 0;
+
+    // Once a reparsed statement has made definitions, reused definitions have to be checked against them
+    bool check_duplicates = false;
+
+    const auto parse_until = [&](const int64_t limit)
+    {
+        while (set.position() < limit && set.has_next())
+        {
+            const auto first_token = set.position();
+            const auto symbol_count = this->_context->get_symbol_count();
+
+            auto node = parse_next_statement(this->_context, set);
+            ++this->_parsed_statement_count;
+
+            if (!node)
+            {
+                continue;
+            }
+
+            const auto statement_definition_count = this->_context->get_symbol_count() - symbol_count;
+            check_duplicates |= statement_definition_count > 0;
+            definition_count += statement_definition_count;
+
+            this->_statements.push_back({
+                std::move(node),
+                first_token,
+                set.position(),
+                statement_definition_count
+            });
+        }
+    };
+
+    size_t index = 0;
+    try
+    {
+        for (; index < previous.size(); ++index)
+        {
+            auto& statement = previous[index];
+
+            parse_until(statement.first_token);
+
+            // Swallowed by a reparsed statement, e.g. after removing a closing brace
+            if (set.position() != statement.first_token)
+            {
+                continue;
+            }
+
+            this->_context->restore_symbols(std::move(previous_definitions[index]), check_duplicates);
+            definition_count += statement.definition_count;
+
+            set.skip(statement.end_token - statement.first_token);
+            this->_statements.push_back(std::move(statement));
+            ++this->_reused_statement_count;
+        }
+
+        parse_until(set.size());
+    }
+    catch (...)
+    {
+        // Drop the definitions the failing statement made before it failed
+        auto definitions = this->_context->take_symbols();
+        definitions.resize(definition_count);
+        this->_context->restore_symbols(std::move(definitions), false);
+
+        // Statements after the failure are kept, so that the next update only has to parse the gap
+        // before them. Ones that conflict with the definitions made so far are parsed again instead.
+        for (; index < previous.size(); ++index)
+        {
+            try
+            {
+                this->_context->restore_symbols(std::move(previous_definitions[index]), true);
+                this->_statements.push_back(std::move(previous[index]));
+            }
+            catch (const parsing_error&) {}
+        }
+
+        this->_context->mark_parsed();
+        throw;
+    }
+
+    this->_context->mark_parsed();
+
+    std::vector<std::unique_ptr<IAstNode>> nodes;
+    nodes.reserve(this->_statements.size());
+    for (auto& statement : this->_statements)
+    {
+        nodes.push_back(std::move(statement.node));
+    }
+
+    this->_root = std::make_unique<AstBlock>(
+        this->_tokens->peek_next().get_source_fragment(),
+        this->_context,
+        std::move(nodes));
+}
+
+void IncrementalParser::update(const SourceEdit& edit)
+{
+    auto source = apply_edit(*this->_source, edit);
+
+    // Reused statements keep referring to earlier revisions, whose lines follow the edit
+    this->_source->add_revision(*source, edit);
+
+    this->reclaim_nodes();
+    this->_context->discard_analysis();
+
+    if (this->_tokens.has_value())
+    {
+        try
+        {
+            const auto retokenized = tokenizer::retokenize(this->_tokens.value(), source, edit);
+
+            this->retain_statements(edit, retokenized);
+            this->_tokens = retokenized.tokens;
+        }
+        catch (const parsing_error&)
+        {
+            this->_source = std::move(source);
+            this->_tokens.reset();
+            this->discard_statements();
+            throw;
+        }
+    }
+
+    this->_source = std::move(source);
+    this->parse_statements();
+}
+
+void IncrementalParser::retain_statements(const SourceEdit& edit, const tokenizer::RetokenizedSet& retokenized)
+{
+    const auto previous_tokens = this->_tokens->get_tokens();
+    const std::string_view previous_text = this->_source->source;
+
+    // Statements are only reused if they don't share a line with the edit, so that their lines
+    // are either the same in every revision, or moved as a whole by the line breaks of the edit.
+    const auto previous_line_break = edit.offset == 0
+        ? std::string_view::npos
+        : previous_text.rfind('\n', edit.offset - 1);
+    const size_t edit_line_start = previous_line_break == std::string_view::npos ? 0 : previous_line_break + 1;
+    const size_t edit_line_end = std::min(previous_text.find('\n', edit.removed_end()), previous_text.size());
+
+    const auto token_shift = retokenized.damage_end - retokenized.previous_damage_end;
+
+    auto definitions = this->_context->take_symbols();
+    auto next_definition = std::make_move_iterator(definitions.begin());
+
+    std::vector<std::unique_ptr<IDefinition>> retained_definitions;
+    std::vector<Statement> retained;
+
+    for (auto& statement : this->_statements)
+    {
+        const auto first_definition = next_definition;
+        next_definition += static_cast<ptrdiff_t>(statement.definition_count);
+
+        const auto& last_token = previous_tokens[statement.end_token - 1];
+        const bool before_edit = statement.end_token + PARSER_LOOKAHEAD <= retokenized.damage_begin
+            && last_token.get_offset() + last_token.get_length() <= edit_line_start;
+
+        const bool after_edit = statement.first_token >= retokenized.previous_damage_end
+            && previous_tokens[statement.first_token].get_offset() > edit_line_end;
+
+        if (!before_edit && !after_edit)
+        {
+            continue;
+        }
+
+        if (after_edit)
+        {
+            statement.first_token += token_shift;
+            statement.end_token += token_shift;
+        }
+
+        std::copy(first_definition, next_definition, std::back_inserter(retained_definitions));
+        retained.push_back(std::move(statement));
+    }
+
+    this->_statements = std::move(retained);
+    this->_context->restore_symbols(std::move(retained_definitions), false);
+}
@@ -0,0 +1,136 @@
+#include "ast/interner.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace stride::ast;
+
+namespace
+{
+    /*
+     * Interned strings are stored in fixed-size chunks that are allocated on demand and never
+     * moved, so resolving an id is lock-free. The string -> id maps are sharded by hash, so that
+     * threads lexing and parsing different files rarely contend on the same lock. Once a name has
+     * been seen, interning it again only takes a shared lock.
+     */
+    constexpr size_t STORAGE_CHUNK_SIZE = 4096;
+    constexpr size_t STORAGE_MAX_CHUNKS = 16384;
+    constexpr size_t SHARD_COUNT = 64;
+
+    using StorageChunk = std::array<std::string, STORAGE_CHUNK_SIZE>;
+
+    struct Shard
+    {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string_view, InternedId> ids;
+    };
+
+    struct InternerState
+    {
+        std::array<std::atomic<StorageChunk*>, STORAGE_MAX_CHUNKS> storage_chunks{};
+        std::mutex storage_mutex;
+        InternedId storage_next_id = 0;
+
+        std::array<Shard, SHARD_COUNT> shards;
+
+        Shard& get_shard(const std::string_view value)
+        {
+            return this->shards[std::hash<std::string_view>{}(value) % SHARD_COUNT];
+        }
+
+        std::string& get_slot(const InternedId id)
+        {
+            return (*this->storage_chunks[id / STORAGE_CHUNK_SIZE].load(std::memory_order_acquire))
+                [id % STORAGE_CHUNK_SIZE];
+        }
+
+        InternedId store(const std::string_view value)
+        {
+            std::lock_guard lock(this->storage_mutex);
+
+            if (this->storage_next_id >= STORAGE_CHUNK_SIZE * STORAGE_MAX_CHUNKS)
+            {
+                throw std::runtime_error("Exceeded the maximum number of interned strings");
+            }
+
+            const auto id = this->storage_next_id++;
+
+            // Chunks live for the remainder of the process, as readers may hold on to them without locking.
+            auto& chunk = this->storage_chunks[id / STORAGE_CHUNK_SIZE];
+            if (chunk.load(std::memory_order_acquire) == nullptr)
+            {
+                chunk.store(new StorageChunk{}, std::memory_order_release);
+            }
+
+            this->get_slot(id) = std::string(value);
+            return id;
+        }
+
+        InternerState()
+        {
+            // The empty string is always interned first, so default-constructed handles refer to it.
+            const auto empty_id = this->store("");
+            this->get_shard("").ids.emplace(this->get_slot(empty_id), empty_id);
+        }
+    };
+
+    // Function-local, so interning is safe from static initializers in other translation units.
+    InternerState& state()
+    {
+        static InternerState instance;
+        return instance;
+    }
+}
+
+InternedId interner::intern(const std::string_view value)
+{
+    auto& instance = state();
+    auto& shard = instance.get_shard(value);
+
+    {
+        std::shared_lock lock(shard.mutex);
+        if (const auto it = shard.ids.find(value); it != shard.ids.end())
+        {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(shard.mutex);
+    if (const auto it = shard.ids.find(value); it != shard.ids.end())
+    {
+        return it->second;
+    }
+
+    const auto id = instance.store(value);
+    shard.ids.emplace(instance.get_slot(id), id);
+    return id;
+}
+
+std::optional<InternedId> interner::find(const std::string_view value)
+{
+    auto& shard = state().get_shard(value);
+
+    std::shared_lock lock(shard.mutex);
+    if (const auto it = shard.ids.find(value); it != shard.ids.end())
+    {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+const std::string& interner::resolve(const InternedId id)
+{
+    return state().get_slot(id);
+}
+
+size_t interner::size()
+{
+    auto& instance = state();
+
+    std::lock_guard lock(instance.storage_mutex);
+    return instance.storage_next_id;
+}
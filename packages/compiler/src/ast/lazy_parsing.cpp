@@ -0,0 +1,129 @@
+#include "ast/ast.h"
+
+#include "ast/casting.h"
+#include "ast/modifiers.h"
+#include "ast/symbols.h"
+#include "ast/nodes/blocks.h"
+#include "ast/nodes/expression.h"
+#include "ast/nodes/function_declaration.h"
+#include "ast/nodes/traversal.h"
+
+#include <ranges>
+#include <string_view>
+#include <unordered_map>
+
+using namespace stride::ast;
+
+namespace
+{
+    thread_local bool defer_function_bodies = false;
+
+    /// Name that functions and references to them are matched by. References may be qualified,
+    /// like <code>Math::cos</code>, so only the last segment is used.
+    std::string_view reference_key(const std::string_view name)
+    {
+        if (const auto delimiter = name.rfind(DELIMITER); delimiter != std::string_view::npos)
+        {
+            return name.substr(delimiter + std::string_view(DELIMITER).size());
+        }
+
+        return name;
+    }
+
+    /// Collects the names that are referred to, and the functions whose body is deferred
+    class ReferenceVisitor : public IVisitor
+    {
+    public:
+        std::vector<std::string> references;
+        std::vector<IAstFunction*> deferred_functions;
+
+        void accept(IAstExpression* expr) override
+        {
+            if (const auto* identifier = cast_expr<AstIdentifier*>(expr))
+            {
+                this->references.push_back(identifier->get_name());
+            }
+            else if (const auto* call = cast_expr<AstFunctionCall*>(expr))
+            {
+                this->references.push_back(call->get_function_name());
+            }
+        }
+
+        void accept(IAstFunction* function) override
+        {
+            if (function->has_deferred_body())
+            {
+                this->deferred_functions.push_back(function);
+            }
+        }
+    };
+}
+
+LazyParsingScope::LazyParsingScope(const bool enabled) :
+    _previous(defer_function_bodies)
+{
+    defer_function_bodies = enabled;
+}
+
+LazyParsingScope::~LazyParsingScope()
+{
+    defer_function_bodies = this->_previous;
+}
+
+bool LazyParsingScope::is_active()
+{
+    return defer_function_bodies;
+}
+
+size_t Ast::parse_reachable_functions() const
+{
+    AstNodeTraverser traverser;
+    ReferenceVisitor visitor;
+
+    for (const auto& node : this->_files | std::views::values)
+    {
+        traverser.visit_block(&visitor, node.get());
+    }
+
+    std::unordered_map<std::string_view, std::vector<IAstFunction*>> deferred_by_name;
+    for (auto* function : visitor.deferred_functions)
+    {
+        deferred_by_name[reference_key(function->get_function_name())].push_back(function);
+
+        if (function->get_function_name() == "main"
+            || function->get_visibility() == VisibilityModifier::PUBLIC)
+        {
+            visitor.references.push_back(function->get_function_name());
+        }
+    }
+
+    // Bodies are parsed on this thread, so they mustn't be deferred again
+    const LazyParsingScope eager_scope(false);
+    AstArena::Scope arena_scope(*this->_arena);
+
+    size_t parsed_count = 0;
+    while (!visitor.references.empty())
+    {
+        const auto name = std::move(visitor.references.back());
+        visitor.references.pop_back();
+
+        const auto functions = deferred_by_name.find(reference_key(name));
+        if (functions == deferred_by_name.end())
+        {
+            continue;
+        }
+
+        // Taken out of the map first, the body may refer to the function itself
+        const auto overloads = std::move(functions->second);
+        deferred_by_name.erase(functions);
+
+        for (auto* function : overloads)
+        {
+            function->parse_deferred_body();
+            traverser.visit_block(&visitor, function->get_body());
+            ++parsed_count;
+        }
+    }
+
+    return parsed_count;
+}
@@ -54,6 +54,24 @@ std::optional<TokenSet> stride::ast::collect_block_variant(
     const TokenType end_token)
 {
     set.expect(start_token);
+
+    // Bracket pairs are matched up front by the token set, so we can skip to the end directly.
+    if (const auto closing = set.find_closing_bracket(set.position() - 1); closing >= 0
+        && set.at(closing).get_type() == end_token)
+    {
+        const auto final_pos = set.position();
+        const auto offset = closing - final_pos;
+
+        set.skip(offset + 1);
+
+        if (offset == 0)
+        {
+            return std::nullopt;
+        }
+
+        return set.create_subset(final_pos, offset);
+    }
+
     for (int64_t level = 1, offset = 0;
          level > 0 && offset < set.size();
          ++offset)
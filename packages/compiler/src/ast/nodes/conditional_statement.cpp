@@ -24,7 +24,7 @@ std::unique_ptr<AstBlock> parse_else_optional(
     }
 
     const auto reference_token = set.next();
-    const auto else_block_context = std::make_shared<ParsingContext>(
+    const auto else_block_context = make_context(
         context,
         context->get_context_type()
     );
@@ -33,7 +33,7 @@ std::unique_ptr<AstBlock> parse_else_optional(
     // have to parse_file the block separately
     if (set.peek_next_eq(TokenType::LBRACE))
     {
-        const auto else_context = std::make_shared<ParsingContext>(
+        const auto else_context = make_context(
             context,
             context->get_context_type());
         return parse_block(else_context, set);
@@ -57,7 +57,7 @@ std::unique_ptr<AstConditionalStatement> stride::ast::parse_if_statement(
 {
     const auto reference_token = set.expect(TokenType::KEYWORD_IF);
 
-    auto conditional_context = std::make_shared<ParsingContext>(
+    auto conditional_context = make_context(
         context,
         context->get_context_type());
     auto if_header_body = collect_parenthesized_block(set);
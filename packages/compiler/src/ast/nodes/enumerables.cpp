@@ -22,7 +22,7 @@ std::unique_ptr<AstEnumerableMember> stride::ast::parse_enumerable_member(
 )
 {
     const auto member_name_tok = set.expect(TokenType::IDENTIFIER);
-    auto member_sym = member_name_tok.get_lexeme();
+    auto member_sym = std::string(set.get_lexeme(member_name_tok));
 
     context->define_symbol(
         Symbol(
@@ -71,7 +71,7 @@ std::unique_ptr<AstEnumerable> stride::ast::parse_enumerable_declaration(
 )
 {
     const auto reference_token = set.expect(TokenType::KEYWORD_ENUM);
-    const auto enumerable_name = set.expect(TokenType::IDENTIFIER).get_lexeme();
+    const auto enumerable_name = std::string(set.get_lexeme(set.expect(TokenType::IDENTIFIER)));
 
     context->define_symbol(
         Symbol(reference_token.get_source_fragment(),
@@ -84,7 +84,7 @@ std::unique_ptr<AstEnumerable> stride::ast::parse_enumerable_declaration(
 
     std::vector<std::unique_ptr<AstEnumerableMember>> members;
 
-    auto enum_definition_context = std::make_shared<ParsingContext>(
+    auto enum_definition_context = make_context(
         context,
         context->get_context_type());
 
@@ -28,24 +28,6 @@ std::optional<BinaryOpType> stride::ast::get_binary_op_type(
     }
 }
 
-int stride::ast::get_binary_operator_precedence(const BinaryOpType type)
-{
-    switch (type)
-    {
-    case BinaryOpType::POWER:
-        return 3;
-    case BinaryOpType::MULTIPLY:
-    case BinaryOpType::DIVIDE:
-    case BinaryOpType::MODULO:
-        return 2;
-    case BinaryOpType::ADD:
-    case BinaryOpType::SUBTRACT:
-        return 1;
-    default:
-        return 0;
-    }
-}
-
 std::string binary_op_to_str(const BinaryOpType op)
 {
     switch (op)
@@ -75,101 +57,103 @@ std::string AstBinaryArithmeticOp::to_string()
 }
 
 /**
- * This parses expressions that requires precedence, such as binary expressions.
- * These are binary expressions, e.g., 1 + 1, 1 - 1, 1 * 1, 1 / 1, 1 % 1
+ * Builds the node for the binary operator <code>operator_token</code>. The operator must be a
+ * binary arithmetic, comparison or logical operator.
  */
-std::optional<std::unique_ptr<IAstExpression>>
-stride::ast::parse_arithmetic_binary_operation_optional(
+static std::unique_ptr<IAstExpression> make_binary_expression(
     const std::shared_ptr<ParsingContext>& context,
-    TokenSet& set,
+    const Token& operator_token,
     std::unique_ptr<IAstExpression> lhs,
-    const int min_precedence
+    std::unique_ptr<IAstExpression> rhs
 )
 {
-    const size_t starting_offset = lhs->get_source_fragment().offset;
-    int recursion_depth = 0;
+    const auto type = operator_token.get_type();
 
-    while (set.has_next())
+    if (const auto binary_op = get_binary_op_type(type); binary_op.has_value())
     {
-        const auto reference_token = set.peek_next();
-        // First, we'll check if the next token is a binary operator
-        if (auto binary_op = get_binary_op_type(reference_token.get_type());
-            binary_op.has_value())
-        {
-            const auto op = binary_op.value();
+        const auto source_fragment = stride::SourceFragment::combine(
+            lhs->get_source_fragment(),
+            rhs->get_source_fragment()
+        );
 
-            const int precedence = get_binary_operator_precedence(op);
+        return std::make_unique<AstBinaryArithmeticOp>(
+            source_fragment,
+            context,
+            std::move(lhs),
+            binary_op.value(),
+            std::move(rhs)
+        );
+    }
 
-            // If the precedence is lower than the minimum required, we return the lhs
-            if (precedence < min_precedence)
-            {
-                return lhs;
-            }
+    if (const auto comparative_op = get_comparative_op_type(type); comparative_op.has_value())
+    {
+        return std::make_unique<AstComparisonOp>(
+            operator_token.get_source_fragment(),
+            context,
+            std::move(lhs),
+            comparative_op.value(),
+            std::move(rhs)
+        );
+    }
 
-            set.next();
+    return std::make_unique<AstLogicalOp>(
+        operator_token.get_source_fragment(),
+        context,
+        std::move(lhs),
+        get_logical_op_type(type).value(),
+        std::move(rhs)
+    );
+}
 
-            // If we're unable to parse the next expression part, for whatever reason,
-            // we'll return nullopt. This will indicate that the expression is incomplete or
-            // invalid.
-            auto rhs_opt_val = parse_binary_unary_op(context, set);
-            if (!rhs_opt_val)
-            {
-                return std::nullopt;
-            }
-            auto rhs = std::move(rhs_opt_val.value());
+/**
+ * Parses binary arithmetic, comparison, logical and type cast expressions in a single pass,
+ * using precedence climbing over <code>operatorPrecedence</code>.
+ * Only operators with a precedence of at least <code>min_precedence</code> are consumed;
+ * operators binding looser are left for the caller, which parses them at its own level.
+ */
+std::unique_ptr<IAstExpression> stride::ast::parse_binary_expression(
+    const std::shared_ptr<ParsingContext>& context,
+    TokenSet& set,
+    const int min_precedence
+)
+{
+    auto lhs_opt = parse_binary_unary_op(context, set);
+    if (!lhs_opt)
+    {
+        set.throw_error("Expected expression");
+    }
+    auto lhs = std::move(lhs_opt.value());
 
-            // If the followup token is also a binary expression,
-            // we can try to parse it with higher precedence
-            if (const auto next_op = get_binary_op_type(set.peek_next_type());
-                next_op.has_value())
-            {
-                if (const int next_precedence = get_binary_operator_precedence(
-                        next_op.value());
-                    precedence < next_precedence)
-                {
-                    auto rhs_opt = parse_arithmetic_binary_operation_optional(
-                        context,
-                        set,
-                        std::move(rhs),
-                        precedence + 1
-                    );
-                    if (rhs_opt.has_value())
-                    {
-                        rhs = std::move(rhs_opt.value());
-                    }
-                    else
-                    {
-                        // We're unable to parse the next expression part, which is required for a
-                        // binary operation.
-                        return std::nullopt;
-                    }
-                }
-            }
+    while (set.has_next())
+    {
+        const auto [precedence, right_associative] = get_operator_precedence(set.peek_next_type());
 
-            const auto& rhs_pos = rhs->get_source_fragment();
-            lhs = std::make_unique<AstBinaryArithmeticOp>(
-                SourceFragment(
-                    set.get_source(),
-                    starting_offset,
-                    rhs_pos.offset + rhs_pos.length - starting_offset
-                ),
-                context,
-                std::move(lhs),
-                binary_op.value(),
-                std::move(rhs)
-            );
-        }
-        else
+        // Either not an infix operator, or one that binds looser than this level
+        if (precedence == 0 || precedence < min_precedence)
         {
-            return lhs;
+            break;
         }
 
-        if (++recursion_depth > MAX_RECURSION_DEPTH)
+        // Casts are postfix, their right-hand side is a type rather than an expression
+        if (set.peek_next_eq(TokenType::KEYWORD_AS))
         {
-            set.throw_error(
-                "Maximum recursion depth exceeded when parsing binary arithmetic expression");
+            lhs = parse_type_cast_op(context, set, std::move(lhs));
+            continue;
         }
+
+        const auto operator_token = set.next();
+
+        // Operands of left-associative operators may only contain tighter binding operators,
+        // so `a - b - c` is parsed as `(a - b) - c`
+        auto rhs = parse_binary_expression(
+            context,
+            set,
+            right_associative ? precedence : precedence + 1
+        );
+
+        lhs = make_binary_expression(context, operator_token, std::move(lhs), std::move(rhs));
     }
+
     return lhs;
 }
 
@@ -48,7 +48,6 @@ std::unique_ptr<IAstExpression> stride::ast::parse_inline_expression_part(
     // Could either be a function call, or object/array access
     else if (set.peek_next_eq(TokenType::IDENTIFIER))
     {
-        const auto reference_token = set.peek_next();
         // Mangled name including module, e.g., `Math__PI`
         auto identifier = parse_segmented_identifier(
             context,
@@ -138,143 +137,6 @@ std::unique_ptr<IAstExpression> stride::ast::parse_inline_expression_part(
     return result;
 }
 
-/*
- * Helper functions for tiered expression parsing to ensure correct precedence.
- * Hierarchy: Logical > Comparison > Arithmetic > Unary > Atom
- */
-
-std::unique_ptr<IAstExpression> parse_arithmetic_tier(
-    const std::shared_ptr<ParsingContext>& context,
-    TokenSet& set
-)
-{
-    // 1. Term (Unary / Primary)
-    auto lhs_opt = parse_binary_unary_op(context, set);
-    if (!lhs_opt)
-    {
-        set.throw_error("Expected expression");
-    }
-    auto lhs = std::move(lhs_opt.value());
-
-    // Highest precedence: Type Cast (as)
-    while (auto cast_expr = parse_type_cast_op(context, set, lhs.get()))
-    {
-        lhs = std::move(cast_expr.value());
-    }
-
-    // 2. Arithmetic Loop (handled by parse_arithmetic_binary_operation_optional)
-    if (auto arith = parse_arithmetic_binary_operation_optional(
-        context,
-        set,
-        std::move(lhs),
-        1)
-    )
-    {
-        return std::move(arith.value());
-    }
-    return lhs;
-}
-
-std::unique_ptr<IAstExpression> parse_comparison_tier(
-    const std::shared_ptr<ParsingContext>& context,
-    TokenSet& set
-)
-{
-    auto lhs = parse_arithmetic_tier(context, set);
-
-    while (auto op = get_comparative_op_type(set.peek_next_type()))
-    {
-        const auto token = set.next();
-        auto rhs = parse_arithmetic_tier(context, set);
-        lhs = std::make_unique<AstComparisonOp>(
-            token.get_source_fragment(),
-            context,
-            std::move(lhs),
-            op.value(),
-            std::move(rhs)
-        );
-    }
-    return lhs;
-}
-
-std::unique_ptr<IAstExpression> parse_logical_tier(
-    const std::shared_ptr<ParsingContext>& context,
-    TokenSet& set
-)
-{
-    auto lhs = parse_comparison_tier(context, set);
-
-    while (auto op = get_logical_op_type(set.peek_next_type()))
-    {
-        const auto token = set.next();
-        auto rhs = parse_comparison_tier(context, set);
-        lhs = std::make_unique<AstLogicalOp>(
-            token.get_source_fragment(),
-            context,
-            std::move(lhs),
-            op.value(),
-            std::move(rhs)
-        );
-    }
-    return lhs;
-}
-
-// Kept for backward compatibility / external usage if any, but now updated to use correct tiers for
-// RHS
-std::optional<std::unique_ptr<IAstExpression>> parse_logical_operation_optional(
-    const std::shared_ptr<ParsingContext>& context,
-    TokenSet& set,
-    std::unique_ptr<IAstExpression> lhs)
-{
-    const auto reference_token = set.peek_next();
-
-    if (auto logical_op = get_logical_op_type(reference_token.get_type());
-        logical_op.has_value())
-    {
-        set.next();
-
-        auto rhs = parse_comparison_tier(context, set);
-        // Note: calling parse_comparison_tier here is safer than parse_inline_expression_part
-
-        return std::make_unique<AstLogicalOp>(
-            reference_token.get_source_fragment(),
-            context,
-            std::move(lhs),
-            logical_op.value(),
-            std::move(rhs));
-    }
-
-    return lhs;
-}
-
-// Kept for backward compatibility / external usage if any
-std::optional<std::unique_ptr<IAstExpression>> parse_comparative_operation_optional(
-    const std::shared_ptr<ParsingContext>& context,
-    TokenSet& set,
-    std::unique_ptr<IAstExpression> lhs)
-{
-    const auto reference_token = set.peek_next();
-
-    if (auto comparative_op = get_comparative_op_type(
-            reference_token.get_type());
-        comparative_op.has_value())
-    {
-        set.next();
-
-        auto rhs = parse_arithmetic_tier(context, set);
-
-        return std::make_unique<AstComparisonOp>(
-            reference_token.get_source_fragment(),
-            context,
-            std::move(lhs),
-            comparative_op.value(),
-            std::move(rhs)
-        );
-    }
-
-    return lhs;
-}
-
 std::unique_ptr<IAstExpression> parse_expression_internal(
     const std::shared_ptr<ParsingContext>& context,
     TokenSet& set
@@ -285,7 +147,7 @@ std::unique_ptr<IAstExpression> parse_expression_internal(
         set.throw_error("Unexpected end of input while parsing expression");
     }
 
-    return parse_logical_tier(context, set);
+    return parse_binary_expression(context, set, 1);
 }
 
 /**
@@ -319,7 +181,7 @@ std::unique_ptr<AstIdentifier> stride::ast::parse_segmented_identifier(
     std::vector<std::string> segments;
 
     const auto initial_identifier = set.expect(TokenType::IDENTIFIER, error_message);
-    segments.push_back(initial_identifier.get_lexeme());
+    segments.emplace_back(set.get_lexeme(initial_identifier));
 
     std::optional<SourceFragment> last_fragment = std::nullopt;
 
@@ -331,7 +193,7 @@ std::unique_ptr<AstIdentifier> stride::ast::parse_segmented_identifier(
             TokenType::IDENTIFIER,
             error_message
         );
-        segments.push_back(subseq_iden.get_lexeme());
+        segments.emplace_back(set.get_lexeme(subseq_iden));
         last_fragment = subseq_iden.get_source_fragment();
     }
 
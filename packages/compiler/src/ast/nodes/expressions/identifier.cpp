@@ -33,6 +33,79 @@ std::optional<const definition::IDefinition*> AstIdentifier::get_definition() co
     return std::nullopt;
 }
 
+/// Files are lowered into modules of their own, so functions of other files are declared where they're referred to
+static llvm::Function* declare_function(const definition::IDefinition* definition, llvm::Module* module)
+{
+    const auto* function_definition = dynamic_cast<const definition::FunctionDefinition*>(definition);
+    if (function_definition == nullptr)
+    {
+        return nullptr;
+    }
+
+    const auto* function_type = function_definition->get_type();
+    std::vector<llvm::Type*> parameter_types;
+    parameter_types.reserve(function_type->get_parameter_types().size());
+
+    for (const auto& parameter : function_type->get_parameter_types())
+    {
+        parameter_types.push_back(parameter->get_llvm_type(module));
+    }
+
+    llvm::FunctionType* llvm_function_type = llvm::FunctionType::get(
+        function_type->get_return_type()->get_llvm_type(module),
+        parameter_types,
+        function_definition->is_variadic()
+    );
+
+    auto callee = module->getOrInsertFunction(
+        function_definition->get_internal_symbol_name(),
+        llvm_function_type
+    );
+
+    return llvm::dyn_cast<llvm::Function>(callee.getCallee());
+}
+
+/// Global variables of other files are likewise declared as external globals where they're referred to.
+/// Variables of local scopes are never declared this way, these have to be found among the locals.
+static llvm::GlobalVariable* declare_global(
+    const ParsingContext* context,
+    const definition::IDefinition* definition,
+    llvm::Module* module
+)
+{
+    const auto* field_definition = dynamic_cast<const definition::FieldDefinition*>(definition);
+    if (field_definition == nullptr || field_definition->get_type() == nullptr)
+    {
+        return nullptr;
+    }
+
+    const auto& internal_name = field_definition->get_internal_symbol_name();
+    while (context != nullptr && context->get_variable_def(internal_name) != field_definition)
+    {
+        context = context->get_parent_context().get();
+    }
+
+    if (context == nullptr || !context->is_global_scope())
+    {
+        return nullptr;
+    }
+
+    llvm::Type* global_type = field_definition->get_type()->get_llvm_type(module);
+    if (global_type == nullptr)
+    {
+        return nullptr;
+    }
+
+    return new llvm::GlobalVariable(
+        *module,
+        global_type,
+        !field_definition->get_type()->is_mutable(),
+        llvm::GlobalValue::ExternalLinkage,
+        nullptr,
+        internal_name
+    );
+}
+
 llvm::Value* AstIdentifier::codegen(
     llvm::Module* module,
     llvm::IRBuilderBase* builder
@@ -73,7 +146,18 @@ llvm::Value* AstIdentifier::codegen(
                     return fn;
                 }
 
-                if (auto* global = module->getNamedGlobal(internal_name))
+                if (auto* fn = declare_function(definition.value(), module))
+                {
+                    return fn;
+                }
+
+                auto* global = module->getNamedGlobal(internal_name);
+                if (global == nullptr)
+                {
+                    global = declare_global(this->get_context().get(), definition.value(), module);
+                }
+
+                if (global != nullptr)
                 {
                     return builder->CreateLoad(
                         global->getValueType(),
@@ -115,7 +199,13 @@ llvm::Value* AstIdentifier::codegen(
         );
     }
 
-    if (const auto global = module->getNamedGlobal(internal_name))
+    auto* global = module->getNamedGlobal(internal_name);
+    if (global == nullptr && module->getFunction(internal_name) == nullptr)
+    {
+        global = declare_global(this->get_context().get(), definition.value(), module);
+    }
+
+    if (global != nullptr)
     {
         // Only generate a Load instruction if we are inside a BasicBlock (Function context).
         if (builder->GetInsertBlock())
@@ -137,6 +227,11 @@ llvm::Value* AstIdentifier::codegen(
         return function;
     }
 
+    if (auto* function = declare_function(definition.value(), module))
+    {
+        return function;
+    }
+
     throw parsing_error(
         ErrorType::REFERENCE_ERROR,
         std::format("Identifier '{}' not found in this scope", this->get_name()),
@@ -32,7 +32,7 @@ std::unique_ptr<AstChainedExpression> stride::ast::parse_chained_member_access(
 
     auto member_id = std::make_unique<AstIdentifier>(
         context,
-        Symbol(member_tok.get_source_fragment(), member_tok.get_lexeme())
+        Symbol(member_tok.get_source_fragment(), std::string(set.get_lexeme(member_tok)))
     );
 
     const auto source = SourceFragment::combine(lhs->get_source_fragment(), member_tok.get_source_fragment());
@@ -301,7 +301,7 @@ llvm::Value* AstIndirectCall::codegen(
         callee_ast_type = alias_ty->get_underlying_type()->clone_ty();
     }
 
-    const auto* fn_type = dynamic_cast<AstFunctionType*>(callee_ast_type.get());
+    const auto* fn_type = cast_type<AstFunctionType*>(callee_ast_type.get());
     if (!fn_type)
     {
         throw parsing_error(
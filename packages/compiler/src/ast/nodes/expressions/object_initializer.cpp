@@ -13,6 +13,24 @@
 
 using namespace stride::ast;
 
+/// Whether <code>type</code> can't occur in a generic argument list, so a `<` before it must be a
+/// comparison. Ends the lookahead for a closing `>` early, instead of scanning the rest of the expression.
+static bool ends_generic_argument_list(const TokenType type)
+{
+    switch (type)
+    {
+    case TokenType::LT:
+    case TokenType::GT:
+    case TokenType::STAR: // Pointer types
+        return false;
+    case TokenType::SEMICOLON:
+    case TokenType::EQUALS:
+        return true;
+    default:
+        return is_literal(type) || get_operator_precedence(type).precedence > 0;
+    }
+}
+
 bool stride::ast::is_struct_initializer(const TokenSet& set)
 {
     int64_t i = 0;
@@ -39,10 +57,9 @@ bool stride::ast::is_struct_initializer(const TokenSet& set)
                 --depth;
             }
 
-
             ++i;
-            // Ran out of tokens before the generic list closed
-            if (set.at(i).get_type() == TokenType::END_OF_FILE && depth > 0)
+            // Ran out of tokens before the generic list closed, or it can't be one
+            if (depth > 0 && (set.peek_eq(TokenType::END_OF_FILE, i) || ends_generic_argument_list(set.peek(i).get_type())))
             {
                 return false;
             }
@@ -60,31 +77,34 @@ StructMemberInitializerPair parse_object_member_initializer(
 )
 {
     const auto member_iden = set.expect(TokenType::IDENTIFIER, "Expected identifier in struct initializer");
+    const auto member_name = std::string(set.get_lexeme(member_iden));
 
     // Implicit reference to another variable with the same name as the member
     if (!set.has_next() || set.peek_next_eq(TokenType::COMMA))
     {
         auto member_symbol = Symbol(
             member_iden.get_source_fragment(),
-            member_iden.get_lexeme()
+            member_name
         );
-        return { member_iden.get_lexeme(), std::make_unique<AstIdentifier>(context, member_symbol) };
+        return { member_name, std::make_unique<AstIdentifier>(context, member_symbol) };
     }
 
     set.expect(TokenType::COLON, "Expected ':' after identifier in struct initializer");
 
     auto member_expr = parse_inline_expression(context, set);
 
-    return { member_iden.get_lexeme(), std::move(member_expr) };
+    return { member_name, std::move(member_expr) };
 }
 
 
-std::unique_ptr<AstObjectType> AstObjectInitializer::get_instantiated_object_type()
+AstObjectType* AstObjectInitializer::get_instantiated_object_type()
 {
-    if (this->_object_type != nullptr)
+    if (this->_object_type != nullptr
+        && (this->_owned_object_type != nullptr || this->_instantiation_generation == get_analysis_generation()))
     {
-        return this->_object_type->clone_as<AstObjectType>();
+        return this->_object_type;
     }
+    this->_object_type = nullptr;
 
     const auto type_def = this->get_context()->get_type_definition(this->_object_type_name);
 
@@ -115,11 +135,28 @@ std::unique_ptr<AstObjectType> AstObjectInitializer::get_instantiated_object_typ
 
     if (const auto* object_def = cast_type<AstObjectType*>(type_def.value()->get_type()))
     {
-        auto resolved_type = instantiate_generic_type(this, const_cast<AstObjectType*>(object_def), type_def.value());
+        // Generic instantiations are shared by all uses with the same type arguments
+        if (this->has_generic_type_arguments() && type_def.value()->is_generic())
+        {
+            this->_instantiation_generation = get_analysis_generation();
+            this->_object_type = cast_type<AstObjectType*>(
+                get_generic_instantiation(
+                    type_def.value(),
+                    this->_object_type_name,
+                    this->_generic_type_arguments,
+                    this->get_source_fragment()));
+        }
 
-        this->_object_type = std::move(resolved_type);
+        if (this->_object_type == nullptr)
+        {
+            this->_owned_object_type = instantiate_generic_type(
+                this,
+                const_cast<AstObjectType*>(object_def),
+                type_def.value());
+            this->_object_type = this->_owned_object_type.get();
+        }
 
-        return this->_object_type->clone_as<AstObjectType>();
+        return this->_object_type;
     }
 
     if (auto* alias_def = cast_type<AstAliasType*>(type_def.value()->get_type()))
@@ -128,11 +165,10 @@ std::unique_ptr<AstObjectType> AstObjectInitializer::get_instantiated_object_typ
 
         if (auto* object_def = cast_type<AstObjectType*>(underlying_type))
         {
-            auto resolved_type = instantiate_generic_type(this, object_def, type_def.value());
-
-            this->_object_type = std::move(resolved_type);
+            this->_owned_object_type = instantiate_generic_type(this, object_def, type_def.value());
+            this->_object_type = this->_owned_object_type.get();
 
-            return this->_object_type->clone_as<AstObjectType>();
+            return this->_object_type;
         }
     }
 
@@ -185,7 +221,7 @@ std::unique_ptr<AstObjectInitializer> stride::ast::parse_object_initializer(
     return std::make_unique<AstObjectInitializer>(
         reference_token.get_source_fragment(),
         context,
-        reference_token.get_lexeme(),
+        std::string(set.get_lexeme(reference_token)),
         std::move(member_map),
         std::move(generic_types)
     );
@@ -6,16 +6,13 @@
 
 using namespace stride::ast;
 
-std::optional<std::unique_ptr<IAstExpression>> stride::ast::parse_type_cast_op(
+std::unique_ptr<IAstExpression> stride::ast::parse_type_cast_op(
     const std::shared_ptr<ParsingContext>& context,
     TokenSet& set,
-    IAstExpression* lhs
+    std::unique_ptr<IAstExpression> lhs
 )
 {
-    if (!set.peek_next_eq(TokenType::KEYWORD_AS))
-        return std::nullopt;
-
-    set.next();
+    set.expect(TokenType::KEYWORD_AS, "Expected 'as' in type cast operation");
 
     auto type = parse_type(context, set, { "Expected type after 'as' in type cast operation" });
 
@@ -24,7 +21,7 @@ std::optional<std::unique_ptr<IAstExpression>> stride::ast::parse_type_cast_op(
     return std::make_unique<AstTypeCastOp>(
         source_fragment,
         context,
-        lhs->clone_as<IAstExpression>(),
+        std::move(lhs),
         std::move(type)
     );
 }
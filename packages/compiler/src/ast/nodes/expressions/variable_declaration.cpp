@@ -55,10 +55,9 @@ std::unique_ptr<AstVariableDeclaration> stride::ast::parse_variable_declaration_
         set.expect(TokenType::KEYWORD_CONST);
     }
 
-    const std::string variable_name =
-        set
-       .expect(TokenType::IDENTIFIER, "Expected variable name in variable declaration")
-       .get_lexeme();
+    const auto variable_name = std::string(
+        set.get_lexeme(
+            set.expect(TokenType::IDENTIFIER, "Expected variable name in variable declaration")));
 
     std::optional<std::unique_ptr<IAstType>> variable_type = std::nullopt;
     std::unique_ptr<IAstExpression> value = nullptr;
@@ -131,10 +130,9 @@ std::unique_ptr<AstVariableDeclaration> stride::ast::parse_variable_declaration_
         var_type_pos.offset + var_type_pos.length - ref_tok_pos.offset
     );
 
-    static int var_unique_counter = 0;
     const auto internal_name = context->is_global_scope()
         ? variable_name
-        : std::format("{}.{}", variable_name, var_unique_counter++);
+        : std::format("{}.{}", variable_name, next_unique_symbol_id());
 
     auto symbol = Symbol(
         symbol_position,
@@ -327,7 +327,7 @@ std::optional<std::unique_ptr<IAstNode>> AstVariableReassignment::reduce()
 
     const auto reduced = this->_value->reduce();
 
-    if (auto* reduced_expr = dynamic_cast<IAstExpression*>(reduced.value().get()))
+    if (auto* reduced_expr = cast_ast<IAstExpression*>(reduced.value().get()))
     {
         return std::make_unique<AstVariableReassignment>(
             this->get_source_fragment(),
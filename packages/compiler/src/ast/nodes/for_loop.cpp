@@ -71,7 +71,7 @@ std::unique_ptr<AstForLoop> stride::ast::parse_for_loop_statement(
     }
 
     auto header_body = header_body_opt.value();
-    const auto for_body_context = std::make_shared<ParsingContext>(
+    const auto for_body_context = make_context(
         context,
         ContextType::CONTROL_FLOW);
 
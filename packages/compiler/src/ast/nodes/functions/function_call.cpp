@@ -116,7 +116,7 @@ std::string AstFunctionCall::format_suggestion(const IDefinition* suggestion)
             arg_types.push_back(primitive_type_to_str(PrimitiveType::VOID));
 
         return std::format("{}({})",
-                           fn_call->get_symbol().name,
+                           fn_call->get_symbol().name.str(),
                            join(arg_types, ", "));
     }
 
@@ -361,7 +361,7 @@ llvm::Value* AstFunctionCall::codegen_anonymous_function_call(
             base_type = alias_ty->get_underlying_type()->clone_ty();
         }
 
-        if (const auto* fn_type = dynamic_cast<AstFunctionType*>(base_type.get()))
+        if (const auto* fn_type = cast_type<AstFunctionType*>(base_type.get()))
         {
             // First: check if the variable's internal name maps to a named function in the
             // symbol table with a matching type signature. If so, call it directly without
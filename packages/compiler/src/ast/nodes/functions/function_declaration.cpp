@@ -27,6 +27,36 @@
 using namespace stride::ast;
 using namespace stride::ast::definition;
 
+/**
+ * Whether the body of a function at the cursor of <code>set</code> can be skipped for now. Only
+ * top-level and module functions are deferred, as those are the ones that can be looked up by name.
+ * Generic functions are instantiated from their body, so these are always parsed right away.
+ */
+static bool is_deferrable_function(
+    const std::shared_ptr<ParsingContext>& context,
+    const TokenSet& set,
+    const GenericParameterList& generic_parameters
+)
+{
+    if (!LazyParsingScope::is_active() || !generic_parameters.empty())
+    {
+        return false;
+    }
+
+    if (context->get_context_type() != ContextType::GLOBAL
+        && context->get_context_type() != ContextType::MODULE)
+    {
+        return false;
+    }
+
+    // Malformed bodies are parsed right away, which reports the error
+    const auto closing_brace = set.find_closing_bracket(set.position());
+
+    return set.peek_next_eq(TokenType::LBRACE)
+        && closing_brace >= 0
+        && set.at(closing_brace).get_type() == TokenType::RBRACE;
+}
+
 /**
  * Will attempt to parse the provided token stream into an AstFunctionDefinitionNode.
  */
@@ -53,9 +83,9 @@ std::unique_ptr<AstFunctionDeclaration> stride::ast::parse_fn_declaration(
 
     // Here we expect to receive the function name
     const auto fn_name_tok = set.expect(TokenType::IDENTIFIER, "Expected function name");
-    const auto& fn_name = fn_name_tok.get_lexeme();
+    const auto fn_name = std::string(set.get_lexeme(fn_name_tok));
 
-    auto function_context = std::make_shared<ParsingContext>(context, ContextType::FUNCTION);
+    auto function_context = make_context(context, ContextType::FUNCTION);
 
     GenericParameterList generic_parameter_names = parse_generic_declaration(set);
 
@@ -85,18 +115,26 @@ std::unique_ptr<AstFunctionDeclaration> stride::ast::parse_fn_declaration(
     auto sym_function_name = Symbol(position, context->get_name(), fn_name);
 
     std::unique_ptr<AstBlock> body = nullptr;
+    std::optional<TokenSet> deferred_body = std::nullopt;
 
     if (function_flags & SRFLAG_FN_TYPE_EXTERN)
     {
         set.expect(TokenType::SEMICOLON, "Expected ';' after extern function declaration");
         body = AstBlock::create_empty(function_context, position);
     }
+    else if (is_deferrable_function(context, set, generic_parameter_names))
+    {
+        const auto length = set.find_closing_bracket(set.position()) - set.position() + 1;
+
+        deferred_body = set.create_subset(set.position(), length);
+        set.skip(length);
+    }
     else
     {
         body = parse_block(function_context, set);
     }
 
-    return std::make_unique<AstFunctionDeclaration>(
+    auto declaration = std::make_unique<AstFunctionDeclaration>(
         function_context,
         sym_function_name,
         std::move(parameters),
@@ -106,6 +144,32 @@ std::unique_ptr<AstFunctionDeclaration> stride::ast::parse_fn_declaration(
         function_flags,
         std::move(generic_parameter_names)
     );
+
+    if (deferred_body.has_value())
+    {
+        declaration->defer_body(std::move(deferred_body.value()));
+    }
+
+    return declaration;
+}
+
+void IAstFunction::defer_body(TokenSet body_tokens)
+{
+    this->_body = nullptr;
+    this->_deferred_body = std::move(body_tokens);
+}
+
+void IAstFunction::parse_deferred_body()
+{
+    if (!this->_deferred_body.has_value())
+    {
+        return;
+    }
+
+    auto body_tokens = std::move(this->_deferred_body.value());
+    this->_deferred_body.reset();
+
+    this->_body = parse_block(this->get_context(), body_tokens);
 }
 
 std::unique_ptr<AstBlock> consume_anonymous_fn_body(
@@ -139,7 +203,7 @@ std::unique_ptr<IAstExpression> stride::ast::parse_anonymous_fn_expression(
     std::vector<std::unique_ptr<AstFunctionParameter>> parameters = {};
 
     int function_flags = SRFLAG_FN_TYPE_ANONYMOUS;
-    auto function_context = std::make_shared<ParsingContext>(
+    auto function_context = make_context(
         context,
         ContextType::FUNCTION
     );
@@ -170,14 +234,12 @@ std::unique_ptr<IAstExpression> stride::ast::parse_anonymous_fn_expression(
 
     auto lambda_body = consume_anonymous_fn_body(function_context, set);
 
-    static int anonymous_lambda_id = 0;
-
     auto symbol_name = Symbol(
         { set.get_source(),
           reference_token.get_source_fragment().offset,
           lambda_arrow.get_source_fragment().offset -
           reference_token.get_source_fragment().offset },
-        ANONYMOUS_FN_PREFIX + std::to_string(anonymous_lambda_id++)
+        ANONYMOUS_FN_PREFIX + std::to_string(next_unique_symbol_id())
     );
 
     std::vector<std::unique_ptr<IAstType>> cloned_params;
@@ -209,7 +271,7 @@ std::vector<AstReturnStatement*> collect_return_statements(const AstBlock* body)
     std::vector<AstReturnStatement*> return_statements;
     for (const auto& child : body->get_children())
     {
-        if (auto* return_stmt = dynamic_cast<AstReturnStatement*>(child.get()))
+        if (auto* return_stmt = cast_ast<AstReturnStatement*>(child.get()))
         {
             return_statements.push_back(return_stmt);
         }
@@ -228,7 +290,7 @@ std::vector<AstReturnStatement*> collect_return_statements(const AstBlock* body)
         // Edge case: if statements hold the `else` block too, though this doesn't fall under the
         // `IAstContainer` abstraction. The `get_body` part is added in the previous case, though we
         // still need to add the else body
-        if (const auto if_statement = dynamic_cast<AstConditionalStatement*>(child.
+        if (const auto if_statement = cast_ast<AstConditionalStatement*>(child.
             get()))
         {
             const auto aggregated = collect_return_statements(
@@ -270,7 +332,7 @@ void collect_free_variables(
             bool already_captured = false;
             for (const auto& cap : captures)
             {
-                if (cap.internal_name == outer_symbol->get_internal_symbol_name())
+                if (cap.internal_name == outer_symbol->get_internal_symbol())
                 {
                     already_captured = true;
                     break;
@@ -544,8 +606,8 @@ void IAstFunction::validate()
     }
 
     // Extern functions don't require return statements and have no function body, so no validation
-    // needed.
-    if (this->is_extern())
+    // needed. The same goes for functions whose body was never needed.
+    if (this->is_extern() || this->has_deferred_body())
     {
         return;
     }
@@ -661,6 +723,12 @@ llvm::Value* IAstFunction::codegen(
     llvm::IRBuilderBase* builder
 )
 {
+    // Functions that are never called aren't generated at all
+    if (this->has_deferred_body())
+    {
+        return nullptr;
+    }
+
     // Anonymous functions are tracked by their cached pointer (they have no stable
     // string name in the module). Named functions are looked up the normal way.
     llvm::Function* function = nullptr;
@@ -849,7 +917,7 @@ llvm::Value* IAstFunction::codegen(
                         captured_val = builder->CreateLoad(
                             alloca->getAllocatedType(),
                             alloca,
-                            capture.internal_name
+                            capture.internal_name.str()
                         );
                     }
                     captured_values.push_back(captured_val);
@@ -875,6 +943,10 @@ void IAstFunction::resolve_forward_references(
     if (this->is_anonymous() && this->_llvm_function)
         return;
 
+    // Nothing refers to a function whose body was never needed, so it isn't even declared
+    if (this->has_deferred_body())
+        return;
+
     // Add captured variables as first parameters
     std::vector<llvm::Type*> captured_types;
     for (const auto& capture : this->_captured_variables)
@@ -979,17 +1051,21 @@ std::unique_ptr<IAstNode> IAstFunction::clone()
         cloned_params.push_back(param->clone_as<AstFunctionParameter>());
     }
 
-    return std::make_unique<IAstFunction>(
+    auto cloned = std::make_unique<IAstFunction>(
+        AstNodeKind::FUNCTION,
         this->get_source_fragment(),
         this->get_context(),
         this->_symbol,
         std::move(cloned_params),
-        this->_body->clone_as<AstBlock>(),
+        this->_body ? this->_body->clone_as<AstBlock>() : nullptr,
         this->_annotated_return_type->clone_ty(),
         this->_visibility,
         this->_flags,
         this->_generic_parameters
     );
+    cloned->_deferred_body = this->_deferred_body;
+
+    return cloned;
 }
 
 std::string AstFunctionDeclaration::to_string()
@@ -1002,7 +1078,9 @@ std::string AstFunctionDeclaration::to_string()
         params += param->to_string();
     }
 
-    const auto body_str = this->get_body() == nullptr
+    const auto body_str = this->has_deferred_body()
+        ? "<deferred>"
+        : this->get_body() == nullptr
         ? "<empty>"
         : this->get_body()->to_string();
 
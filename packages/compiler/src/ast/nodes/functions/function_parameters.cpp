@@ -80,7 +80,7 @@ void stride::ast::parse_standalone_fn_param(
         { "Expected function parameter type", "", flags }
     );
 
-    const auto& param_name = reference_token.get_lexeme();
+    const auto param_name = std::string(set.get_lexeme(reference_token));
 
     if (std::ranges::find_if(
         parameters,
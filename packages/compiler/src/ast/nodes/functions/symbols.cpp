@@ -3,6 +3,7 @@
 #include "formatting.h"
 #include "ast/parsing_context.h"
 
+#include <atomic>
 #include <ranges>
 
 using namespace stride::ast;
@@ -57,3 +58,10 @@ std::string stride::ast::resolve_internal_name(const SymbolNameSegments& segment
 {
     return join(segments, DELIMITER);
 }
+
+size_t stride::ast::next_unique_symbol_id()
+{
+    static std::atomic<size_t> next_id = 0;
+
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
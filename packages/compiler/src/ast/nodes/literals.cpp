@@ -64,7 +64,7 @@ std::optional<std::unique_ptr<AstLiteral>> stride::ast::parse_string_literal_opt
         return std::make_unique<AstStringLiteral>(
             reference_token.get_source_fragment(),
             context,
-            str_tok.get_lexeme()
+            std::string(set.get_lexeme(str_tok))
         );
     }
     return std::nullopt;
@@ -79,7 +79,8 @@ std::optional<std::unique_ptr<AstLiteral>> stride::ast::parse_float_literal_opti
         reference_token.get_type() == TokenType::DOUBLE_LITERAL)
     {
         const auto next = set.next();
-        const auto numeric = next.get_lexeme().substr(0, next.get_lexeme().length() - 1);
+        const auto lexeme = set.get_lexeme(next);
+        const auto numeric = std::string(lexeme.substr(0, lexeme.length() - 1));
         // Remove the trailing D
 
         return std::make_unique<AstFpLiteral>(
@@ -97,7 +98,7 @@ std::optional<std::unique_ptr<AstLiteral>> stride::ast::parse_float_literal_opti
             reference_token.get_source_fragment(),
             context,
             PrimitiveType::FLOAT32,
-            std::stof(next.get_lexeme())
+            std::stof(std::string(set.get_lexeme(next)))
         );
     }
     return std::nullopt;
@@ -112,7 +113,7 @@ std::optional<std::unique_ptr<AstLiteral>> stride::ast::parse_boolean_literal_op
         reference_token.get_type() == TokenType::BOOLEAN_LITERAL)
     {
         const auto next = set.next();
-        const bool value = next.get_lexeme() == "true";
+        const bool value = set.get_lexeme(next) == "true";
 
         return std::make_unique<AstBooleanLiteral>(
             reference_token.get_source_fragment(),
@@ -131,7 +132,7 @@ std::optional<std::unique_ptr<AstLiteral>> stride::ast::parse_char_literal_optio
         reference_token.get_type() == TokenType::CHAR_LITERAL)
     {
         const auto next = set.next();
-        const char value = next.get_lexeme()[0];
+        const char value = set.get_lexeme(next)[0];
 
         return std::make_unique<AstCharLiteral>(
             reference_token.get_source_fragment(),
@@ -178,7 +179,7 @@ std::optional<std::unique_ptr<AstLiteral>> stride::ast::parse_integer_literal_op
     case TokenType::LONG_INTEGER_LITERAL:
     case TokenType::HEX_LITERAL:
     {
-        const std::string& input = reference_token.get_lexeme();
+        const auto input = std::string(set.get_lexeme(reference_token));
         set.skip(1);
 
         try
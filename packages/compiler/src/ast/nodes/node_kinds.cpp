@@ -0,0 +1,125 @@
+#include "ast/casting.h"
+#include "ast/nodes/ast_node.h"
+#include "ast/nodes/blocks.h"
+#include "ast/nodes/conditional_statement.h"
+#include "ast/nodes/control_flow_statements.h"
+#include "ast/nodes/enumerables.h"
+#include "ast/nodes/expression.h"
+#include "ast/nodes/for_loop.h"
+#include "ast/nodes/function_declaration.h"
+#include "ast/nodes/import.h"
+#include "ast/nodes/literal_values.h"
+#include "ast/nodes/module.h"
+#include "ast/nodes/package.h"
+#include "ast/nodes/return_statement.h"
+#include "ast/nodes/switch.h"
+#include "ast/nodes/type_definition.h"
+#include "ast/nodes/types.h"
+#include "ast/nodes/while_loop.h"
+
+#include <array>
+#include <initializer_list>
+
+using namespace stride::ast;
+
+/*
+ * Compile-time checks that every concrete node class declares a kind of its own, so that
+ * casting.h and the traversal can rely on the kind of a node alone.
+ * A new node class must be added to this list, and its kind to AstNodeKind.
+ */
+namespace
+{
+    template <typename... Nodes>
+    struct NodeClassList
+    {
+        static_assert((HasNodeKind<Nodes> && ...), "Every concrete node class must declare its KIND");
+
+        /// Whether the classes and the given other kinds have every kind exactly once
+        static consteval bool covers_kinds(const std::initializer_list<AstNodeKind> other_kinds)
+        {
+            std::array<bool, AST_NODE_KIND_COUNT> seen{};
+            for (const auto& kinds : { std::initializer_list<AstNodeKind>{ Nodes::KIND... }, other_kinds })
+            {
+                for (const auto kind : kinds)
+                {
+                    const auto index = static_cast<size_t>(kind);
+                    if (index >= AST_NODE_KIND_COUNT || seen[index])
+                    {
+                        return false;
+                    }
+                    seen[index] = true;
+                }
+            }
+            return sizeof...(Nodes) + other_kinds.size() == AST_NODE_KIND_COUNT;
+        }
+
+    };
+
+    /// Whether the kind range of an abstract class covers exactly the kinds of its subclasses
+    template <typename Base, typename... Nodes>
+    consteval bool has_subclass_kinds(NodeClassList<Nodes...>)
+    {
+        return ((std::is_base_of_v<Base, Nodes>
+                == is_node_kind_in_range(Nodes::KIND, Base::FIRST_KIND, Base::LAST_KIND)) && ...);
+    }
+
+    using ConcreteNodeClasses = NodeClassList<
+        AstPrimitiveType,
+        AstAliasType,
+        AstFunctionType,
+        AstArrayType,
+        AstObjectType,
+        AstTupleType,
+        AstArray,
+        AstIdentifier,
+        AstArrayMemberAccessor,
+        AstChainedExpression,
+        AstIndirectCall,
+        AstFunctionCall,
+        AstVariableDeclaration,
+        AstUnaryOp,
+        AstVariableReassignment,
+        AstObjectInitializer,
+        AstVariadicArgReference,
+        AstTupleInitializer,
+        AstTypeCastOp,
+        AstBinaryArithmeticOp,
+        AstLogicalOp,
+        AstComparisonOp,
+        AstStringLiteral,
+        AstIntLiteral,
+        AstFpLiteral,
+        AstBooleanLiteral,
+        AstCharLiteral,
+        AstNilLiteral,
+        AstFunctionDeclaration,
+        AstLambdaFunctionExpression,
+        AstContinueStatement,
+        AstBreakStatement,
+        AstFunctionParameter,
+        AstBlock,
+        AstConditionalStatement,
+        AstSwitchBranch,
+        AstSwitch,
+        AstWhileLoop,
+        AstForLoop,
+        AstReturnStatement,
+        AstImport,
+        AstPackage,
+        AstModule,
+        AstTypeDefinition,
+        AstEnumerableMember,
+        AstEnumerable>;
+
+    // Plain IAstFunction nodes are created when cloning functions
+    static_assert(
+        ConcreteNodeClasses::covers_kinds({ AstNodeKind::FUNCTION }),
+        "Every node kind must belong to exactly one node class");
+
+    static_assert(has_subclass_kinds<IAstType>(ConcreteNodeClasses{}));
+    static_assert(has_subclass_kinds<IAstExpression>(ConcreteNodeClasses{}));
+    static_assert(has_subclass_kinds<IBinaryOp>(ConcreteNodeClasses{}));
+    static_assert(has_subclass_kinds<AstLiteral>(ConcreteNodeClasses{}));
+    static_assert(has_subclass_kinds<IAstFunction>(ConcreteNodeClasses{}));
+    static_assert(has_subclass_kinds<IAstControlFlowStatement>(ConcreteNodeClasses{}));
+}
@@ -25,7 +25,7 @@ std::unique_ptr<AstPackage> stride::ast::parse_package_declaration(
     const size_t initial_offset = set.position();
     const auto reference_token = set.expect(TokenType::KEYWORD_PACKAGE);
     const auto package_name =
-        set.expect(TokenType::IDENTIFIER, "Expected package name").get_lexeme();
+        std::string(set.get_lexeme(set.expect(TokenType::IDENTIFIER, "Expected package name")));
 
     if (initial_offset != 0)
     {
@@ -158,9 +158,17 @@ static std::unique_ptr<IAstType> resolve_nested_underlying_types(std::unique_ptr
 IAstType* AstAliasType::get_underlying_type()
 {
     // Prevent reinstantiating type if it's a complex type
-    if (this->_underlying_type != nullptr)
+    if (this->is_generic_overload())
+    {
+        // The instantiation is published before its generation, and is valid for as long as the generation is current
+        if (this->_instantiation_generation.load(std::memory_order_acquire) == get_analysis_generation())
+        {
+            return this->_underlying_type.load(std::memory_order_relaxed);
+        }
+    }
+    else if (auto* underlying_type = this->_underlying_type.load(std::memory_order_acquire))
     {
-        return this->_underlying_type.get();
+        return underlying_type;
     }
 
     const auto& reference_type_definition = this->get_type_definition();
@@ -176,9 +184,24 @@ IAstType* AstAliasType::get_underlying_type()
         );
     }
 
-    std::unique_ptr<IAstType> base_type = this->is_generic_overload()
-        ? instantiate_generic_type(this, reference_type_definition.value())
-        : this->get_reference_type().value_or(nullptr);
+    // Generic instantiations are shared by all uses with the same type arguments
+    if (this->is_generic_overload())
+    {
+        const auto generation = get_analysis_generation();
+        auto* instantiation = get_generic_instantiation(
+            reference_type_definition.value(),
+            this->get_name(),
+            this->get_instantiated_generic_types(),
+            this->get_source_fragment());
+
+        // Threads resolving this alias at once may each publish an instantiation, all of which are valid
+        this->_underlying_type.store(instantiation, std::memory_order_relaxed);
+        this->_instantiation_generation.store(generation, std::memory_order_release);
+
+        return instantiation;
+    }
+
+    std::unique_ptr<IAstType> base_type = this->get_reference_type().value_or(nullptr);
 
     if (!base_type)
     {
@@ -191,6 +214,31 @@ IAstType* AstAliasType::get_underlying_type()
         );
     }
 
+    auto resolved_type = resolve_underlying_type(
+        std::move(base_type),
+        this->get_name(),
+        this->get_source_fragment());
+
+    // Another thread may have resolved this alias in the meantime, in which case its result is kept
+    IAstType* published_type = nullptr;
+    if (!this->_underlying_type.compare_exchange_strong(
+        published_type,
+        resolved_type.get(),
+        std::memory_order_acq_rel))
+    {
+        return published_type;
+    }
+
+    this->_owned_underlying_type = std::move(resolved_type);
+    return this->_owned_underlying_type.get();
+}
+
+std::unique_ptr<IAstType> AstAliasType::resolve_underlying_type(
+    std::unique_ptr<IAstType> base_type,
+    const std::string& name,
+    const SourceFragment& source
+)
+{
     int recursion_guard = 0;
 
     while (true)
@@ -201,8 +249,8 @@ IAstType* AstAliasType::get_underlying_type()
                 ErrorType::COMPILATION_ERROR,
                 std::format(
                     "Exceeded maximum recursion depth while resolving base type of '{}'",
-                    this->get_name()),
-                this->get_source_fragment()
+                    name),
+                source
             );
         }
 
@@ -210,27 +258,30 @@ IAstType* AstAliasType::get_underlying_type()
         {
             if (named_reference->is_generic_overload())
             {
-                if (const auto next_def = named_reference->get_type_definition();
-                    next_def.has_value())
-                {
-                    base_type = instantiate_generic_type(named_reference, next_def.value());
-                }
-                else
+                const auto next_def = named_reference->get_type_definition();
+                if (!next_def.has_value())
                 {
                     break;
                 }
+
+                // The instantiation has all of its aliases resolved already
+                base_type = get_generic_instantiation(
+                    next_def.value(),
+                    named_reference->get_name(),
+                    named_reference->get_instantiated_generic_types(),
+                    named_reference->get_source_fragment()
+                )->clone_ty();
+                break;
+            }
+
+            if (auto next_type = named_reference->get_reference_type();
+                next_type.has_value())
+            {
+                base_type = std::move(next_type.value());
             }
             else
             {
-                if (auto next_type = named_reference->get_reference_type();
-                    next_type.has_value())
-                {
-                    base_type = std::move(next_type.value());
-                }
-                else
-                {
-                    break;
-                }
+                break;
             }
         }
         else
@@ -246,9 +297,7 @@ IAstType* AstAliasType::get_underlying_type()
         }
     }
 
-    this->_underlying_type = std::move(base_type);
-
-    return this->_underlying_type.get();
+    return base_type;
 }
 
 bool AstAliasType::is_castable_to_impl(IAstType* other)
@@ -300,7 +349,7 @@ llvm::Type* AstAliasType::get_llvm_type_impl(llvm::Module* module)
     return this->get_underlying_type()->get_llvm_type(module);
 }
 
-bool AstAliasType::equals(IAstType* other)
+bool AstAliasType::equals_impl(IAstType* other)
 {
     // Simple naming checks, e.g., "Vec3 == Vec3"
     if (auto* other_named = cast_type<const AstAliasType*>(other))
@@ -339,6 +388,25 @@ bool AstAliasType::equals(IAstType* other)
     return false;
 }
 
+TypeKey AstAliasType::get_type_key()
+{
+    TypeKey key = {
+        .kind = TypeKind::ALIAS,
+        .flags = this->get_flags(),
+        .detail = InternedString(this->_name).id(),
+        .length = 0,
+        .children = {},
+        .member_names = {}
+    };
+
+    key.children.reserve(this->_generic_types.size());
+    for (const auto& generic_type : this->_generic_types)
+    {
+        key.children.push_back(generic_type->get_type_id());
+    }
+    return key;
+}
+
 std::string AstAliasType::get_type_name()
 {
     if (!this->_generic_types.empty())
@@ -362,13 +430,25 @@ std::unique_ptr<IAstNode> AstAliasType::clone()
     {
         generic_types.push_back(generic_type->clone_ty());
     }
-    return std::make_unique<AstAliasType>(
+    auto clone = std::make_unique<AstAliasType>(
         this->get_source_fragment(),
         this->get_context(),
         this->_name,
         this->get_flags(),
         std::move(generic_types)
     );
+
+    // Clones resolve to the same shared instantiation, so they don't have to look it up again
+    if (this->is_generic_overload())
+    {
+        const auto generation = this->_instantiation_generation.load(std::memory_order_acquire);
+        clone->_underlying_type.store(
+            this->_underlying_type.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        clone->_instantiation_generation.store(generation, std::memory_order_release);
+    }
+
+    return clone;
 }
 
 std::string AstAliasType::to_string()
@@ -95,7 +95,7 @@ std::unique_ptr<IAstNode> AstFunctionType::clone()
     );
 }
 
-bool AstFunctionType::equals(IAstType* other)
+bool AstFunctionType::equals_impl(IAstType* other)
 {
     if (const auto* other_func = cast_type<const AstFunctionType*>(other))
     {
@@ -115,7 +115,7 @@ bool AstFunctionType::equals(IAstType* other)
         return true;
     }
 
-    if (auto* other_named = dynamic_cast<AstAliasType*>(other))
+    if (auto* other_named = cast_type<AstAliasType*>(other))
     {
         return other_named->equals(this);
     }
@@ -123,6 +123,26 @@ bool AstFunctionType::equals(IAstType* other)
     return false;
 }
 
+TypeKey AstFunctionType::get_type_key()
+{
+    TypeKey key = {
+        .kind = TypeKind::FUNCTION,
+        .flags = this->get_flags(),
+        .detail = 0,
+        .length = 0,
+        .children = {},
+        .member_names = {}
+    };
+
+    key.children.reserve(this->_parameters.size() + 1);
+    key.children.push_back(this->_return_type->get_type_id());
+    for (const auto& parameter : this->_parameters)
+    {
+        key.children.push_back(parameter->get_type_id());
+    }
+    return key;
+}
+
 bool AstFunctionType::is_castable_to_impl(IAstType* other)
 {
     if (const auto other_named = cast_type<AstAliasType*>(other))
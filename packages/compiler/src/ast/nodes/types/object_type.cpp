@@ -18,10 +18,9 @@ void parse_object_member(
     const TypeParsingOptions& options
 )
 {
-    const auto& struct_member_name =
-        set
-       .expect(TokenType::IDENTIFIER, "Expected object member name")
-       .get_lexeme();
+    const auto struct_member_name = std::string(
+        set.get_lexeme(
+            set.expect(TokenType::IDENTIFIER, "Expected object member name")));
 
     set.expect(TokenType::COLON);
 
@@ -81,7 +80,7 @@ std::optional<std::unique_ptr<IAstType>> stride::ast::parse_object_type_optional
     auto struct_body_set = collect_block_required(set, "A struct must have at least 1 member");
 
     ObjectTypeMemberList struct_fields;
-    const auto struct_type_context = std::make_shared<ParsingContext>(context, context->get_context_type());
+    const auto struct_type_context = make_context(context, context->get_context_type());
 
     // Parse fields
     while (struct_body_set.has_next())
@@ -167,10 +166,10 @@ llvm::Type* AstObjectType::get_llvm_type_impl(llvm::Module* module)
     }
 
     std::vector<llvm::Type*> member_types;
-    member_types.reserve(this->get_members().size());
+    member_types.reserve(this->_members.size());
 
     // Case: type Name { members... }
-    for (const auto& [member_name, member_type] : this->get_members())
+    for (const auto& [member_name, member_type] : this->_members)
     {
         llvm::Type* llvm_type = member_type->get_llvm_type(module);
 
@@ -224,7 +223,7 @@ std::string AstObjectType::to_string()
     return this->get_type_name();
 }
 
-bool AstObjectType::equals(IAstType* other)
+bool AstObjectType::equals_impl(IAstType* other)
 {
     if (const auto other_struct_ty = cast_type<const AstObjectType*>(other))
     {
@@ -269,6 +268,31 @@ bool AstObjectType::equals(IAstType* other)
     return false;
 }
 
+TypeKey AstObjectType::get_type_key()
+{
+    TypeKey key = {
+        .kind = TypeKind::OBJECT,
+        .flags = this->get_flags(),
+        .detail = InternedString(this->_type_name).id(),
+        .length = 0,
+        .children = {},
+        .member_names = {}
+    };
+
+    key.children.reserve(this->_members.size() + this->_instantiated_generics.size());
+    key.member_names.reserve(this->_members.size());
+    for (const auto& [field_name, field_type] : this->_members)
+    {
+        key.children.push_back(field_type->get_type_id());
+        key.member_names.push_back(InternedString(field_name).id());
+    }
+    for (const auto& generic_type : this->_instantiated_generics)
+    {
+        key.children.push_back(generic_type->get_type_id());
+    }
+    return key;
+}
+
 std::unique_ptr<IAstNode> AstObjectType::clone()
 {
     ObjectTypeMemberList cloned_members;
@@ -274,7 +274,7 @@ std::optional<std::unique_ptr<IAstType>> stride::ast::parse_primitive_type_optio
     return parse_type_metadata(std::move(result.value()), set);
 }
 
-bool AstPrimitiveType::equals(IAstType* other)
+bool AstPrimitiveType::equals_impl(IAstType* other)
 {
     if (const auto* other_primitive = cast_type<const AstPrimitiveType*>(other))
     {
@@ -300,6 +300,18 @@ bool AstPrimitiveType::equals(IAstType* other)
     return false;
 }
 
+TypeKey AstPrimitiveType::get_type_key()
+{
+    return {
+        .kind = TypeKind::PRIMITIVE,
+        .flags = this->get_flags(),
+        .detail = static_cast<uint32_t>(this->_type),
+        .length = 0,
+        .children = {},
+        .member_names = {}
+    };
+}
+
 bool AstPrimitiveType::is_assignable_to_impl(IAstType* other)
 {
     if (const auto other_primitive = cast_type<AstPrimitiveType*>(other))
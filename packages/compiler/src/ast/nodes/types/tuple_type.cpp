@@ -102,7 +102,7 @@ std::unique_ptr<IAstNode> AstTupleType::clone()
     );
 }
 
-bool AstTupleType::equals(IAstType* other)
+bool AstTupleType::equals_impl(IAstType* other)
 {
     const auto other_tuple = cast_type<AstTupleType*>(other);
 
@@ -129,6 +129,25 @@ bool AstTupleType::equals(IAstType* other)
     return true;
 }
 
+TypeKey AstTupleType::get_type_key()
+{
+    TypeKey key = {
+        .kind = TypeKind::TUPLE,
+        .flags = this->get_flags(),
+        .detail = 0,
+        .length = 0,
+        .children = {},
+        .member_names = {}
+    };
+
+    key.children.reserve(this->_members.size());
+    for (const auto& member : this->_members)
+    {
+        key.children.push_back(member->get_type_id());
+    }
+    return key;
+}
+
 std::string AstTupleType::to_string()
 {
     std::vector<std::string> member_strings;
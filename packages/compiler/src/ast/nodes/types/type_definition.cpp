@@ -15,7 +15,7 @@ std::unique_ptr<AstTypeDefinition> stride::ast::parse_type_definition(
     const auto reference_token = set.expect(TokenType::KEYWORD_TYPE);
     const auto& ref_pos = reference_token.get_source_fragment();
 
-    const auto type_name = set.expect(TokenType::IDENTIFIER, "Expected type name").get_lexeme();
+    const auto type_name = std::string(set.get_lexeme(set.expect(TokenType::IDENTIFIER, "Expected type name")));
 
     GenericParameterList generic_params = parse_generic_declaration(set);
 
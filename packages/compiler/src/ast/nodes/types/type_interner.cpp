@@ -0,0 +1,166 @@
+#include "ast/nodes/type_interner.h"
+
+#include "ast/nodes/types.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace stride::ast;
+
+namespace
+{
+    void hash_combine(size_t& seed, const size_t value)
+    {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+
+    struct TypeKeyHash
+    {
+        size_t operator()(const TypeKey& key) const noexcept
+        {
+            size_t seed = static_cast<size_t>(key.kind);
+            hash_combine(seed, std::hash<int>{}(key.flags));
+            hash_combine(seed, key.detail);
+            hash_combine(seed, key.length);
+
+            for (const auto child : key.children)
+            {
+                hash_combine(seed, child);
+            }
+            for (const auto name : key.member_names)
+            {
+                hash_combine(seed, name);
+            }
+            return seed;
+        }
+    };
+
+    /*
+     * Interned types are looked up by their structure. Map nodes never move, so the entries can be
+     * referred to by id as well. IAstType caches the type it interns to, so after the first lookup
+     * of a type, neither the type nor its clones consult the interner again.
+     */
+    struct TypeInternerState
+    {
+        std::shared_mutex mutex;
+        std::unordered_map<TypeKey, InternedType, TypeKeyHash> types;
+        std::deque<const std::pair<const TypeKey, InternedType>*> entries;
+
+        const InternedType& get(const TypeId id) const
+        {
+            return this->entries[id]->second;
+        }
+
+        bool is_exact(const TypeKey& key) const
+        {
+            switch (key.kind)
+            {
+            case TypeKind::PRIMITIVE:
+                // nil equals any optional type
+                return key.detail != static_cast<uint32_t>(PrimitiveType::NIL);
+            case TypeKind::ARRAY:
+            case TypeKind::FUNCTION:
+            case TypeKind::TUPLE:
+                return std::ranges::all_of(
+                    key.children,
+                    [&](const TypeId child)
+                    {
+                        return this->get(child).is_exact;
+                    });
+            default:
+                return false;
+            }
+        }
+
+        /// Interns a key and its shape, the caller holds the exclusive lock
+        const InternedType& intern_locked(const TypeKey& key)
+        {
+            if (const auto it = this->types.find(key); it != this->types.end())
+            {
+                return it->second;
+            }
+
+            TypeKey shape_key = key;
+            shape_key.flags = 0;
+            shape_key.length = 0;
+            if (shape_key.kind == TypeKind::OBJECT)
+            {
+                shape_key.detail = 0;
+                shape_key.children.resize(shape_key.member_names.size());
+            }
+            for (auto& child : shape_key.children)
+            {
+                child = this->get(child).shape;
+            }
+
+            std::optional<TypeId> shape = std::nullopt;
+            if (!(shape_key == key))
+            {
+                shape = this->intern_locked(shape_key).id;
+            }
+
+            if (this->entries.size() > std::numeric_limits<TypeId>::max())
+            {
+                throw std::runtime_error("Exceeded the maximum number of interned types");
+            }
+
+            const auto id = static_cast<TypeId>(this->entries.size());
+            const auto [it, inserted] = this->types.emplace(
+                key,
+                InternedType{
+                    .id = id,
+                    .shape = shape.value_or(id),
+                    .is_exact = this->is_exact(key)
+                });
+            this->entries.push_back(&*it);
+
+            return it->second;
+        }
+    };
+
+    // Function-local, so interning is safe from static initializers in other translation units.
+    TypeInternerState& state()
+    {
+        static TypeInternerState instance;
+        return instance;
+    }
+}
+
+const InternedType& type_interner::intern(const TypeKey& key)
+{
+    auto& instance = state();
+
+    {
+        std::shared_lock lock(instance.mutex);
+        if (const auto it = instance.types.find(key); it != instance.types.end())
+        {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(instance.mutex);
+    return instance.intern_locked(key);
+}
+
+const TypeKey& type_interner::resolve(const TypeId id)
+{
+    auto& instance = state();
+
+    std::shared_lock lock(instance.mutex);
+    return instance.entries[id]->first;
+}
+
+size_t type_interner::size()
+{
+    auto& instance = state();
+
+    std::shared_lock lock(instance.mutex);
+    return instance.entries.size();
+}
@@ -76,7 +76,7 @@ std::string AstArrayType::to_string()
         (this->get_flags() & SRFLAG_TYPE_OPTIONAL) != 0 ? "?" : "");
 }
 
-bool AstArrayType::equals(IAstType* other)
+bool AstArrayType::equals_impl(IAstType* other)
 {
     if (const auto* other_array = cast_type<AstArrayType*>(other))
     {
@@ -91,6 +91,18 @@ bool AstArrayType::equals(IAstType* other)
     return false;
 }
 
+TypeKey AstArrayType::get_type_key()
+{
+    return {
+        .kind = TypeKind::ARRAY,
+        .flags = this->get_flags(),
+        .detail = 0,
+        .length = this->_initial_length,
+        .children = { this->_element_type->get_type_id() },
+        .member_names = {}
+    };
+}
+
 bool AstArrayType::is_assignable_to_impl(IAstType* other)
 {
     // If we're trying to assign a named type to an array, we have to check
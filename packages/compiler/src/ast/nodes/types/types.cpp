@@ -79,6 +79,51 @@ llvm::Type* IAstType::get_llvm_type(llvm::Module* module)
     return this->get_llvm_type_impl(module);
 }
 
+const InternedType& IAstType::get_interned_type()
+{
+    if (const auto* interned_type = this->_interned_type.load(std::memory_order_acquire))
+    {
+        return *interned_type;
+    }
+
+    const auto& interned_type = type_interner::intern(this->get_type_key());
+    this->_interned_type.store(&interned_type, std::memory_order_release);
+    return interned_type;
+}
+
+bool IAstType::equals(IAstType* other)
+{
+    if (other == nullptr)
+    {
+        return false;
+    }
+
+    if (other == this)
+    {
+        return true;
+    }
+
+    // Types that were never interned are usually compared only once, so they are compared
+    // structurally rather than paying for interning them
+    const auto* self_type = this->_interned_type.load(std::memory_order_acquire);
+    const auto* other_type = other->_interned_type.load(std::memory_order_acquire);
+    if (self_type != nullptr && other_type != nullptr)
+    {
+        if (self_type->shape == other_type->shape)
+        {
+            return true;
+        }
+
+        // Exact types are only equal to types of the same shape
+        if (self_type->is_exact && other_type->is_exact)
+        {
+            return false;
+        }
+    }
+
+    return this->equals_impl(other);
+}
+
 bool IAstType::is_assignable_to(IAstType* other)
 {
     // A type is not assignable to another if the source is optional but the target is not.
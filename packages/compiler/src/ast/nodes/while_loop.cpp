@@ -31,7 +31,7 @@ std::unique_ptr<AstWhileLoop> stride::ast::parse_while_loop_statement(
         set.throw_error("Expected while loop condition");
     }
 
-    const auto while_body_context = std::make_shared<ParsingContext>(
+    const auto while_body_context = make_context(
         context,
         ContextType::CONTROL_FLOW
     );
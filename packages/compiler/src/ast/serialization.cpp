@@ -0,0 +1,1563 @@
+#include "ast/serialization.h"
+
+#include "ast/casting.h"
+#include "ast/closures.h"
+#include "ast/modifiers.h"
+#include "ast/parsing_context.h"
+#include "ast/symbols.h"
+#include "ast/nodes/blocks.h"
+#include "ast/nodes/conditional_statement.h"
+#include "ast/nodes/control_flow_statements.h"
+#include "ast/nodes/enumerables.h"
+#include "ast/nodes/expression.h"
+#include "ast/nodes/for_loop.h"
+#include "ast/nodes/function_declaration.h"
+#include "ast/nodes/import.h"
+#include "ast/nodes/literal_values.h"
+#include "ast/nodes/module.h"
+#include "ast/nodes/package.h"
+#include "ast/nodes/return_statement.h"
+#include "ast/nodes/type_definition.h"
+#include "ast/nodes/types.h"
+#include "ast/nodes/while_loop.h"
+#include "ast/tokens/tokenizer.h"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CSTRIDE_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define CSTRIDE_HAS_MMAP 0
+#include <process.h>
+#endif
+
+using namespace stride;
+using namespace stride::ast;
+
+/*
+ * Binary AST format
+ *
+ * An entry starts with a header identifying the format and the source it was written for,
+ * followed by three sections:
+ *
+ *   contexts     parent, type and name of every context, parents before their children
+ *   definitions  the definitions made in each context while parsing, in context order
+ *   nodes        the tree, in pre-order
+ *
+ * Every node starts with its tag, source fragment and context, followed by its own fields.
+ * Integers are LEB128 varints, signed ones zigzag-encoded. Strings are a length followed by
+ * their bytes, and lists a count followed by their elements. Absent nodes are written as
+ * <code>NodeTag::NONE</code>, absent contexts as 0 and other contexts as their index + 1.
+ * Deferred function bodies are written as their tokens, each offset relative to the end of the
+ * token before it, so that they can be parsed once they are needed without lexing the file.
+ */
+namespace
+{
+    constexpr uint32_t AST_FORMAT_MAGIC = 0x54534153; // "SAST"
+
+    enum class NodeTag : uint8_t
+    {
+        NONE,
+        BLOCK,
+        CONDITIONAL,
+        CONTINUE,
+        BREAK,
+        ENUMERABLE,
+        ENUMERABLE_MEMBER,
+        FOR_LOOP,
+        WHILE_LOOP,
+        IMPORT,
+        MODULE,
+        PACKAGE,
+        RETURN,
+        TYPE_DEFINITION,
+        FUNCTION_PARAMETER,
+        FUNCTION_DECLARATION,
+        LAMBDA,
+        ARRAY,
+        IDENTIFIER,
+        ARRAY_MEMBER_ACCESSOR,
+        CHAINED_EXPRESSION,
+        INDIRECT_CALL,
+        FUNCTION_CALL,
+        VARIABLE_DECLARATION,
+        BINARY_ARITHMETIC_OP,
+        LOGICAL_OP,
+        COMPARISON_OP,
+        UNARY_OP,
+        VARIABLE_REASSIGNMENT,
+        OBJECT_INITIALIZER,
+        VARIADIC_ARG_REFERENCE,
+        TUPLE_INITIALIZER,
+        TYPE_CAST,
+        STRING_LITERAL,
+        INT_LITERAL,
+        FP_LITERAL,
+        BOOLEAN_LITERAL,
+        CHAR_LITERAL,
+        NIL_LITERAL,
+        PRIMITIVE_TYPE,
+        ALIAS_TYPE,
+        FUNCTION_TYPE,
+        ARRAY_TYPE,
+        OBJECT_TYPE,
+        TUPLE_TYPE,
+    };
+
+    enum class DefinitionTag : uint8_t
+    {
+        SYMBOL,
+        TYPE,
+    };
+
+    /// Thrown while writing a tree containing something the format can't represent.
+    struct unserializable_node {};
+
+    /// Thrown while reading an entry that is truncated or otherwise invalid.
+    struct malformed_entry {};
+
+    class AstWriter
+    {
+        const SourceFile* _source;
+        std::string _buffer;
+
+        std::unordered_map<const ParsingContext*, uint64_t> _context_ids;
+        std::vector<const ParsingContext*> _contexts;
+
+    public:
+        explicit AstWriter(const SourceFile* source) :
+            _source(source) {}
+
+        std::string write_file(AstBlock* root, const uint64_t source_hash)
+        {
+            this->write_node(root);
+            auto nodes = std::move(this->_buffer);
+
+            // Definitions may refer to contexts no node belongs to, which are then appended
+            this->_buffer.clear();
+            for (size_t i = 0; i < this->_contexts.size(); ++i)
+            {
+                this->write_definitions(*this->_contexts[i]);
+            }
+            auto definitions = std::move(this->_buffer);
+
+            this->_buffer.clear();
+            this->write_varint(AST_FORMAT_MAGIC);
+            this->write_varint(AST_FORMAT_VERSION);
+            this->write_varint(source_hash);
+            this->write_varint(this->_source->source.size());
+
+            this->write_varint(this->_contexts.size());
+            for (const auto* context : this->_contexts)
+            {
+                const auto& parent = context->get_parent_context();
+                this->write_varint(parent ? this->_context_ids.at(parent.get()) : 0);
+                this->write_varint(static_cast<uint64_t>(context->get_context_type()));
+                this->write_string(context->get_name());
+            }
+
+            this->_buffer.append(definitions);
+            this->_buffer.append(nodes);
+
+            return std::move(this->_buffer);
+        }
+
+    private:
+        void write_varint(uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                this->_buffer.push_back(static_cast<char>(value | 0x80));
+                value >>= 7;
+            }
+            this->_buffer.push_back(static_cast<char>(value));
+        }
+
+        void write_signed(const int64_t value)
+        {
+            this->write_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        void write_string(const std::string_view value)
+        {
+            this->write_varint(value.size());
+            this->_buffer.append(value);
+        }
+
+        template <typename T>
+        void write_raw(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            this->_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        uint64_t register_context(const ParsingContext* context)
+        {
+            if (const auto it = this->_context_ids.find(context); it != this->_context_ids.end())
+            {
+                return it->second;
+            }
+
+            // Parents are registered first, so they can be created before their children when reading
+            if (const auto& parent = context->get_parent_context())
+            {
+                this->register_context(parent.get());
+            }
+
+            this->_contexts.push_back(context);
+            const auto id = this->_contexts.size();
+            this->_context_ids.emplace(context, id);
+
+            return id;
+        }
+
+        void write_context(const std::shared_ptr<ParsingContext>& context)
+        {
+            this->write_varint(context ? this->register_context(context.get()) : 0);
+        }
+
+        void write_fragment(const SourceFragment& fragment)
+        {
+            if (fragment.source && fragment.source.get() != this->_source)
+            {
+                throw unserializable_node{};
+            }
+
+            this->write_varint(fragment.source ? fragment.offset + 1 : 0);
+            this->write_varint(fragment.length);
+        }
+
+        void write_symbol_names(const Symbol& symbol)
+        {
+            this->write_string(static_cast<const std::string&>(symbol.name));
+            this->write_string(static_cast<const std::string&>(symbol.internal_name));
+        }
+
+        void write_header(const NodeTag tag, IAstNode* node)
+        {
+            this->_buffer.push_back(static_cast<char>(tag));
+            this->write_fragment(node->get_source_fragment());
+            this->write_context(node->get_context());
+        }
+
+        template <typename T>
+        void write_nodes(const std::vector<std::unique_ptr<T>>& nodes)
+        {
+            this->write_varint(nodes.size());
+            for (const auto& node : nodes)
+            {
+                this->write_node(node.get());
+            }
+        }
+
+        void write_generic_parameters(const GenericParameterList& parameters)
+        {
+            this->write_varint(parameters.size());
+            for (const auto& parameter : parameters)
+            {
+                this->write_string(parameter);
+            }
+        }
+
+        void write_definitions(const ParsingContext& context)
+        {
+            const auto& definitions = context.get_definitions();
+            this->write_varint(definitions.size());
+
+            for (const auto& definition : definitions)
+            {
+                if (const auto* symbol = dynamic_cast<const definition::IdentifiableSymbolDef*>(definition.get()))
+                {
+                    this->_buffer.push_back(static_cast<char>(DefinitionTag::SYMBOL));
+                    this->write_varint(static_cast<uint64_t>(symbol->get_symbol_type()));
+                }
+                else if (const auto* type = dynamic_cast<const definition::TypeDefinition*>(definition.get()))
+                {
+                    this->_buffer.push_back(static_cast<char>(DefinitionTag::TYPE));
+                    this->write_node(type->get_type());
+                    this->write_generic_parameters(type->get_generics_parameters());
+                }
+                else
+                {
+                    // Functions and variables are only defined during analysis
+                    throw unserializable_node{};
+                }
+
+                this->write_symbol_names(definition->get_symbol());
+                this->write_fragment(definition->get_symbol().symbol_position);
+                this->write_varint(static_cast<uint64_t>(definition->get_visibility()));
+            }
+        }
+
+        void write_deferred_body(const IAstFunction* function)
+        {
+            const auto& deferred_body = function->get_deferred_body();
+            if (!deferred_body.has_value())
+            {
+                this->write_varint(0);
+                return;
+            }
+
+            const auto tokens = deferred_body->get_tokens();
+            this->write_varint(tokens.size());
+
+            size_t previous_end = 0;
+            for (const auto& token : tokens)
+            {
+                this->write_varint(static_cast<uint64_t>(token.get_type()));
+                this->write_varint(token.get_offset() - previous_end);
+                this->write_varint(token.get_length());
+                this->write_varint(token.get_flags());
+
+                previous_end = token.get_offset() + token.get_length();
+            }
+        }
+
+        void write_function(const NodeTag tag, IAstFunction* function)
+        {
+            this->write_header(tag, function);
+            this->write_symbol_names(function->get_symbol());
+            this->write_nodes(function->get_parameters_ref());
+            this->write_node(function->get_body());
+            this->write_node(function->get_return_type());
+            this->write_varint(static_cast<uint64_t>(function->get_visibility()));
+            this->write_signed(function->get_flags());
+            this->write_deferred_body(function);
+        }
+
+        void write_binary_op(const IBinaryOp* op, const uint64_t op_type)
+        {
+            this->write_node(op->get_left());
+            this->write_varint(op_type);
+            this->write_node(op->get_right());
+        }
+
+        void write_type(IAstType* type)
+        {
+            if (const auto* primitive = cast_type<AstPrimitiveType*>(type))
+            {
+                this->write_header(NodeTag::PRIMITIVE_TYPE, type);
+                this->write_varint(static_cast<uint64_t>(primitive->get_primitive_type()));
+            }
+            else if (const auto* alias = cast_type<AstAliasType*>(type))
+            {
+                this->write_header(NodeTag::ALIAS_TYPE, type);
+                this->write_string(alias->get_name());
+                this->write_nodes(alias->get_instantiated_generic_types());
+            }
+            else if (const auto* function = cast_type<AstFunctionType*>(type))
+            {
+                this->write_header(NodeTag::FUNCTION_TYPE, type);
+                this->write_nodes(function->get_parameter_types());
+                this->write_node(function->get_return_type().get());
+            }
+            else if (const auto* array = cast_type<AstArrayType*>(type))
+            {
+                this->write_header(NodeTag::ARRAY_TYPE, type);
+                this->write_node(array->get_element_type());
+                this->write_varint(array->get_initial_length());
+            }
+            else if (const auto* object = cast_type<AstObjectType*>(type))
+            {
+                this->write_header(NodeTag::OBJECT_TYPE, type);
+                this->write_string(object->get_base_name());
+                this->write_varint(object->get_members_ref().size());
+                for (const auto& [name, member_type] : object->get_members_ref())
+                {
+                    this->write_string(name);
+                    this->write_node(member_type.get());
+                }
+                this->write_nodes(object->get_instantiated_generics());
+            }
+            else if (const auto* tuple = cast_type<AstTupleType*>(type))
+            {
+                this->write_header(NodeTag::TUPLE_TYPE, type);
+                this->write_nodes(tuple->get_members());
+            }
+            else
+            {
+                throw unserializable_node{};
+            }
+
+            // Constructors derive some flags from their arguments, hence the flags are restored as a whole
+            this->write_signed(type->get_flags());
+        }
+
+        void write_literal(AstLiteral* literal)
+        {
+            if (const auto* string = cast_expr<AstStringLiteral*>(literal))
+            {
+                this->write_header(NodeTag::STRING_LITERAL, literal);
+                this->write_string(string->value());
+            }
+            else if (const auto* integer = cast_expr<AstIntLiteral*>(literal))
+            {
+                this->write_header(NodeTag::INT_LITERAL, literal);
+                this->write_varint(static_cast<uint64_t>(integer->get_primitive_type()));
+                this->write_signed(integer->value());
+                this->write_signed(integer->get_flags());
+            }
+            else if (const auto* fp = cast_expr<AstFpLiteral*>(literal))
+            {
+                this->write_header(NodeTag::FP_LITERAL, literal);
+                this->write_varint(static_cast<uint64_t>(fp->get_primitive_type()));
+                this->write_raw(fp->value());
+            }
+            else if (const auto* boolean = cast_expr<AstBooleanLiteral*>(literal))
+            {
+                this->write_header(NodeTag::BOOLEAN_LITERAL, literal);
+                this->write_varint(boolean->value());
+            }
+            else if (const auto* character = cast_expr<AstCharLiteral*>(literal))
+            {
+                this->write_header(NodeTag::CHAR_LITERAL, literal);
+                this->write_raw(character->value());
+            }
+            else if (cast_expr<AstNilLiteral*>(literal))
+            {
+                this->write_header(NodeTag::NIL_LITERAL, literal);
+            }
+            else
+            {
+                throw unserializable_node{};
+            }
+        }
+
+        void write_expression(IAstExpression* expression)
+        {
+            if (auto* literal = cast_expr<AstLiteral*>(expression))
+            {
+                this->write_literal(literal);
+            }
+            else if (auto* identifier = cast_expr<AstIdentifier*>(expression))
+            {
+                this->write_header(NodeTag::IDENTIFIER, expression);
+                this->write_string(identifier->get_name());
+                this->write_string(identifier->get_scoped_name());
+            }
+            else if (auto* call = cast_expr<AstFunctionCall*>(expression))
+            {
+                this->write_header(NodeTag::FUNCTION_CALL, expression);
+                this->write_node(call->get_function_name_identifier());
+                this->write_nodes(call->get_arguments());
+                this->write_signed(call->get_flags());
+            }
+            else if (auto* declaration = cast_expr<AstVariableDeclaration*>(expression))
+            {
+                this->write_header(NodeTag::VARIABLE_DECLARATION, expression);
+                this->write_string(declaration->get_variable_name());
+                this->write_string(declaration->get_internal_name());
+                this->write_node(declaration->get_annotated_type().value_or(nullptr));
+                this->write_node(declaration->get_initial_value());
+                this->write_varint(static_cast<uint64_t>(declaration->get_visibility()));
+                this->write_signed(declaration->get_flags());
+            }
+            else if (const auto* arithmetic = cast_expr<AstBinaryArithmeticOp*>(expression))
+            {
+                this->write_header(NodeTag::BINARY_ARITHMETIC_OP, expression);
+                this->write_binary_op(arithmetic, static_cast<uint64_t>(arithmetic->get_op_type()));
+            }
+            else if (const auto* logical = cast_expr<AstLogicalOp*>(expression))
+            {
+                this->write_header(NodeTag::LOGICAL_OP, expression);
+                this->write_binary_op(logical, static_cast<uint64_t>(logical->get_op_type()));
+            }
+            else if (const auto* comparison = cast_expr<AstComparisonOp*>(expression))
+            {
+                this->write_header(NodeTag::COMPARISON_OP, expression);
+                this->write_binary_op(comparison, static_cast<uint64_t>(comparison->get_op_type()));
+            }
+            else if (const auto* unary = cast_expr<AstUnaryOp*>(expression))
+            {
+                this->write_header(NodeTag::UNARY_OP, expression);
+                this->write_varint(static_cast<uint64_t>(unary->get_op_type()));
+                this->write_node(&unary->get_operand());
+            }
+            else if (const auto* reassignment = cast_expr<AstVariableReassignment*>(expression))
+            {
+                this->write_header(NodeTag::VARIABLE_REASSIGNMENT, expression);
+                this->write_node(reassignment->get_identifier());
+                this->write_varint(static_cast<uint64_t>(reassignment->get_operator()));
+                this->write_node(reassignment->get_value());
+            }
+            else if (const auto* chained = cast_expr<AstChainedExpression*>(expression))
+            {
+                this->write_header(NodeTag::CHAINED_EXPRESSION, expression);
+                this->write_node(chained->get_base());
+                this->write_node(chained->get_followup());
+            }
+            else if (const auto* accessor = cast_expr<AstArrayMemberAccessor*>(expression))
+            {
+                this->write_header(NodeTag::ARRAY_MEMBER_ACCESSOR, expression);
+                this->write_node(accessor->get_array_base());
+                this->write_node(accessor->get_index());
+            }
+            else if (const auto* indirect_call = cast_expr<AstIndirectCall*>(expression))
+            {
+                this->write_header(NodeTag::INDIRECT_CALL, expression);
+                this->write_node(indirect_call->get_callee());
+                this->write_nodes(indirect_call->get_args());
+            }
+            else if (const auto* array = cast_expr<AstArray*>(expression))
+            {
+                this->write_header(NodeTag::ARRAY, expression);
+                this->write_nodes(array->get_elements());
+            }
+            else if (const auto* initializer = cast_expr<AstObjectInitializer*>(expression))
+            {
+                this->write_header(NodeTag::OBJECT_INITIALIZER, expression);
+                this->write_string(initializer->get_struct_name());
+                this->write_varint(initializer->get_initializers().size());
+                for (const auto& [member_name, value] : initializer->get_initializers())
+                {
+                    this->write_string(member_name);
+                    this->write_node(value.get());
+                }
+                this->write_nodes(initializer->get_generic_type_arguments());
+            }
+            else if (const auto* tuple = cast_expr<AstTupleInitializer*>(expression))
+            {
+                this->write_header(NodeTag::TUPLE_INITIALIZER, expression);
+                this->write_nodes(tuple->get_members());
+            }
+            else if (const auto* cast = cast_expr<AstTypeCastOp*>(expression))
+            {
+                this->write_header(NodeTag::TYPE_CAST, expression);
+                this->write_node(cast->get_value());
+                this->write_node(cast->get_target_type());
+            }
+            else if (cast_expr<AstVariadicArgReference*>(expression))
+            {
+                this->write_header(NodeTag::VARIADIC_ARG_REFERENCE, expression);
+            }
+            else if (auto* lambda = cast_expr<AstLambdaFunctionExpression*>(expression))
+            {
+                this->write_function(NodeTag::LAMBDA, lambda);
+            }
+            else if (auto* function = cast_expr<AstFunctionDeclaration*>(expression))
+            {
+                this->write_function(NodeTag::FUNCTION_DECLARATION, function);
+                this->write_generic_parameters(function->get_generic_parameters());
+            }
+            else
+            {
+                throw unserializable_node{};
+            }
+        }
+
+        void write_node(const IAstNode* const_node)
+        {
+            // Getters of the nodes aren't all const, but nothing is modified here
+            auto* node = const_cast<IAstNode*>(const_node);
+
+            if (node == nullptr)
+            {
+                this->_buffer.push_back(static_cast<char>(NodeTag::NONE));
+            }
+            else if (auto* type = cast_ast<IAstType*>(node))
+            {
+                this->write_type(type);
+            }
+            else if (auto* expression = cast_ast<IAstExpression*>(node))
+            {
+                this->write_expression(expression);
+            }
+            else if (const auto* block = cast_ast<AstBlock*>(node))
+            {
+                this->write_header(NodeTag::BLOCK, node);
+                this->write_nodes(block->get_children());
+            }
+            else if (auto* conditional = cast_ast<AstConditionalStatement*>(node))
+            {
+                this->write_header(NodeTag::CONDITIONAL, node);
+                this->write_node(conditional->get_condition());
+                this->write_node(conditional->get_body());
+                this->write_node(conditional->get_else_body());
+            }
+            else if (auto* for_loop = cast_ast<AstForLoop*>(node))
+            {
+                this->write_header(NodeTag::FOR_LOOP, node);
+                this->write_node(for_loop->get_initializer());
+                this->write_node(for_loop->get_condition());
+                this->write_node(for_loop->get_incrementor());
+                this->write_node(for_loop->get_body());
+            }
+            else if (auto* while_loop = cast_ast<AstWhileLoop*>(node))
+            {
+                this->write_header(NodeTag::WHILE_LOOP, node);
+                this->write_node(while_loop->get_condition());
+                this->write_node(while_loop->get_body());
+            }
+            else if (const auto* return_statement = cast_ast<AstReturnStatement*>(node))
+            {
+                this->write_header(NodeTag::RETURN, node);
+                const auto& value = return_statement->get_return_expression();
+                this->write_node(value.has_value() ? value->get() : nullptr);
+            }
+            else if (cast_ast<AstContinueStatement*>(node))
+            {
+                this->write_header(NodeTag::CONTINUE, node);
+            }
+            else if (cast_ast<AstBreakStatement*>(node))
+            {
+                this->write_header(NodeTag::BREAK, node);
+            }
+            else if (const auto* parameter = cast_ast<AstFunctionParameter*>(node))
+            {
+                this->write_header(NodeTag::FUNCTION_PARAMETER, node);
+                this->write_string(parameter->get_name());
+                this->write_node(parameter->get_type());
+            }
+            else if (const auto* type_definition = cast_ast<AstTypeDefinition*>(node))
+            {
+                this->write_header(NodeTag::TYPE_DEFINITION, node);
+                this->write_string(type_definition->get_name());
+                this->write_node(type_definition->get_type());
+                this->write_varint(static_cast<uint64_t>(type_definition->get_visibility()));
+                this->write_generic_parameters(type_definition->get_generic_parameters());
+            }
+            else if (const auto* enumerable = cast_ast<AstEnumerable*>(node))
+            {
+                this->write_header(NodeTag::ENUMERABLE, node);
+                this->write_string(enumerable->get_name());
+                this->write_nodes(enumerable->get_members());
+            }
+            else if (const auto* member = cast_ast<AstEnumerableMember*>(node))
+            {
+                this->write_header(NodeTag::ENUMERABLE_MEMBER, node);
+                this->write_string(member->get_name());
+                this->write_node(&member->value());
+            }
+            else if (auto* module = cast_ast<AstModule*>(node))
+            {
+                this->write_header(NodeTag::MODULE, node);
+                this->write_string(module->get_name());
+                this->write_node(module->get_body());
+            }
+            else if (const auto* import = cast_ast<AstImport*>(node))
+            {
+                this->write_header(NodeTag::IMPORT, node);
+                this->write_node(import->get_package_identifier());
+                this->write_nodes(import->get_import_list());
+            }
+            else if (const auto* package = cast_ast<AstPackage*>(node))
+            {
+                this->write_header(NodeTag::PACKAGE, node);
+                this->write_string(package->get_package_name());
+            }
+            else
+            {
+                throw unserializable_node{};
+            }
+        }
+    };
+
+    class AstReader
+    {
+        std::string_view _data;
+        size_t _position = 0;
+
+        std::shared_ptr<SourceFile> _source;
+        std::vector<std::shared_ptr<ParsingContext>> _contexts;
+
+    public:
+        AstReader(const std::string_view data, const std::shared_ptr<SourceFile>& source) :
+            _data(data),
+            _source(source) {}
+
+        std::unique_ptr<AstBlock> read_file(const uint64_t source_hash)
+        {
+            if (this->read_varint() != AST_FORMAT_MAGIC
+                || this->read_varint() != AST_FORMAT_VERSION
+                || this->read_varint() != source_hash
+                || this->read_varint() != this->_source->source.size())
+            {
+                return nullptr;
+            }
+
+            const auto context_count = this->read_count();
+            this->_contexts.reserve(context_count);
+            for (size_t i = 0; i < context_count; ++i)
+            {
+                const auto parent_id = this->read_varint();
+                if (parent_id > this->_contexts.size())
+                {
+                    throw malformed_entry{};
+                }
+
+                const auto type = this->read_enum(ContextType::CONTROL_FLOW);
+                const auto name = this->read_string();
+                auto parent = parent_id == 0 ? nullptr : this->_contexts[parent_id - 1];
+
+                this->_contexts.push_back(make_context(std::string(name), type, std::move(parent)));
+            }
+
+            for (const auto& context : this->_contexts)
+            {
+                this->read_definitions(*context);
+            }
+
+            auto root = this->read_required<AstBlock>();
+            if (this->_position != this->_data.size())
+            {
+                throw malformed_entry{};
+            }
+
+            return root;
+        }
+
+    private:
+        uint64_t read_varint()
+        {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                if (this->_position >= this->_data.size())
+                {
+                    throw malformed_entry{};
+                }
+
+                const auto byte = static_cast<uint8_t>(this->_data[this->_position++]);
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0)
+                {
+                    return value;
+                }
+            }
+
+            throw malformed_entry{};
+        }
+
+        int64_t read_signed()
+        {
+            const auto value = this->read_varint();
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        int read_flags()
+        {
+            return static_cast<int>(this->read_signed());
+        }
+
+        /// Reads a count of elements that each take at least one byte, so a corrupt count can't
+        /// make us reserve an absurd amount of memory.
+        size_t read_count()
+        {
+            const auto count = this->read_varint();
+            if (count > this->_data.size() - this->_position)
+            {
+                throw malformed_entry{};
+            }
+
+            return count;
+        }
+
+        std::string_view read_string()
+        {
+            const auto length = this->read_count();
+            const auto value = this->_data.substr(this->_position, length);
+            this->_position += length;
+
+            return value;
+        }
+
+        template <typename T>
+        T read_raw()
+        {
+            if (this->_data.size() - this->_position < sizeof(T))
+            {
+                throw malformed_entry{};
+            }
+
+            T value;
+            std::memcpy(&value, this->_data.data() + this->_position, sizeof(T));
+            this->_position += sizeof(T);
+
+            return value;
+        }
+
+        template <typename E>
+        E read_enum(const E last)
+        {
+            const auto value = this->read_varint();
+            if (value > static_cast<uint64_t>(last))
+            {
+                throw malformed_entry{};
+            }
+
+            return static_cast<E>(value);
+        }
+
+        const std::shared_ptr<ParsingContext>& read_context()
+        {
+            static const std::shared_ptr<ParsingContext> no_context;
+
+            const auto id = this->read_varint();
+            if (id > this->_contexts.size())
+            {
+                throw malformed_entry{};
+            }
+
+            return id == 0 ? no_context : this->_contexts[id - 1];
+        }
+
+        SourceFragment read_fragment()
+        {
+            const auto offset = this->read_varint();
+            const auto length = this->read_varint();
+
+            if (offset == 0)
+            {
+                return SourceFragment(nullptr, 0, length);
+            }
+
+            const auto source_size = this->_source->source.size();
+            if (offset - 1 > source_size || length > source_size - (offset - 1))
+            {
+                throw malformed_entry{};
+            }
+
+            return SourceFragment(this->_source, offset - 1, length);
+        }
+
+        Symbol read_symbol(const SourceFragment& position)
+        {
+            const auto name = this->read_string();
+            const auto internal_name = this->read_string();
+
+            return Symbol(position, "", std::string(name), std::string(internal_name));
+        }
+
+        GenericParameterList read_generic_parameters()
+        {
+            GenericParameterList parameters(this->read_count());
+            for (auto& parameter : parameters)
+            {
+                parameter = this->read_string();
+            }
+
+            return parameters;
+        }
+
+        std::optional<TokenSet> read_deferred_body()
+        {
+            const auto count = this->read_count();
+            if (count == 0)
+            {
+                return std::nullopt;
+            }
+
+            const auto source_size = this->_source->source.size();
+            std::vector<Token> tokens;
+            tokens.reserve(count);
+
+            size_t previous_end = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto type = this->read_enum(TokenType::BOOLEAN_LITERAL);
+                const auto gap = this->read_varint();
+                const auto length = this->read_varint();
+                const auto flags = this->read_varint();
+
+                if (gap > source_size - previous_end
+                    || length > source_size - previous_end - gap
+                    || flags > UINT8_MAX)
+                {
+                    throw malformed_entry{};
+                }
+
+                const auto offset = previous_end + gap;
+
+                // The unescaped values of string literals are kept by the file, rather than by their tokens
+                if (flags & SRFLAG_TOKEN_ESCAPED_LITERAL)
+                {
+                    if (type != TokenType::STRING_LITERAL || length < 2)
+                    {
+                        throw malformed_entry{};
+                    }
+
+                    this->_source->set_unescaped_literal(
+                        offset,
+                        tokenizer::escape_string(std::string(this->_source->source.substr(offset + 1, length - 2))));
+                }
+
+                tokens.emplace_back(type, this->_source->id, offset, length, static_cast<uint8_t>(flags));
+                previous_end = offset + length;
+            }
+
+            return TokenSet(this->_source, tokens);
+        }
+
+        void read_definitions(ParsingContext& context)
+        {
+            const auto count = this->read_count();
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto tag = this->read_raw<DefinitionTag>();
+
+                auto symbol_type = definition::SymbolType::CLASS;
+                std::unique_ptr<IAstType> type;
+                GenericParameterList generics;
+
+                switch (tag)
+                {
+                case DefinitionTag::SYMBOL:
+                    symbol_type = this->read_enum(definition::SymbolType::STRUCT_MEMBER);
+                    break;
+                case DefinitionTag::TYPE:
+                    type = this->read_required<IAstType>();
+                    generics = this->read_generic_parameters();
+                    break;
+                default:
+                    throw malformed_entry{};
+                }
+
+                const auto name = this->read_string();
+                const auto internal_name = this->read_string();
+                const auto position = this->read_fragment();
+                const auto symbol = Symbol(position, "", std::string(name), std::string(internal_name));
+                const auto visibility = this->read_enum(VisibilityModifier::PACKAGE_PUBLIC);
+
+                if (tag == DefinitionTag::SYMBOL)
+                {
+                    context.define(std::make_unique<definition::IdentifiableSymbolDef>(symbol_type, symbol));
+                }
+                else
+                {
+                    context.define(std::make_unique<definition::TypeDefinition>(
+                        symbol,
+                        std::move(type),
+                        std::move(generics),
+                        visibility));
+                }
+            }
+        }
+
+        template <typename T>
+        std::unique_ptr<T> read_optional()
+        {
+            auto node = this->read_node();
+            if (!node)
+            {
+                return nullptr;
+            }
+
+            auto* typed = dyn_cast<T*>(node.get());
+            if (typed == nullptr)
+            {
+                throw malformed_entry{};
+            }
+
+            node.release();
+            return std::unique_ptr<T>(typed);
+        }
+
+        template <typename T>
+        std::unique_ptr<T> read_required()
+        {
+            auto node = this->read_optional<T>();
+            if (!node)
+            {
+                throw malformed_entry{};
+            }
+
+            return node;
+        }
+
+        template <typename T>
+        std::vector<std::unique_ptr<T>> read_nodes()
+        {
+            std::vector<std::unique_ptr<T>> nodes(this->read_count());
+            for (auto& node : nodes)
+            {
+                node = this->read_required<T>();
+            }
+
+            return nodes;
+        }
+
+        template <typename T>
+        std::unique_ptr<T> read_binary_op(
+            const SourceFragment& source,
+            const std::shared_ptr<ParsingContext>& context,
+            const decltype(std::declval<T>().get_op_type()) last_op)
+        {
+            auto left = this->read_required<IAstExpression>();
+            const auto op = this->read_enum(last_op);
+            auto right = this->read_required<IAstExpression>();
+
+            return std::make_unique<T>(source, context, std::move(left), op, std::move(right));
+        }
+
+        template <typename T>
+        std::unique_ptr<IAstType> with_flags(std::unique_ptr<T> type)
+        {
+            type->set_flags(this->read_flags());
+            return type;
+        }
+
+        std::unique_ptr<IAstNode> read_node()
+        {
+            const auto tag = this->read_raw<NodeTag>();
+            if (tag == NodeTag::NONE)
+            {
+                return nullptr;
+            }
+
+            const auto source = this->read_fragment();
+            const auto& context = this->read_context();
+
+            switch (tag)
+            {
+            case NodeTag::BLOCK:
+                return std::make_unique<AstBlock>(source, context, this->read_nodes<IAstNode>());
+            case NodeTag::CONDITIONAL:
+            {
+                auto condition = this->read_required<IAstExpression>();
+                auto body = this->read_required<AstBlock>();
+                auto else_body = this->read_optional<AstBlock>();
+
+                return std::make_unique<AstConditionalStatement>(
+                    source,
+                    context,
+                    std::move(condition),
+                    std::move(body),
+                    std::move(else_body));
+            }
+            case NodeTag::CONTINUE:
+                return std::make_unique<AstContinueStatement>(source, context);
+            case NodeTag::BREAK:
+                return std::make_unique<AstBreakStatement>(source, context);
+            case NodeTag::ENUMERABLE:
+            {
+                auto name = std::string(this->read_string());
+                auto members = this->read_nodes<AstEnumerableMember>();
+
+                return std::make_unique<AstEnumerable>(source, context, std::move(members), std::move(name));
+            }
+            case NodeTag::ENUMERABLE_MEMBER:
+            {
+                auto name = std::string(this->read_string());
+                auto value = this->read_required<AstLiteral>();
+
+                return std::make_unique<AstEnumerableMember>(source, context, std::move(name), std::move(value));
+            }
+            case NodeTag::FOR_LOOP:
+            {
+                auto initializer = this->read_optional<IAstExpression>();
+                auto condition = this->read_optional<IAstExpression>();
+                auto incrementor = this->read_optional<IAstExpression>();
+                auto body = this->read_required<AstBlock>();
+
+                return std::make_unique<AstForLoop>(
+                    source,
+                    context,
+                    std::move(initializer),
+                    std::move(condition),
+                    std::move(incrementor),
+                    std::move(body));
+            }
+            case NodeTag::WHILE_LOOP:
+            {
+                auto condition = this->read_optional<IAstExpression>();
+                auto body = this->read_required<AstBlock>();
+
+                return std::make_unique<AstWhileLoop>(source, context, std::move(condition), std::move(body));
+            }
+            case NodeTag::IMPORT:
+            {
+                auto package = this->read_required<AstIdentifier>();
+                auto import_list = this->read_nodes<AstIdentifier>();
+
+                return std::make_unique<AstImport>(source, context, std::move(package), std::move(import_list));
+            }
+            case NodeTag::MODULE:
+            {
+                auto name = std::string(this->read_string());
+                auto body = this->read_required<AstBlock>();
+
+                return std::make_unique<AstModule>(source, context, std::move(name), std::move(body));
+            }
+            case NodeTag::PACKAGE:
+                return std::make_unique<AstPackage>(source, context, std::string(this->read_string()));
+            case NodeTag::RETURN:
+            {
+                std::optional<std::unique_ptr<IAstExpression>> value;
+                if (auto expression = this->read_optional<IAstExpression>())
+                {
+                    value = std::move(expression);
+                }
+
+                return std::make_unique<AstReturnStatement>(source, context, std::move(value));
+            }
+            case NodeTag::TYPE_DEFINITION:
+            {
+                auto name = std::string(this->read_string());
+                auto type = this->read_required<IAstType>();
+                const auto visibility = this->read_enum(VisibilityModifier::PACKAGE_PUBLIC);
+                auto generics = this->read_generic_parameters();
+
+                return std::make_unique<AstTypeDefinition>(
+                    source,
+                    context,
+                    std::move(name),
+                    std::move(type),
+                    visibility,
+                    std::move(generics));
+            }
+            case NodeTag::FUNCTION_PARAMETER:
+            {
+                auto name = std::string(this->read_string());
+                auto type = this->read_required<IAstType>();
+
+                return std::make_unique<AstFunctionParameter>(source, context, std::move(name), std::move(type));
+            }
+            case NodeTag::FUNCTION_DECLARATION:
+            case NodeTag::LAMBDA:
+            {
+                auto symbol = this->read_symbol(source);
+                auto parameters = this->read_nodes<AstFunctionParameter>();
+                auto body = this->read_optional<AstBlock>();
+                auto return_type = this->read_required<IAstType>();
+                const auto visibility = this->read_enum(VisibilityModifier::PACKAGE_PUBLIC);
+                const auto flags = this->read_flags();
+                auto deferred_body = this->read_deferred_body();
+
+                std::unique_ptr<IAstFunction> function;
+                if (tag == NodeTag::FUNCTION_DECLARATION)
+                {
+                    function = std::make_unique<AstFunctionDeclaration>(
+                        context,
+                        std::move(symbol),
+                        std::move(parameters),
+                        std::move(body),
+                        std::move(return_type),
+                        visibility,
+                        flags,
+                        this->read_generic_parameters());
+                }
+                else
+                {
+                    // Names of anonymous functions are only unique within the compilation that parsed them
+                    function = std::make_unique<AstLambdaFunctionExpression>(
+                        context,
+                        Symbol(source, ANONYMOUS_FN_PREFIX + std::to_string(next_unique_symbol_id())),
+                        std::move(parameters),
+                        std::move(body),
+                        std::move(return_type),
+                        visibility,
+                        flags);
+                }
+
+                if (deferred_body.has_value())
+                {
+                    function->defer_body(std::move(deferred_body.value()));
+                }
+
+                return function;
+            }
+            case NodeTag::ARRAY:
+                return std::make_unique<AstArray>(source, context, this->read_nodes<IAstExpression>());
+            case NodeTag::IDENTIFIER:
+                return std::make_unique<AstIdentifier>(context, this->read_symbol(source));
+            case NodeTag::ARRAY_MEMBER_ACCESSOR:
+            {
+                auto base = this->read_required<IAstExpression>();
+                auto index = this->read_required<IAstExpression>();
+
+                return std::make_unique<AstArrayMemberAccessor>(source, context, std::move(base), std::move(index));
+            }
+            case NodeTag::CHAINED_EXPRESSION:
+            {
+                auto base = this->read_required<IAstExpression>();
+                auto followup = this->read_required<IAstExpression>();
+
+                return std::make_unique<AstChainedExpression>(source, context, std::move(base), std::move(followup));
+            }
+            case NodeTag::INDIRECT_CALL:
+            {
+                auto callee = this->read_required<IAstExpression>();
+                auto arguments = this->read_nodes<IAstExpression>();
+
+                return std::make_unique<AstIndirectCall>(source, context, std::move(callee), std::move(arguments));
+            }
+            case NodeTag::FUNCTION_CALL:
+            {
+                auto identifier = this->read_required<AstIdentifier>();
+                auto arguments = this->read_nodes<IAstExpression>();
+                const auto flags = this->read_flags();
+
+                return std::make_unique<AstFunctionCall>(context, std::move(identifier), std::move(arguments), flags);
+            }
+            case NodeTag::VARIABLE_DECLARATION:
+            {
+                auto symbol = this->read_symbol(source);
+                auto annotated_type = this->read_optional<IAstType>();
+                auto initial_value = this->read_optional<IAstExpression>();
+                const auto visibility = this->read_enum(VisibilityModifier::PACKAGE_PUBLIC);
+                const auto flags = this->read_flags();
+
+                // Local variables are renamed, like parsing does, so they don't clash with other compilations
+                if (context && !context->is_global_scope())
+                {
+                    const std::string name = symbol.name;
+                    symbol = Symbol(
+                        source,
+                        context->get_name(),
+                        name,
+                        std::format("{}.{}", name, next_unique_symbol_id()));
+                }
+
+                std::optional<std::unique_ptr<IAstType>> variable_type;
+                if (annotated_type)
+                {
+                    variable_type = std::move(annotated_type);
+                }
+
+                return std::make_unique<AstVariableDeclaration>(
+                    context,
+                    std::move(symbol),
+                    std::move(variable_type),
+                    std::move(initial_value),
+                    visibility,
+                    flags);
+            }
+            case NodeTag::BINARY_ARITHMETIC_OP:
+                return this->read_binary_op<AstBinaryArithmeticOp>(source, context, BinaryOpType::POWER);
+            case NodeTag::LOGICAL_OP:
+                return this->read_binary_op<AstLogicalOp>(source, context, LogicalOpType::OR);
+            case NodeTag::COMPARISON_OP:
+                return this->read_binary_op<AstComparisonOp>(
+                    source,
+                    context,
+                    ComparisonOpType::GREATER_THAN_OR_EQUAL);
+            case NodeTag::UNARY_OP:
+            {
+                const auto op = this->read_enum(UnaryOpType::DEREFERENCE);
+                auto operand = this->read_required<IAstExpression>();
+
+                return std::make_unique<AstUnaryOp>(source, context, op, std::move(operand));
+            }
+            case NodeTag::VARIABLE_REASSIGNMENT:
+            {
+                auto identifier = this->read_required<AstIdentifier>();
+                const auto op = this->read_enum(MutativeAssignmentType::BITWISE_XOR);
+                auto value = this->read_required<IAstExpression>();
+
+                return std::make_unique<AstVariableReassignment>(
+                    source,
+                    context,
+                    std::move(identifier),
+                    op,
+                    std::move(value));
+            }
+            case NodeTag::OBJECT_INITIALIZER:
+            {
+                auto name = std::string(this->read_string());
+
+                std::vector<StructMemberInitializerPair> initializers(this->read_count());
+                for (auto& [member_name, value] : initializers)
+                {
+                    member_name = this->read_string();
+                    value = this->read_required<IAstExpression>();
+                }
+
+                auto generics = this->read_nodes<IAstType>();
+
+                return std::make_unique<AstObjectInitializer>(
+                    source,
+                    context,
+                    std::move(name),
+                    std::move(initializers),
+                    std::move(generics));
+            }
+            case NodeTag::VARIADIC_ARG_REFERENCE:
+                return std::make_unique<AstVariadicArgReference>(source, context);
+            case NodeTag::TUPLE_INITIALIZER:
+                return std::make_unique<AstTupleInitializer>(source, context, this->read_nodes<IAstExpression>());
+            case NodeTag::TYPE_CAST:
+            {
+                auto value = this->read_required<IAstExpression>();
+                auto target_type = this->read_required<IAstType>();
+
+                return std::make_unique<AstTypeCastOp>(source, context, std::move(value), std::move(target_type));
+            }
+            case NodeTag::STRING_LITERAL:
+                return std::make_unique<AstStringLiteral>(source, context, std::string(this->read_string()));
+            case NodeTag::INT_LITERAL:
+            {
+                const auto type = this->read_enum(PrimitiveType::NIL);
+                const auto value = this->read_signed();
+                const auto flags = this->read_flags();
+
+                return std::make_unique<AstIntLiteral>(source, context, type, value, flags);
+            }
+            case NodeTag::FP_LITERAL:
+            {
+                const auto type = this->read_enum(PrimitiveType::NIL);
+
+                return std::make_unique<AstFpLiteral>(source, context, type, this->read_raw<long double>());
+            }
+            case NodeTag::BOOLEAN_LITERAL:
+                return std::make_unique<AstBooleanLiteral>(source, context, this->read_varint() != 0);
+            case NodeTag::CHAR_LITERAL:
+                return std::make_unique<AstCharLiteral>(source, context, this->read_raw<char>());
+            case NodeTag::NIL_LITERAL:
+                return std::make_unique<AstNilLiteral>(source, context);
+            case NodeTag::PRIMITIVE_TYPE:
+            {
+                const auto type = this->read_enum(PrimitiveType::NIL);
+
+                return this->with_flags(std::make_unique<AstPrimitiveType>(source, context, type));
+            }
+            case NodeTag::ALIAS_TYPE:
+            {
+                auto name = std::string(this->read_string());
+                auto generics = this->read_nodes<IAstType>();
+
+                return this->with_flags(
+                    std::make_unique<AstAliasType>(source, context, std::move(name), SRFLAG_NONE, std::move(generics)));
+            }
+            case NodeTag::FUNCTION_TYPE:
+            {
+                auto parameters = this->read_nodes<IAstType>();
+                auto return_type = this->read_required<IAstType>();
+
+                return this->with_flags(
+                    std::make_unique<AstFunctionType>(source, context, std::move(parameters), std::move(return_type)));
+            }
+            case NodeTag::ARRAY_TYPE:
+            {
+                auto element_type = this->read_required<IAstType>();
+                const auto initial_length = this->read_varint();
+
+                return this->with_flags(
+                    std::make_unique<AstArrayType>(source, context, std::move(element_type), initial_length));
+            }
+            case NodeTag::OBJECT_TYPE:
+            {
+                auto name = std::string(this->read_string());
+
+                ObjectTypeMemberList members(this->read_count());
+                for (auto& [member_name, member_type] : members)
+                {
+                    member_name = this->read_string();
+                    member_type = this->read_required<IAstType>();
+                }
+
+                auto generics = this->read_nodes<IAstType>();
+
+                return this->with_flags(
+                    std::make_unique<AstObjectType>(
+                        source,
+                        context,
+                        std::move(name),
+                        std::move(members),
+                        SRFLAG_NONE,
+                        std::move(generics)));
+            }
+            case NodeTag::TUPLE_TYPE:
+                return this->with_flags(
+                    std::make_unique<AstTupleType>(source, context, this->read_nodes<IAstType>()));
+            default:
+                throw malformed_entry{};
+            }
+        }
+    };
+
+    std::optional<std::string> serialize_ast(AstBlock* root, const SourceFile& source, const uint64_t source_hash)
+    {
+        try
+        {
+            return AstWriter(&source).write_file(root, source_hash);
+        }
+        catch (const unserializable_node&)
+        {
+            return std::nullopt;
+        }
+    }
+
+    std::unique_ptr<AstBlock> deserialize_ast(
+        const std::string_view data,
+        const std::shared_ptr<SourceFile>& source,
+        const uint64_t source_hash)
+    {
+        try
+        {
+            return AstReader(data, source).read_file(source_hash);
+        }
+        catch (const malformed_entry&)
+        {
+            return nullptr;
+        }
+    }
+
+    /// Id of the running process, as thread ids repeat across processes.
+    unsigned long get_process_id()
+    {
+#if CSTRIDE_HAS_MMAP
+        return static_cast<unsigned long>(getpid());
+#else
+        return static_cast<unsigned long>(_getpid());
+#endif
+    }
+
+    /// Contents of a cache entry, memory-mapped where possible.
+    class CacheEntry
+    {
+        std::string_view _data;
+        std::string _owned_data;
+        void* _mapped_data = nullptr;
+
+    public:
+        explicit CacheEntry(const std::filesystem::path& path)
+        {
+#if CSTRIDE_HAS_MMAP
+            const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return;
+            }
+
+            struct stat file_stat{};
+            if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0)
+            {
+                const auto length = static_cast<size_t>(file_stat.st_size);
+                if (void* data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0); data != MAP_FAILED)
+                {
+                    this->_mapped_data = data;
+                    this->_data = std::string_view(static_cast<const char*>(data), length);
+                }
+            }
+
+            close(fd);
+#else
+            std::ifstream file(path, std::ios::binary);
+            this->_owned_data.assign(std::istreambuf_iterator(file), std::istreambuf_iterator<char>());
+            this->_data = this->_owned_data;
+#endif
+        }
+
+        ~CacheEntry()
+        {
+#if CSTRIDE_HAS_MMAP
+            if (this->_mapped_data != nullptr)
+            {
+                munmap(this->_mapped_data, this->_data.size());
+            }
+#endif
+        }
+
+        CacheEntry(const CacheEntry&) = delete;
+        CacheEntry& operator=(const CacheEntry&) = delete;
+
+        [[nodiscard]]
+        std::string_view get_data() const
+        {
+            return this->_data;
+        }
+    };
+}
+
+uint64_t stride::ast::hash_source(const std::string_view source)
+{
+    // 64-bit FNV-1a
+    uint64_t hash = 0xcbf29ce484222325;
+    for (const auto character : source)
+    {
+        hash ^= static_cast<uint8_t>(character);
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+std::optional<std::string> stride::ast::serialize_ast(AstBlock* root)
+{
+    const auto& source = root->get_source();
+    if (!source)
+    {
+        return std::nullopt;
+    }
+
+    return ::serialize_ast(root, *source, hash_source(source->source));
+}
+
+std::unique_ptr<AstBlock> stride::ast::deserialize_ast(
+    const std::string_view data,
+    const std::shared_ptr<SourceFile>& source)
+{
+    return ::deserialize_ast(data, source, hash_source(source->source));
+}
+
+AstCache::AstCache(std::filesystem::path directory) :
+    _directory(std::move(directory))
+{
+    std::error_code error;
+    std::filesystem::create_directories(this->_directory, error);
+}
+
+std::filesystem::path AstCache::get_entry_path(const uint64_t source_hash, const bool lazy_function_bodies) const
+{
+    return this->_directory / std::format("{:016x}{}.sast", source_hash, lazy_function_bodies ? ".lazy" : "");
+}
+
+std::unique_ptr<AstBlock> AstCache::load(
+    const std::shared_ptr<SourceFile>& source,
+    const bool lazy_function_bodies
+) const
+{
+    const auto source_hash = hash_source(source->source);
+    const CacheEntry entry(this->get_entry_path(source_hash, lazy_function_bodies));
+
+    if (entry.get_data().empty())
+    {
+        return nullptr;
+    }
+
+    return ::deserialize_ast(entry.get_data(), source, source_hash);
+}
+
+void AstCache::store(const SourceFile& source, AstBlock* root, const bool lazy_function_bodies) const
+{
+    const auto source_hash = hash_source(source.source);
+    const auto data = ::serialize_ast(root, source, source_hash);
+    if (!data.has_value())
+    {
+        return;
+    }
+
+    // Entries are written to a temporary file first, so that concurrent compilations never see
+    // a partially written entry. Its name is unique to the writing process and thread.
+    const auto path = this->get_entry_path(source_hash, lazy_function_bodies);
+    auto temporary_path = path;
+    temporary_path += std::format(
+        ".{}.{}.tmp",
+        get_process_id(),
+        std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        if (!file.write(data->data(), static_cast<std::streamsize>(data->size())))
+        {
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error)
+    {
+        std::filesystem::remove(temporary_path, error);
+    }
+}
@@ -0,0 +1,271 @@
+#include "ast/tokens/scanner.h"
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CSTRIDE_SCANNER_X86 1
+#include <immintrin.h>
+#else
+#define CSTRIDE_SCANNER_X86 0
+#endif
+
+using namespace stride::ast::scanner;
+
+static bool is_whitespace(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/*
+ * Scalar implementations
+ *
+ * These are the reference for the vectorized ones, and handle the tails that are too short
+ * for a full vector.
+ */
+
+static size_t skip_whitespace_scalar(const std::string_view src, size_t index)
+{
+    while (index < src.size() && is_whitespace(src[index]))
+    {
+        ++index;
+    }
+    return index;
+}
+
+static size_t find_line_end_scalar(const std::string_view src, size_t index)
+{
+    while (index < src.size() && src[index] != '\n')
+    {
+        ++index;
+    }
+    return index;
+}
+
+static size_t find_block_comment_end_scalar(const std::string_view src, size_t index)
+{
+    for (; index + 1 < src.size(); ++index)
+    {
+        if (src[index] == '*' && src[index + 1] == '/')
+        {
+            return index;
+        }
+    }
+    return std::string_view::npos;
+}
+
+static size_t find_string_end_scalar(const std::string_view src, size_t index)
+{
+    while (index < src.size() && src[index] != '"')
+    {
+        index += src[index] == '\\' ? 2 : 1;
+    }
+    return index;
+}
+
+/*
+ * Vectorized implementations
+ *
+ * Every function compares a whole block against the characters of interest, turns the result
+ * into a bit mask (one bit per byte) and continues at the lowest set bit. Blocks never read past
+ * the end of the source; whatever remains is handed to the scalar implementation.
+ */
+
+#if CSTRIDE_SCANNER_X86
+
+#define CSTRIDE_SCANNER_DEFINE_ISA(NAME, TARGET, VEC, WIDTH, LOAD, SET1, CMPEQ, OR, AND, MOVEMASK)                        \
+    __attribute__((target(TARGET))) static size_t skip_whitespace_##NAME(const std::string_view src, size_t index)       \
+    {                                                                                                                    \
+        const auto space = SET1(' '), tab = SET1('\t'), newline = SET1('\n'), carriage_return = SET1('\r');             \
+        while (index + WIDTH <= src.size())                                                                              \
+        {                                                                                                                \
+            const VEC block = LOAD(reinterpret_cast<const VEC*>(src.data() + index));                                    \
+            const VEC matches = OR(OR(CMPEQ(block, space), CMPEQ(block, tab)),                                           \
+                                   OR(CMPEQ(block, newline), CMPEQ(block, carriage_return)));                            \
+            const auto non_whitespace = ~static_cast<uint32_t>(MOVEMASK(matches)) & mask_of_width(WIDTH);                 \
+            if (non_whitespace != 0)                                                                                     \
+            {                                                                                                            \
+                return index + std::countr_zero(non_whitespace);                                                         \
+            }                                                                                                            \
+            index += WIDTH;                                                                                              \
+        }                                                                                                                \
+        return skip_whitespace_scalar(src, index);                                                                       \
+    }                                                                                                                    \
+                                                                                                                         \
+    __attribute__((target(TARGET))) static size_t find_line_end_##NAME(const std::string_view src, size_t index)         \
+    {                                                                                                                    \
+        const auto newline = SET1('\n');                                                                                 \
+        while (index + WIDTH <= src.size())                                                                              \
+        {                                                                                                                \
+            const VEC block = LOAD(reinterpret_cast<const VEC*>(src.data() + index));                                    \
+            if (const auto found = static_cast<uint32_t>(MOVEMASK(CMPEQ(block, newline))); found != 0)                   \
+            {                                                                                                            \
+                return index + std::countr_zero(found);                                                                  \
+            }                                                                                                            \
+            index += WIDTH;                                                                                              \
+        }                                                                                                                \
+        return find_line_end_scalar(src, index);                                                                         \
+    }                                                                                                                    \
+                                                                                                                         \
+    __attribute__((target(TARGET))) static size_t find_block_comment_end_##NAME(                                         \
+        const std::string_view src, size_t index)                                                                        \
+    {                                                                                                                    \
+        const auto star = SET1('*'), slash = SET1('/');                                                                  \
+        /* Compares each block against `*`, and the same block shifted by one byte against `/` */                        \
+        while (index + WIDTH + 1 <= src.size())                                                                          \
+        {                                                                                                                \
+            const VEC current = LOAD(reinterpret_cast<const VEC*>(src.data() + index));                                  \
+            const VEC next = LOAD(reinterpret_cast<const VEC*>(src.data() + index + 1));                                 \
+            if (const auto found = static_cast<uint32_t>(MOVEMASK(AND(CMPEQ(current, star), CMPEQ(next, slash))));       \
+                found != 0)                                                                                              \
+            {                                                                                                            \
+                return index + std::countr_zero(found);                                                                  \
+            }                                                                                                            \
+            index += WIDTH;                                                                                              \
+        }                                                                                                                \
+        return find_block_comment_end_scalar(src, index);                                                               \
+    }                                                                                                                    \
+                                                                                                                         \
+    __attribute__((target(TARGET))) static size_t find_string_end_##NAME(const std::string_view src, size_t index)       \
+    {                                                                                                                    \
+        const auto quote = SET1('"'), backslash = SET1('\\');                                                            \
+        while (index + WIDTH <= src.size())                                                                              \
+        {                                                                                                                \
+            const VEC block = LOAD(reinterpret_cast<const VEC*>(src.data() + index));                                    \
+            const auto found = static_cast<uint32_t>(MOVEMASK(OR(CMPEQ(block, quote), CMPEQ(block, backslash))));       \
+            if (found == 0)                                                                                              \
+            {                                                                                                            \
+                index += WIDTH;                                                                                          \
+                continue;                                                                                                \
+            }                                                                                                            \
+            index += std::countr_zero(found);                                                                            \
+            if (src[index] == '"')                                                                                       \
+            {                                                                                                            \
+                return index;                                                                                            \
+            }                                                                                                            \
+            /* Skip the backslash and whatever character it escapes */                                                   \
+            index += 2;                                                                                                  \
+        }                                                                                                                \
+        return find_string_end_scalar(src, index);                                                                       \
+    }
+
+static constexpr uint32_t mask_of_width(const size_t width)
+{
+    return width >= 32 ? 0xFFFFFFFFu : (1u << width) - 1;
+}
+
+CSTRIDE_SCANNER_DEFINE_ISA(
+    sse2, "sse2", __m128i, 16,
+    _mm_loadu_si128, _mm_set1_epi8, _mm_cmpeq_epi8, _mm_or_si128, _mm_and_si128, _mm_movemask_epi8)
+
+CSTRIDE_SCANNER_DEFINE_ISA(
+    avx2, "avx2", __m256i, 32,
+    _mm256_loadu_si256, _mm256_set1_epi8, _mm256_cmpeq_epi8, _mm256_or_si256, _mm256_and_si256, _mm256_movemask_epi8)
+
+#undef CSTRIDE_SCANNER_DEFINE_ISA
+
+#endif
+
+static constexpr Scanner SCALAR_SCANNER = {
+    ScannerIsa::SCALAR,
+    skip_whitespace_scalar,
+    find_line_end_scalar,
+    find_block_comment_end_scalar,
+    find_string_end_scalar
+};
+
+#if CSTRIDE_SCANNER_X86
+static constexpr Scanner SSE2_SCANNER = {
+    ScannerIsa::SSE2,
+    skip_whitespace_sse2,
+    find_line_end_sse2,
+    find_block_comment_end_sse2,
+    find_string_end_sse2
+};
+
+static constexpr Scanner AVX2_SCANNER = {
+    ScannerIsa::AVX2,
+    skip_whitespace_avx2,
+    find_line_end_avx2,
+    find_block_comment_end_avx2,
+    find_string_end_avx2
+};
+#endif
+
+static bool is_supported(const ScannerIsa isa)
+{
+    switch (isa)
+    {
+    case ScannerIsa::SCALAR:
+        return true;
+#if CSTRIDE_SCANNER_X86
+    case ScannerIsa::SSE2:
+        return __builtin_cpu_supports("sse2");
+    case ScannerIsa::AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+static const Scanner* select_scanner()
+{
+    const auto isas = supported_isas();
+    return &get_scanner(isas.back());
+}
+
+static std::atomic<const Scanner*> active_scanner = nullptr;
+
+const Scanner& stride::ast::scanner::get_scanner()
+{
+    const auto* scanner = active_scanner.load(std::memory_order_acquire);
+    if (scanner == nullptr)
+    {
+        // Racing threads all select the same scanner, so there's no need to synchronize this
+        scanner = select_scanner();
+        active_scanner.store(scanner, std::memory_order_release);
+    }
+    return *scanner;
+}
+
+const Scanner& stride::ast::scanner::get_scanner(const ScannerIsa isa)
+{
+    if (!is_supported(isa))
+    {
+        throw std::invalid_argument("Scanner instruction set is not supported by this CPU");
+    }
+
+    switch (isa)
+    {
+#if CSTRIDE_SCANNER_X86
+    case ScannerIsa::SSE2:
+        return SSE2_SCANNER;
+    case ScannerIsa::AVX2:
+        return AVX2_SCANNER;
+#endif
+    case ScannerIsa::SCALAR:
+    default:
+        return SCALAR_SCANNER;
+    }
+}
+
+std::vector<ScannerIsa> stride::ast::scanner::supported_isas()
+{
+    std::vector<ScannerIsa> isas;
+    for (const auto isa : { ScannerIsa::SCALAR, ScannerIsa::SSE2, ScannerIsa::AVX2 })
+    {
+        if (is_supported(isa))
+        {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+void stride::ast::scanner::force_isa(const ScannerIsa isa)
+{
+    active_scanner.store(&get_scanner(isa), std::memory_order_release);
+}
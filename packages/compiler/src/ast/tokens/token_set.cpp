@@ -6,10 +6,88 @@
 
 #include "errors.h"
 
+#include <array>
 #include <format>
+#include <optional>
 
 using namespace stride::ast;
 
+namespace
+{
+    enum BracketKind
+    {
+        BRACKET_PAREN,
+        BRACKET_BRACE,
+        BRACKET_SQUARE,
+        BRACKET_KIND_COUNT
+    };
+
+    /// Returns the bracket kind of the token, and whether it opens a region.
+    std::optional<std::pair<BracketKind, bool>> get_bracket(const TokenType type)
+    {
+        switch (type)
+        {
+        case TokenType::LPAREN: return std::pair{ BRACKET_PAREN, true };
+        case TokenType::RPAREN: return std::pair{ BRACKET_PAREN, false };
+        case TokenType::LBRACE: return std::pair{ BRACKET_BRACE, true };
+        case TokenType::RBRACE: return std::pair{ BRACKET_BRACE, false };
+        case TokenType::LSQUARE_BRACKET: return std::pair{ BRACKET_SQUARE, true };
+        case TokenType::RSQUARE_BRACKET: return std::pair{ BRACKET_SQUARE, false };
+        default: return std::nullopt;
+        }
+    }
+}
+
+TokenSet::TokenSet(
+    std::shared_ptr<SourceFile> source,
+    std::vector<Token>& tokens
+) :
+    _begin(0),
+    _end(static_cast<int64_t>(tokens.size())),
+    _cursor(0)
+{
+    auto buffer = std::make_shared<TokenBuffer>();
+    buffer->source = std::move(source);
+    buffer->tokens = std::move(tokens);
+    buffer->closing_brackets.assign(buffer->tokens.size(), -1);
+
+    // Bracket kinds are matched independently of each other, so that `collect_block_variant`
+    // can jump straight to the end of a region instead of scanning it on every nesting level.
+    std::array<std::vector<int64_t>, BRACKET_KIND_COUNT> open_brackets;
+
+    for (int64_t i = 0; i < this->_end; ++i)
+    {
+        const auto bracket = get_bracket(buffer->tokens[i].get_type());
+        if (!bracket.has_value())
+        {
+            continue;
+        }
+
+        auto& stack = open_brackets[bracket->first];
+        if (bracket->second)
+        {
+            stack.push_back(i);
+        }
+        else if (!stack.empty())
+        {
+            buffer->closing_brackets[stack.back()] = i;
+            stack.pop_back();
+        }
+    }
+
+    this->_buffer = std::move(buffer);
+}
+
+TokenSet::TokenSet(
+    std::shared_ptr<const TokenBuffer> buffer,
+    const int64_t begin,
+    const int64_t end
+) :
+    _buffer(std::move(buffer)),
+    _begin(begin),
+    _end(end),
+    _cursor(0) {}
+
 TokenSet TokenSet::create_subset(const int64_t offset,
                                  const int64_t length) const
 {
@@ -19,36 +97,48 @@ TokenSet TokenSet::create_subset(const int64_t offset,
         start > end ||
         end >= this->size())
     {
-        throw std::out_of_range("Invalid range for TokenSet copy");
+        throw std::out_of_range("Invalid range for TokenSet subset");
     }
 
-    std::vector copied_tokens(
-        this->_tokens.begin() + offset,
-        this->_tokens.begin() + offset + length);
+    return TokenSet(this->_buffer, this->_begin + offset, this->_begin + offset + length);
+}
+
+int64_t TokenSet::find_closing_bracket(const int64_t index) const
+{
+    if (index < 0 || index >= this->size())
+    {
+        return -1;
+    }
 
-    return std::move(TokenSet(this->_source, copied_tokens));
+    const auto closing = this->_buffer->closing_brackets[this->_begin + index];
+    if (closing < 0 || closing >= this->_end)
+    {
+        return -1;
+    }
+
+    return closing - this->_begin;
 }
 
-Token TokenSet::last() const
+const Token& TokenSet::last() const
 {
     if (this->size() == 0)
     {
         return END_OF_FILE;
     }
-    return this->_tokens.back();
+    return this->_buffer->tokens[this->_end - 1];
 }
 
-Token TokenSet::at(const int64_t index) const
+const Token& TokenSet::at(const int64_t index) const
 {
     if (this->size() == 0 || this->remaining() == 0 || index < 0 || index >= this->size())
     {
         return END_OF_FILE;
     }
 
-    return this->_tokens[index];
+    return this->_buffer->tokens[this->_begin + index];
 }
 
-Token TokenSet::peek(const int64_t offset) const
+const Token& TokenSet::peek(const int64_t offset) const
 {
     return this->at(this->position() + offset);
 }
@@ -58,7 +148,7 @@ TokenType TokenSet::peek_next_type() const
     return this->peek_next().get_type();
 }
 
-Token TokenSet::peek_next() const
+const Token& TokenSet::peek_next() const
 {
     return this->at(this->position());
 }
@@ -78,7 +168,7 @@ void TokenSet::skip(const int64_t amount)
     this->_cursor += amount;
 }
 
-Token TokenSet::expect(const TokenType type)
+const Token& TokenSet::expect(const TokenType type)
 {
     if (!this->has_next())
     {
@@ -107,7 +197,7 @@ Token TokenSet::expect(const TokenType type)
     return this->next();
 }
 
-Token TokenSet::expect(const TokenType type, const std::string& message)
+const Token& TokenSet::expect(const TokenType type, const std::string& message)
 {
     if (!this->has_next())
     {
@@ -130,18 +220,18 @@ Token TokenSet::expect(const TokenType type, const std::string& message)
     return this->next();
 }
 
-Token TokenSet::next()
+const Token& TokenSet::next()
 {
     if (this->remaining() == 0)
     {
         return END_OF_FILE;
     }
-    return this->_tokens[this->_cursor++];
+    return this->_buffer->tokens[this->_begin + this->_cursor++];
 }
 
 int64_t TokenSet::size() const
 {
-    return this->_size;
+    return this->_end - this->_begin;
 }
 
 int64_t TokenSet::position() const
@@ -161,7 +251,12 @@ bool TokenSet::has_next() const
 
 std::shared_ptr<stride::SourceFile> TokenSet::get_source() const
 {
-    return this->_source;
+    return this->_buffer->source;
+}
+
+std::span<const Token> TokenSet::get_tokens() const
+{
+    return std::span(this->_buffer->tokens).subspan(this->_begin, this->_end - this->_begin);
 }
 
 [[noreturn]] void TokenSet::throw_error(
@@ -1,25 +1,9 @@
 #include "ast/tokens/token.h"
 
-#include <algorithm>
-
 using namespace stride::ast;
 
-
-// Operator precedence is defined from highest to lowest
-std::vector stride::ast::operatorPrecedence = {
-    TokenType::STAR,
-    TokenType::SLASH,
-    TokenType::PLUS,
-    TokenType::MINUS,
-};
-
-bool stride::ast::precedes(const TokenType lhs, const TokenType rhs)
-{
-    return std::ranges::find(operatorPrecedence, lhs) < std::ranges::find(
-        operatorPrecedence,
-        rhs);
-}
-
+// Reference definition of the token grammar, used by the regex lexer backend.
+// The state machine lexer in tokenizer.cpp implements the same language; keep both in sync.
 std::vector<TokenDefinition> stride::ast::tokenTypes = {
     // Comments (should be matched first)
     TOKEN(TokenType::COMMENT, R"(//[^\n]*)"),
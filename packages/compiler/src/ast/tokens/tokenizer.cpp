@@ -2,9 +2,14 @@
 
 #include "errors.h"
 #include "files.h"
+#include "ast/interner.h"
+#include "ast/tokens/keywords.h"
+#include "ast/tokens/scanner.h"
 #include "ast/tokens/token_set.h"
 
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <string_view>
 
 using namespace stride::ast;
 
@@ -20,15 +25,34 @@ bool should_ignore_token_type(const TokenType type)
     }
 }
 
-TokenSet tokenizer::tokenize(const std::shared_ptr<SourceFile>& source_file)
+/// Emits a string literal token spanning `length` characters from the opening quote at `start`.
+/// Only literals containing escape sequences have their unescaped value materialized.
+static void emit_string_literal(
+    std::vector<Token>& tokens,
+    stride::SourceFile& source_file,
+    const size_t start,
+    const size_t length)
+{
+    const auto raw_value = source_file.source.substr(start + 1, length - 2);
+    uint8_t flags = SRFLAG_NONE;
+
+    if (raw_value.find('\\') != std::string_view::npos)
+    {
+        source_file.set_unescaped_literal(start, tokenizer::escape_string(std::string(raw_value)));
+        flags |= SRFLAG_TOKEN_ESCAPED_LITERAL;
+    }
+
+    tokens.emplace_back(TokenType::STRING_LITERAL, source_file.id, start, length, flags);
+}
+
+static TokenSet tokenize_regex(const std::shared_ptr<stride::SourceFile>& source_file)
 {
     auto tokens = std::vector<Token>();
 
-    const auto src = source_file->source;
+    const std::string_view src = source_file->source;
 
     bool is_string = false;
     size_t string_start = 0;
-    std::ostringstream string_stream;
 
     for (std::size_t i = 0; i < src.length();)
     // Note: `i` is incremented manually
@@ -54,16 +78,8 @@ TokenSet tokenizer::tokenize(const std::shared_ptr<SourceFile>& source_file)
                 // If there's an odd number of backslashes, the quote is escaped.
                 if (backslash_count % 2 == 0)
                 {
-                    size_t length = i - string_start;
-                    std::string raw_val = src.substr(string_start, length);
-                    std::string val = escape_string(raw_val);
-
-                    tokens.emplace_back(
-                        TokenType::STRING_LITERAL,
-                        SourceFragment(source_file,
-                                       string_start - 1,
-                                       length + 2),
-                        val);
+                    const size_t length = i - string_start;
+                    emit_string_literal(tokens, *source_file, string_start - 1, length + 2);
 
                     is_string = false;
                 }
@@ -82,7 +98,7 @@ TokenSet tokenizer::tokenize(const std::shared_ptr<SourceFile>& source_file)
             continue;
         }
 
-        if (isWhitespace(src[i]))
+        if (tokenizer::isWhitespace(src[i]))
         {
             i++;
             continue;
@@ -92,28 +108,25 @@ TokenSet tokenizer::tokenize(const std::shared_ptr<SourceFile>& source_file)
         for (const auto& tokenDefinition : tokenTypes)
         {
             // Define the search range starting from the current index i
-            const auto searchStart = src.cbegin() + i;
-            const auto searchEnd = src.cend();
+            const auto searchStart = src.data() + i;
+            const auto searchEnd = src.data() + src.size();
 
             // Use match_continuous to ensure the regex matches exactly at searchStart
-            if (std::smatch match; std::regex_search(
+            if (std::cmatch match; std::regex_search(
                 searchStart,
                 searchEnd,
                 match,
                 tokenDefinition.pattern,
                 std::regex_constants::match_continuous))
             {
-                std::string lexeme = match.str(0);
+                const auto length = static_cast<size_t>(match.length(0));
 
                 if (!should_ignore_token_type(tokenDefinition.type))
                 {
-                    tokens.emplace_back(
-                        tokenDefinition.type,
-                        SourceFragment(source_file, i, lexeme.length()),
-                        lexeme);
+                    tokens.emplace_back(tokenDefinition.type, source_file->id, i, length);
                 }
 
-                i += lexeme.length();
+                i += length;
                 matched = true;
                 break;
             }
@@ -121,16 +134,536 @@ TokenSet tokenizer::tokenize(const std::shared_ptr<SourceFile>& source_file)
 
         if (!matched)
         {
-            throw parsing_error(
-                ErrorType::SYNTAX_ERROR,
+            throw stride::parsing_error(
+                stride::ErrorType::SYNTAX_ERROR,
                 "Unexpected character encountered",
-                SourceFragment(source_file, i, 1));
+                stride::SourceFragment(source_file, i, 1));
+        }
+    }
+
+    return TokenSet(source_file, tokens);
+}
+
+/*
+ * State machine lexer
+ *
+ * Every byte is classified once through `CHAR_CLASSES`, after which the lexer dispatches on the
+ * first character of a token and consumes it in a single forward pass. Keywords are scanned as
+ * plain words and then resolved through the compile-time perfect hash in keywords.h.
+ * Whitespace, comments and string bodies are skipped in bulk through the scanner in scanner.h.
+ *
+ * The accepted language is exactly that of the regex table in token_types.cpp; any divergence
+ * between the two backends is a bug.
+ */
+
+enum CharClass : uint8_t
+{
+    CC_NONE         = 0x0,
+    CC_WHITESPACE   = 0x1,
+    CC_DIGIT        = 0x2,
+    CC_HEX_DIGIT    = 0x4,
+    CC_WORD         = 0x8,  // [a-zA-Z0-9_], the characters `\b` considers part of a word
+    CC_IDENT_START  = 0x10, // [$a-zA-Z_]
+    CC_IDENT        = 0x20, // [$a-zA-Z0-9_]
+};
+
+static constexpr auto CHAR_CLASSES = []
+{
+    std::array<uint8_t, 256> table{};
+
+    for (const unsigned char c : { ' ', '\t', '\n', '\r' })
+    {
+        table[c] |= CC_WHITESPACE;
+    }
+
+    for (unsigned char c = '0'; c <= '9'; ++c)
+    {
+        table[c] |= CC_DIGIT | CC_HEX_DIGIT | CC_WORD | CC_IDENT;
+    }
+
+    for (unsigned char c = 'a'; c <= 'z'; ++c)
+    {
+        table[c] |= CC_WORD | CC_IDENT_START | CC_IDENT;
+        table[c - 'a' + 'A'] |= CC_WORD | CC_IDENT_START | CC_IDENT;
+    }
+
+    for (unsigned char c = 'a'; c <= 'f'; ++c)
+    {
+        table[c] |= CC_HEX_DIGIT;
+        table[c - 'a' + 'A'] |= CC_HEX_DIGIT;
+    }
+
+    table['_'] |= CC_WORD | CC_IDENT_START | CC_IDENT;
+    table['$'] |= CC_IDENT_START | CC_IDENT;
+
+    return table;
+}();
+
+static bool has_class(const std::string_view src, const size_t index, const uint8_t char_class)
+{
+    return index < src.size() && (CHAR_CLASSES[static_cast<uint8_t>(src[index])] & char_class) != 0;
+}
+
+static bool char_at_eq(const std::string_view src, const size_t index, const char c)
+{
+    return index < src.size() && src[index] == c;
+}
+
+static size_t skip_class(const std::string_view src, size_t index, const uint8_t char_class)
+{
+    while (has_class(src, index, char_class))
+    {
+        ++index;
+    }
+    return index;
+}
+
+/// Scans a numeric literal starting at `start`, which is either a digit, or a `.` followed by a digit.
+/// Mirrors the ordering of the numeric patterns in `tokenTypes`: hex, double, float, long, integer.
+static size_t scan_number(const std::string_view src, const size_t start, TokenType& type)
+{
+    // \b0x[0-9a-fA-F]+\b
+    if (char_at_eq(src, start, '0') && char_at_eq(src, start + 1, 'x') && has_class(src, start + 2, CC_HEX_DIGIT))
+    {
+        if (const auto end = skip_class(src, start + 2, CC_HEX_DIGIT);
+            !has_class(src, end, CC_WORD))
+        {
+            type = TokenType::HEX_LITERAL;
+            return end - start;
+        }
+    }
+
+    const auto integer_end = skip_class(src, start, CC_DIGIT);
+    const bool has_integer_part = integer_end > start;
+    const bool has_fraction = char_at_eq(src, integer_end, '.') && has_class(src, integer_end + 1, CC_DIGIT);
+    const auto fraction_end = has_fraction ? skip_class(src, integer_end + 1, CC_DIGIT) : integer_end;
+
+    const auto is_double_suffix = [&](const size_t index)
+    {
+        return char_at_eq(src, index, 'd') || char_at_eq(src, index, 'D');
+    };
+
+    // (\d+|(\d*\.\d+))[dD]
+    if (has_integer_part && is_double_suffix(integer_end))
+    {
+        type = TokenType::DOUBLE_LITERAL;
+        return integer_end + 1 - start;
+    }
+    if (has_fraction && is_double_suffix(fraction_end))
+    {
+        type = TokenType::DOUBLE_LITERAL;
+        return fraction_end + 1 - start;
+    }
+
+    // \d*\.\d+
+    if (has_fraction)
+    {
+        type = TokenType::FLOAT_LITERAL;
+        return fraction_end - start;
+    }
+
+    // \d+[lL]
+    if (char_at_eq(src, integer_end, 'l') || char_at_eq(src, integer_end, 'L'))
+    {
+        type = TokenType::LONG_INTEGER_LITERAL;
+        return integer_end + 1 - start;
+    }
+
+    type = TokenType::INTEGER_LITERAL;
+    return integer_end - start;
+}
+
+/// Scans a character literal, `'([^'\\]|\\.)'`. Returns 0 if there is no valid literal at `start`.
+static size_t scan_char_literal(const std::string_view src, const size_t start)
+{
+    if (start + 2 >= src.size())
+    {
+        return 0;
+    }
+
+    if (const char c = src[start + 1]; c != '\'' && c != '\\')
+    {
+        return src[start + 2] == '\'' ? 3 : 0;
+    }
+
+    // Escaped character; `.` doesn't match line terminators
+    if (src[start + 1] == '\\'
+        && src[start + 2] != '\n'
+        && src[start + 2] != '\r'
+        && char_at_eq(src, start + 3, '\''))
+    {
+        return 4;
+    }
+
+    return 0;
+}
+
+/// Scans an operator or punctuation token. Multi-character operators take precedence over
+/// their single-character prefixes. Returns 0 if the character doesn't start an operator.
+static size_t scan_operator(const std::string_view src, const size_t start, TokenType& type)
+{
+    const auto next_is = [&](const size_t offset, const char c)
+    {
+        return char_at_eq(src, start + offset, c);
+    };
+
+    const auto select = [&](const TokenType token_type, const size_t length)
+    {
+        type = token_type;
+        return length;
+    };
+
+    switch (src[start])
+    {
+    case '*':
+        if (next_is(1, '*'))
+        {
+            return next_is(2, '=')
+                ? select(TokenType::DOUBLE_ASTERISK_EQ, 3)
+                : select(TokenType::DOUBLE_STAR, 2);
+        }
+        return next_is(1, '=') ? select(TokenType::STAR_EQUALS, 2) : select(TokenType::STAR, 1);
+    case '<':
+        if (next_is(1, '<') && next_is(2, '='))
+            return select(TokenType::DOUBLE_LT_EQ, 3);
+        if (next_is(1, '='))
+            return select(TokenType::LEQUALS, 2);
+        if (next_is(1, '-'))
+            return select(TokenType::LARROW, 2);
+        return select(TokenType::LT, 1);
+    case '>':
+        if (next_is(1, '>') && next_is(2, '='))
+            return select(TokenType::DOUBLE_GT_EQ, 3);
+        return next_is(1, '=') ? select(TokenType::GEQUALS, 2) : select(TokenType::GT, 1);
+    case '/':
+        return next_is(1, '=') ? select(TokenType::SLASH_EQUALS, 2) : select(TokenType::SLASH, 1);
+    case '%':
+        return next_is(1, '=') ? select(TokenType::PERCENT_EQUALS, 2) : select(TokenType::PERCENT, 1);
+    case '+':
+        if (next_is(1, '='))
+            return select(TokenType::PLUS_EQUALS, 2);
+        return next_is(1, '+') ? select(TokenType::DOUBLE_PLUS, 2) : select(TokenType::PLUS, 1);
+    case '-':
+        if (next_is(1, '='))
+            return select(TokenType::MINUS_EQUALS, 2);
+        if (next_is(1, '-'))
+            return select(TokenType::DOUBLE_MINUS, 2);
+        return next_is(1, '>') ? select(TokenType::RARROW, 2) : select(TokenType::MINUS, 1);
+    case '&':
+        if (next_is(1, '='))
+            return select(TokenType::AMPERSAND_EQUALS, 2);
+        return next_is(1, '&') ? select(TokenType::DOUBLE_AMPERSAND, 2) : select(TokenType::AMPERSAND, 1);
+    case '|':
+        if (next_is(1, '='))
+            return select(TokenType::PIPE_EQUALS, 2);
+        return next_is(1, '|') ? select(TokenType::DOUBLE_PIPE, 2) : select(TokenType::PIPE, 1);
+    case '^':
+        return next_is(1, '=') ? select(TokenType::CARET_EQUALS, 2) : select(TokenType::CARET, 1);
+    case '~':
+        return next_is(1, '=') ? select(TokenType::TILDE_EQUALS, 2) : select(TokenType::TILDE, 1);
+    case '!':
+        return next_is(1, '=') ? select(TokenType::BANG_EQUALS, 2) : select(TokenType::BANG, 1);
+    case '=':
+        return next_is(1, '=') ? select(TokenType::DOUBLE_EQUALS, 2) : select(TokenType::EQUALS, 1);
+    case ':':
+        return next_is(1, ':') ? select(TokenType::DOUBLE_COLON, 2) : select(TokenType::COLON, 1);
+    case '.':
+        if (next_is(1, '.') && next_is(2, '.'))
+            return select(TokenType::THREE_DOTS, 3);
+        return select(TokenType::DOT, 1);
+    case '?':
+        return select(TokenType::QUESTION, 1);
+    case '(':
+        return select(TokenType::LPAREN, 1);
+    case ')':
+        return select(TokenType::RPAREN, 1);
+    case '{':
+        return select(TokenType::LBRACE, 1);
+    case '}':
+        return select(TokenType::RBRACE, 1);
+    case '[':
+        return select(TokenType::LSQUARE_BRACKET, 1);
+    case ']':
+        return select(TokenType::RSQUARE_BRACKET, 1);
+    case ',':
+        return select(TokenType::COMMA, 1);
+    case ';':
+        return select(TokenType::SEMICOLON, 1);
+    default:
+        return 0;
+    }
+}
+
+/// Lexes the source from `start`, which must not lie inside a token or comment, appending to `tokens`.
+/// Before every token, comment or run of whitespace, `should_stop` is asked whether to stop at that position.
+/// Returns the position lexing stopped at, or the size of the source if it ran to the end.
+template <typename StopCondition>
+static size_t lex_state_machine(
+    std::vector<Token>& tokens,
+    const std::shared_ptr<stride::SourceFile>& source_file,
+    const size_t start,
+    StopCondition should_stop)
+{
+    const std::string_view src = source_file->source;
+
+    const auto emit = [&](const TokenType type, const size_t token_start, const size_t length)
+    {
+        tokens.emplace_back(type, source_file->id, token_start, length);
+    };
+
+    const auto& scanner = scanner::get_scanner();
+
+    for (size_t i = start; i < src.size();)
+    {
+        if (should_stop(i))
+        {
+            return i;
+        }
+
+        const char c = src[i];
+
+        if (has_class(src, i, CC_WHITESPACE))
+        {
+            i = scanner.skip_whitespace(src, i + 1);
+            continue;
+        }
+
+        // Strings are matched up to the first unescaped quote. Unterminated strings are dropped,
+        // just like the regex backend does.
+        if (c == '"')
+        {
+            const size_t end = scanner.find_string_end(src, i + 1);
+
+            if (end >= src.size())
+            {
+                return src.size();
+            }
+
+            emit_string_literal(tokens, *source_file, i, end - i + 1);
+
+            i = end + 1;
+            continue;
+        }
+
+        if (c == '/' && char_at_eq(src, i + 1, '/'))
+        {
+            i = scanner.find_line_end(src, i + 2);
+            continue;
+        }
+
+        if (c == '/' && char_at_eq(src, i + 1, '*'))
+        {
+            // An unterminated block comment is lexed as regular operators instead
+            if (const auto comment_end = scanner.find_block_comment_end(src, i + 2);
+                comment_end != std::string_view::npos)
+            {
+                i = comment_end + 2;
+                continue;
+            }
+        }
+
+        if (has_class(src, i, CC_IDENT_START))
+        {
+            // Keywords only match if the whole word (without `$`) equals the keyword
+            const auto word_end = skip_class(src, i, CC_WORD);
+
+            if (const auto keyword = keywords::lookup(src.substr(i, word_end - i)))
+            {
+                emit(keyword.value(), i, word_end - i);
+                i = word_end;
+                continue;
+            }
+
+            const auto identifier_end = skip_class(src, word_end, CC_IDENT);
+
+            // Populate the interner up front, so the parser only hits its read path for names
+            interner::intern(src.substr(i, identifier_end - i));
+
+            emit(TokenType::IDENTIFIER, i, identifier_end - i);
+            i = identifier_end;
+            continue;
         }
+
+        if (has_class(src, i, CC_DIGIT) || (c == '.' && has_class(src, i + 1, CC_DIGIT)))
+        {
+            TokenType type;
+            const auto length = scan_number(src, i, type);
+            emit(type, i, length);
+            i += length;
+            continue;
+        }
+
+        if (c == '\'')
+        {
+            if (const auto length = scan_char_literal(src, i); length > 0)
+            {
+                emit(TokenType::CHAR_LITERAL, i, length);
+                i += length;
+                continue;
+            }
+        }
+        else
+        {
+            TokenType type;
+            if (const auto length = scan_operator(src, i, type); length > 0)
+            {
+                emit(type, i, length);
+                i += length;
+                continue;
+            }
+        }
+
+        throw stride::parsing_error(
+            stride::ErrorType::SYNTAX_ERROR,
+            "Unexpected character encountered",
+            stride::SourceFragment(source_file, i, 1));
     }
 
+    return src.size();
+}
+
+static TokenSet tokenize_state_machine(const std::shared_ptr<stride::SourceFile>& source_file)
+{
+    auto tokens = std::vector<Token>();
+
+    // Rough estimate to avoid most reallocations; the average token is a couple of characters long.
+    tokens.reserve(source_file->source.size() / 4);
+
+    lex_state_machine(tokens, source_file, 0, [](size_t) { return false; });
+
     return TokenSet(source_file, tokens);
 }
 
+TokenSet tokenizer::tokenize(const std::shared_ptr<SourceFile>& source_file, const LexerBackend backend)
+{
+    switch (backend)
+    {
+    case LexerBackend::REGEX:
+        return tokenize_regex(source_file);
+    case LexerBackend::STATE_MACHINE:
+    default:
+        return tokenize_state_machine(source_file);
+    }
+}
+
+/*
+ * Incremental lexing
+ *
+ * The state machine carries no state from one token to the next, so lexing can resume anywhere
+ * no token or comment is in progress. Tokens are kept up to the point the edit can't have
+ * influenced. The edited region is then lexed again, until the lexer arrives at the start of a
+ * token that existed before the edit, in the unchanged remainder of the file. Lexing that token
+ * and everything after it would produce the previous tokens again, moved by the length difference
+ * of the edit, so those are copied instead.
+ */
+tokenizer::RetokenizedSet tokenizer::retokenize(
+    const TokenSet& previous,
+    const std::shared_ptr<SourceFile>& source_file,
+    const SourceEdit& edit)
+{
+    const auto previous_tokens = previous.get_tokens();
+    const auto previous_file = previous.get_source();
+    const auto previous_count = static_cast<int64_t>(previous_tokens.size());
+
+    const auto token_end = [](const Token& token)
+    {
+        return token.get_offset() + token.get_length();
+    };
+
+    // Deciding where a token ends may involve looking ahead up to the end of the token after it,
+    // e.g. for `0` in `0xyz`, so a token is only kept if its successor ends before the edit as well.
+    const auto ends_before_edit = std::ranges::partition_point(
+        previous_tokens,
+        [&](const Token& token)
+        {
+            return token_end(token) < edit.offset;
+        }) - previous_tokens.begin();
+
+    int64_t kept = std::max<int64_t>(ends_before_edit - 1, 0);
+
+    // An unterminated block comment is lexed as `/` followed by `*`. Terminating it anywhere
+    // after its start turns every token up to there into a comment.
+    for (int64_t i = 0; i < kept; ++i)
+    {
+        if (const auto& token = previous_tokens[i];
+            token.get_type() == TokenType::SLASH && char_at_eq(previous_file->source, token.get_offset() + 1, '*'))
+        {
+            kept = i;
+            break;
+        }
+    }
+
+    std::vector<Token> tokens;
+    tokens.reserve(previous_tokens.size() + edit.replacement.size() / 4 + 1);
+
+    const auto carry_over = [&](const Token& token, const size_t offset)
+    {
+        if (token.get_flags() & SRFLAG_TOKEN_ESCAPED_LITERAL)
+        {
+            source_file->set_unescaped_literal(
+                offset,
+                std::string(previous_file->get_unescaped_literal(token.get_offset())));
+        }
+        tokens.emplace_back(token.get_type(), source_file->id, offset, token.get_length(), token.get_flags());
+    };
+
+    for (int64_t i = 0; i < kept; ++i)
+    {
+        carry_over(previous_tokens[i], previous_tokens[i].get_offset());
+    }
+
+    const size_t resume_offset = kept > 0 ? token_end(previous_tokens[kept - 1]) : 0;
+
+    // Previous tokens that may be lined up with, i.e. those after the replaced range
+    auto candidate = std::ranges::partition_point(
+        previous_tokens,
+        [&](const Token& token)
+        {
+            return token.get_offset() < edit.removed_end();
+        }) - previous_tokens.begin();
+
+    int64_t synchronized = previous_count;
+
+    lex_state_machine(
+        tokens,
+        source_file,
+        resume_offset,
+        [&](const size_t position)
+        {
+            if (position < edit.inserted_end())
+            {
+                return false;
+            }
+
+            const auto previous_position = position - edit.inserted_end() + edit.removed_end();
+            while (candidate < previous_count && previous_tokens[candidate].get_offset() < previous_position)
+            {
+                ++candidate;
+            }
+
+            if (candidate < previous_count && previous_tokens[candidate].get_offset() == previous_position)
+            {
+                synchronized = candidate;
+                return true;
+            }
+            return false;
+        });
+
+    const auto damage_end = static_cast<int64_t>(tokens.size());
+
+    for (auto i = synchronized; i < previous_count; ++i)
+    {
+        carry_over(previous_tokens[i], previous_tokens[i].get_offset() + edit.delta());
+    }
+
+    return {
+        .tokens = TokenSet(source_file, tokens),
+        .damage_begin = kept,
+        .damage_end = damage_end,
+        .previous_damage_end = synchronized
+    };
+}
+
 // This allows one to type `\0` in a string and have it actually
 // result in a null character, instead of two separate characters. (`\` and `0`)
 std::string tokenizer::escape_string(const std::string& raw_string)
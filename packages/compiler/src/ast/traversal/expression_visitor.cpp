@@ -1,3 +1,4 @@
+#include "ast/casting.h"
 #include "ast/parsing_context.h"
 #include "ast/type_inference.h"
 #include "ast/visitor.h"
@@ -11,7 +12,7 @@ void ExpressionVisitor::accept(IAstExpression* expr)
 
     // --- Variable declaration: register the resolved type in the local context
     // so that subsequent expressions in the same scope can look up the variable.
-    if (const auto* var_decl = dynamic_cast<AstVariableDeclaration*>(expr))
+    if (const auto* var_decl = cast_expr<AstVariableDeclaration*>(expr))
     {
         // Use the initial value's type (already set by bottom-up traversal) as the
         // canonical type registered in context, which is what identifier lookups rely on.
@@ -1,3 +1,4 @@
+#include "ast/casting.h"
 #include "ast/parsing_context.h"
 #include "ast/type_inference.h"
 #include "ast/visitor.h"
@@ -24,7 +25,7 @@ void FunctionVisitor::accept(IAstFunction* fn_declaration)
     }
 
     // Forward declare the function in the symbol registry
-    if (dynamic_cast<AstFunctionDeclaration*>(fn_declaration))
+    if (cast_expr<AstFunctionDeclaration*>(fn_declaration))
     {
         fn_declaration->get_context()->define_function(
             fn_declaration->get_symbol(),
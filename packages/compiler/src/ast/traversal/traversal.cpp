@@ -34,85 +34,129 @@ void AstNodeTraverser::visit_expression(IVisitor* visitor, IAstExpression* node)
     if (!node)
         return;
 
-    // IAstFunction is an expression but needs special handling (body traversal + params)
-    if (auto* fn = cast_expr<IAstFunction*>(node))
+    // Dispatch on the kind of the node; without a default case, the compiler warns about unhandled kinds
+    switch (node->get_kind())
     {
+    case AstNodeKind::FUNCTION:
+    case AstNodeKind::FUNCTION_DECLARATION:
+    case AstNodeKind::LAMBDA_FUNCTION_EXPRESSION:
+    {
+        // IAstFunction is an expression but needs special handling (body traversal + params)
+        auto* fn = cast<IAstFunction*>(node);
         visitor->accept(fn);
         visit_block(visitor, fn->get_body());
+        break;
     }
-    else if (const auto* binary = cast_expr<IBinaryOp*>(node))
+    case AstNodeKind::BINARY_ARITHMETIC_OP:
+    case AstNodeKind::LOGICAL_OP:
+    case AstNodeKind::COMPARISON_OP:
     {
+        const auto* binary = cast<IBinaryOp*>(node);
         visit_expression(visitor, binary->get_left());
         visit_expression(visitor, binary->get_right());
+        break;
     }
-    else if (const auto* unary = cast_expr<AstUnaryOp*>(node))
-    {
-        visit_expression(visitor, &unary->get_operand());
-    }
-    else if (const auto* var_decl = cast_expr<AstVariableDeclaration*>(node))
+    case AstNodeKind::UNARY_OP:
+        visit_expression(visitor, &cast<AstUnaryOp*>(node)->get_operand());
+        break;
+    case AstNodeKind::VARIABLE_DECLARATION:
     {
+        const auto* var_decl = cast<AstVariableDeclaration*>(node);
         if (var_decl->get_initial_value())
             visit_expression(visitor, var_decl->get_initial_value());
+        break;
     }
-    else if (const auto* fn_call = cast_expr<AstFunctionCall*>(node))
-    {
-        for (const auto& arg : fn_call->get_arguments())
+    case AstNodeKind::FUNCTION_CALL:
+        for (const auto& arg : cast<AstFunctionCall*>(node)->get_arguments())
             visit_expression(visitor, arg.get());
-    }
-    else if (const auto* array = cast_expr<AstArray*>(node))
-    {
-        for (const auto& elem : array->get_elements())
+        break;
+    case AstNodeKind::ARRAY:
+        for (const auto& elem : cast<AstArray*>(node)->get_elements())
             visit_expression(visitor, elem.get());
-    }
-    else if (const auto* array_accessor = cast_expr<AstArrayMemberAccessor*>(node))
+        break;
+    case AstNodeKind::ARRAY_MEMBER_ACCESSOR:
     {
+        const auto* array_accessor = cast<AstArrayMemberAccessor*>(node);
         visit_expression(visitor, array_accessor->get_array_base());
         visit_expression(visitor, array_accessor->get_index());
+        break;
     }
-    else if (const auto* struct_init = cast_expr<AstObjectInitializer*>(node))
-    {
-        for (const auto& val : struct_init->get_initializers() | std::views::values)
+    case AstNodeKind::OBJECT_INITIALIZER:
+        for (const auto& val : cast<AstObjectInitializer*>(node)->get_initializers() | std::views::values)
             visit_expression(visitor, val.get());
-    }
-    else if (const auto* tuple_init = cast_expr<AstTupleInitializer*>(node))
-    {
-        for (const auto& member : tuple_init->get_members())
+        break;
+    case AstNodeKind::TUPLE_INITIALIZER:
+        for (const auto& member : cast<AstTupleInitializer*>(node)->get_members())
             visit_expression(visitor, member.get());
-    }
-    else if (const auto* reassign = cast_expr<AstVariableReassignment*>(node))
+        break;
+    case AstNodeKind::VARIABLE_REASSIGNMENT:
     {
+        const auto* reassign = cast<AstVariableReassignment*>(node);
         visit_expression(visitor, reassign->get_identifier());
         visit_expression(visitor, reassign->get_value());
+        break;
     }
-    else if (const auto* chained = cast_expr<AstChainedExpression*>(node))
-    {
+    case AstNodeKind::CHAINED_EXPRESSION:
         // Visit the base expression so its type is resolved before the accessor's type is inferred.
-        visit_expression(visitor, chained->get_base());
+        visit_expression(visitor, cast<AstChainedExpression*>(node)->get_base());
         // visit_expression(visitor, chained->get_followup());
-    }
-    else if (auto* function_node = cast_expr<IAstFunction*>(node))
-    {
-        visit_block(visitor, function_node->get_body());
-        visitor->accept(function_node);
-    }
-    else if (auto* type_cast = cast_expr<AstTypeCastOp*>(node))
+        break;
+    case AstNodeKind::TYPE_CAST_OP:
     {
+        auto* type_cast = cast<AstTypeCastOp*>(node);
         visit_expression(visitor, type_cast->get_value());
         visitor->accept(type_cast);
+        break;
     }
-    else if (auto* indirect_call = cast_expr<AstIndirectCall*>(node))
+    case AstNodeKind::INDIRECT_CALL:
     {
+        auto* indirect_call = cast<AstIndirectCall*>(node);
         for (const auto& arg : indirect_call->get_args())
         {
             visit_expression(visitor, arg.get());
         }
         visit_expression(visitor, indirect_call->get_callee());
         visitor->accept(indirect_call);
+        break;
+    }
+
+    // Leaf nodes, no children
+    case AstNodeKind::IDENTIFIER:
+    case AstNodeKind::VARIADIC_ARG_REFERENCE:
+    case AstNodeKind::STRING_LITERAL:
+    case AstNodeKind::INT_LITERAL:
+    case AstNodeKind::FP_LITERAL:
+    case AstNodeKind::BOOLEAN_LITERAL:
+    case AstNodeKind::CHAR_LITERAL:
+    case AstNodeKind::NIL_LITERAL:
+        break;
+
+    // Not expressions
+    case AstNodeKind::PRIMITIVE_TYPE:
+    case AstNodeKind::ALIAS_TYPE:
+    case AstNodeKind::FUNCTION_TYPE:
+    case AstNodeKind::ARRAY_TYPE:
+    case AstNodeKind::OBJECT_TYPE:
+    case AstNodeKind::TUPLE_TYPE:
+    case AstNodeKind::CONTINUE_STATEMENT:
+    case AstNodeKind::BREAK_STATEMENT:
+    case AstNodeKind::FUNCTION_PARAMETER:
+    case AstNodeKind::BLOCK:
+    case AstNodeKind::CONDITIONAL_STATEMENT:
+    case AstNodeKind::SWITCH_BRANCH:
+    case AstNodeKind::SWITCH:
+    case AstNodeKind::WHILE_LOOP:
+    case AstNodeKind::FOR_LOOP:
+    case AstNodeKind::RETURN_STATEMENT:
+    case AstNodeKind::IMPORT:
+    case AstNodeKind::PACKAGE:
+    case AstNodeKind::MODULE:
+    case AstNodeKind::TYPE_DEFINITION:
+    case AstNodeKind::ENUMERABLE_MEMBER:
+    case AstNodeKind::ENUMERABLE:
+        break;
     }
 
-    // AstLiteral, AstIdentifier, AstVariadicArgReference,
-    // AstArrayMemberAccessor (base/index already handled above) — leaf nodes, no children.
-
     visitor->accept(node);
 }
 
@@ -161,44 +205,38 @@ void AstNodeTraverser::visit(IVisitor* visitor, IAstNode* node)
 
     // Mainly statement parsing here
 
-    if (auto* conditional = dynamic_cast<AstConditionalStatement*>(node))
-    {
-        visit_conditional_statement(visitor, conditional);
-    }
-    else if (auto* while_loop = dynamic_cast<AstWhileLoop*>(node))
-    {
-        visit_while_loop(visitor, while_loop);
-    }
-    else if (auto* for_loop = dynamic_cast<AstForLoop*>(node))
-    {
-        visit_for_loop(visitor, for_loop);
-    }
-    else if (const auto* return_stmt = dynamic_cast<AstReturnStatement*>(node))
-    {
-        visit_return_statement(visitor, return_stmt);
-    }
-    else if (auto* module = dynamic_cast<AstModule*>(node))
-    {
-        visit_block(visitor, module->get_body());
-    }
-    else if (const auto* block = dynamic_cast<AstBlock*>(node))
-    {
-        visit_block(visitor, block);
-    }
-    else if (auto* expr = dynamic_cast<IAstExpression*>(node))
-    {
-        visit_expression(visitor, expr);
-    }
-    else if (auto* variable_declaration = dynamic_cast<AstVariableDeclaration*>(node))
-    {
-        visit_variable_declaration(visitor, variable_declaration);
-    }
-    else if (auto* import_node = dynamic_cast<AstImport*>(node))
-    {
-        visitor->accept(import_node);
-    }
-    else if (auto* package_node = dynamic_cast<AstPackage*>(node))
-    {
-        visitor->accept(package_node);
+    switch (node->get_kind())
+    {
+    case AstNodeKind::CONDITIONAL_STATEMENT:
+        visit_conditional_statement(visitor, cast<AstConditionalStatement*>(node));
+        break;
+    case AstNodeKind::WHILE_LOOP:
+        visit_while_loop(visitor, cast<AstWhileLoop*>(node));
+        break;
+    case AstNodeKind::FOR_LOOP:
+        visit_for_loop(visitor, cast<AstForLoop*>(node));
+        break;
+    case AstNodeKind::RETURN_STATEMENT:
+        visit_return_statement(visitor, cast<AstReturnStatement*>(node));
+        break;
+    case AstNodeKind::MODULE:
+        visit_block(visitor, cast<AstModule*>(node)->get_body());
+        break;
+    case AstNodeKind::BLOCK:
+        visit_block(visitor, cast<AstBlock*>(node));
+        break;
+    case AstNodeKind::IMPORT:
+        visitor->accept(cast<AstImport*>(node));
+        break;
+    case AstNodeKind::PACKAGE:
+        visitor->accept(cast<AstPackage*>(node));
+        break;
+    default:
+        // Variable declarations are expressions as well, their initial value is visited as an expression
+        if (auto* expr = dyn_cast<IAstExpression*>(node))
+        {
+            visit_expression(visitor, expr);
+        }
+        break;
     }
 }
@@ -0,0 +1,232 @@
+#include "ast/visitor_pipeline.h"
+
+#include "errors.h"
+#include "ast/arena.h"
+#include "ast/nodes/blocks.h"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <optional>
+#include <stdexcept>
+
+using namespace stride::ast;
+
+void CompositeVisitor::begin_file(const std::string& file_name, AstBlock* root)
+{
+    for (auto* visitor : this->_visitors)
+    {
+        visitor->begin_file(file_name, root);
+    }
+}
+
+void CompositeVisitor::accept(IAstExpression* expr)
+{
+    for (auto* visitor : this->_visitors)
+    {
+        visitor->accept(expr);
+    }
+}
+
+void CompositeVisitor::accept(IAstFunction* fn)
+{
+    for (auto* visitor : this->_visitors)
+    {
+        visitor->accept(fn);
+    }
+}
+
+void CompositeVisitor::accept(AstImport* node)
+{
+    for (auto* visitor : this->_visitors)
+    {
+        visitor->accept(node);
+    }
+}
+
+void CompositeVisitor::accept(AstPackage* node)
+{
+    for (auto* visitor : this->_visitors)
+    {
+        visitor->accept(node);
+    }
+}
+
+VisitorPipeline::Pass& VisitorPipeline::get_pass(const IVisitor* visitor)
+{
+    const auto it = std::ranges::find(this->_passes, visitor, &Pass::visitor);
+    if (it == this->_passes.end())
+    {
+        throw std::invalid_argument("Visitor has not been added to the pipeline");
+    }
+    return *it;
+}
+
+void VisitorPipeline::add(IVisitor* visitor, const std::vector<const IVisitor*>& dependencies)
+{
+    if (std::ranges::find(this->_passes, visitor, &Pass::visitor) != this->_passes.end())
+    {
+        throw std::invalid_argument("Visitor has already been added to the pipeline");
+    }
+
+    // The earliest phase after all dependencies are complete
+    size_t phase = 0;
+    for (const auto* dependency : dependencies)
+    {
+        phase = std::max(phase, this->get_pass(dependency).phase + 1);
+    }
+
+    this->_passes.push_back({ .visitor = visitor, .phase = phase, .completion_actions = {}, .file_actions = {} });
+}
+
+void VisitorPipeline::on_complete(const IVisitor* visitor, std::function<void()> action)
+{
+    this->get_pass(visitor).completion_actions.push_back(std::move(action));
+}
+
+void VisitorPipeline::on_file_complete(
+    const IVisitor* visitor,
+    std::function<void(const std::string& file_name, AstBlock* root)> action)
+{
+    this->get_pass(visitor).file_actions.push_back(std::move(action));
+}
+
+std::vector<std::vector<IVisitor*>> VisitorPipeline::get_phases() const
+{
+    std::vector<std::vector<IVisitor*>> phases;
+    for (const auto& pass : this->_passes)
+    {
+        if (pass.phase >= phases.size())
+        {
+            phases.resize(pass.phase + 1);
+        }
+        phases[pass.phase].push_back(pass.visitor);
+    }
+    return phases;
+}
+
+void VisitorPipeline::run_phases(const std::vector<std::pair<std::string, AstBlock*>>& files, ThreadPool* pool)
+{
+    const auto phases = this->get_phases();
+    for (size_t phase = 0; phase < phases.size(); ++phase)
+    {
+        CompositeVisitor composite(phases[phase]);
+        IVisitor* visitor = phases[phase].size() == 1
+                                ? phases[phase].front()
+                                : static_cast<IVisitor*>(&composite);
+
+        std::vector<const Pass*> phase_passes;
+        for (const auto& pass : this->_passes)
+        {
+            if (pass.phase == phase)
+            {
+                phase_passes.push_back(&pass);
+            }
+        }
+
+        const auto visit_file = [&](const std::string& file_name, AstBlock* root)
+        {
+            AstNodeTraverser traverser;
+            visitor->begin_file(file_name, root);
+            traverser.visit_block(visitor, root);
+
+            for (const auto* pass : phase_passes)
+            {
+                for (const auto& action : pass->file_actions)
+                {
+                    action(file_name, root);
+                }
+            }
+        };
+
+        const bool is_concurrent = pool != nullptr
+            && files.size() > 1
+            && std::ranges::all_of(phases[phase], &IVisitor::is_thread_safe);
+
+        if (is_concurrent)
+        {
+            std::vector<std::future<void>> futures;
+            futures.reserve(files.size());
+
+            for (const auto& [file_name, root] : files)
+            {
+                futures.push_back(
+                    pool->submit(
+                        [&visit_file, &file_name, root, arena = AstArena::current()]
+                        {
+                            // Nodes created while visiting live in the arena of the caller
+                            std::optional<AstArena::Scope> arena_scope;
+                            if (arena != nullptr)
+                            {
+                                arena_scope.emplace(*arena);
+                            }
+                            visit_file(file_name, root);
+                        }
+                    )
+                );
+            }
+
+            // Every task has to finish before the errors are reported, as they refer to the visitors
+            std::vector<std::exception_ptr> errors;
+            for (auto& future : futures)
+            {
+                try
+                {
+                    pool->wait(future);
+                }
+                catch (...)
+                {
+                    errors.push_back(std::current_exception());
+                }
+            }
+
+            if (!errors.empty())
+            {
+                stride::rethrow_sorted_errors(std::move(errors));
+            }
+        }
+        else
+        {
+            for (const auto& [file_name, root] : files)
+            {
+                visit_file(file_name, root);
+            }
+        }
+
+        for (const auto* pass : phase_passes)
+        {
+            for (const auto& action : pass->completion_actions)
+            {
+                action();
+            }
+        }
+    }
+}
+
+static std::vector<std::pair<std::string, AstBlock*>> get_roots(
+    const std::map<std::string, std::unique_ptr<AstBlock>>& files)
+{
+    std::vector<std::pair<std::string, AstBlock*>> roots;
+    roots.reserve(files.size());
+
+    for (const auto& [file_name, root] : files)
+    {
+        roots.emplace_back(file_name, root.get());
+    }
+    return roots;
+}
+
+void VisitorPipeline::run(const std::map<std::string, std::unique_ptr<AstBlock>>& files)
+{
+    this->run_phases(get_roots(files), nullptr);
+}
+
+void VisitorPipeline::run(const std::map<std::string, std::unique_ptr<AstBlock>>& files, ThreadPool& pool)
+{
+    this->run_phases(get_roots(files), &pool);
+}
+
+void VisitorPipeline::run(const std::string& file_name, AstBlock* root)
+{
+    this->run_phases({ { file_name, root } }, nullptr);
+}
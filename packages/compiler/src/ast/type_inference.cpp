@@ -180,7 +180,7 @@ std::unique_ptr<IAstType> stride::ast::infer_chained_expression_type(const AstCh
         );
     }
 
-    const auto* struct_type = dynamic_cast<AstObjectType*>(struct_type_raw);
+    const auto* struct_type = cast_type<AstObjectType*>(struct_type_raw);
     if (!struct_type)
     {
         throw parsing_error(
@@ -229,7 +229,7 @@ std::unique_ptr<IAstType> stride::ast::infer_indirect_call_type(const AstIndirec
         raw_type = unwrapped.get();
     }
 
-    const auto* fn_type = dynamic_cast<AstFunctionType*>(raw_type);
+    const auto* fn_type = cast_type<AstFunctionType*>(raw_type);
     if (!fn_type)
     {
         throw parsing_error(
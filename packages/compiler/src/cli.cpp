@@ -1,9 +1,13 @@
 #include "cli.h"
 
 #include "program.h"
+#include "thread_pool.h"
 
+#include <charconv>
 #include <format>
 #include <iostream>
+#include <stdexcept>
+#include <unordered_map>
 #include <llvm/MC/TargetRegistry.h>
 
 using namespace stride::cli;
@@ -17,6 +21,62 @@ std::string format_message(std::string text)
         text);
 }
 
+static size_t parse_positive_number(const std::string& number, const std::string& description)
+{
+    size_t value = 0;
+    const auto [end, error] = std::from_chars(number.data(), number.data() + number.size(), value);
+
+    if (error != std::errc() || end != number.data() + number.size() || value == 0)
+    {
+        throw std::invalid_argument(std::format("Invalid {} '{}', expected a positive number", description, number));
+    }
+
+    return value;
+}
+
+static size_t parse_thread_count(const std::string& count)
+{
+    return parse_positive_number(count, "thread count");
+}
+
+static OptimizationLevel parse_optimization_level(const std::string& level)
+{
+    // `-O` on its own is `-O2`, as in clang
+    static const std::unordered_map<std::string, OptimizationLevel> levels = {
+        { "", OptimizationLevel::O2 },
+        { "0", OptimizationLevel::O0 },
+        { "1", OptimizationLevel::O1 },
+        { "2", OptimizationLevel::O2 },
+        { "3", OptimizationLevel::O3 },
+        { "s", OptimizationLevel::Os },
+        { "z", OptimizationLevel::Oz },
+    };
+
+    if (const auto it = levels.find(level); it != levels.end())
+    {
+        return it->second;
+    }
+
+    throw std::invalid_argument(
+        std::format("Invalid optimization level '-O{}', expected one of -O0, -O1, -O2, -O3, -Os or -Oz", level));
+}
+
+static LazyPartitioning parse_lazy_partitioning(const std::string& partitioning)
+{
+    if (partitioning == "function")
+    {
+        return LazyPartitioning::FUNCTION;
+    }
+
+    if (partitioning == "file")
+    {
+        return LazyPartitioning::FILE;
+    }
+
+    throw std::invalid_argument(
+        std::format("Invalid lazy partitioning '{}', expected 'function' or 'file'", partitioning));
+}
+
 int stride::cli::resolve_cli_command(const int argc, char** argv)
 {
     // The first argument is always the command itself,
@@ -35,6 +95,16 @@ int stride::cli::resolve_cli_command(const int argc, char** argv)
         std::cout << "\x1b[31m┃\x1b[0m  -d, --dir <path>                     Output directory           \x1b[31m┃" <<std::endl;
         std::cout << "\x1b[31m┃\x1b[0m  --target <triple>                    Cross-compilation target   \x1b[31m┃" <<std::endl;
         std::cout << "\x1b[31m┃\x1b[0m                                       e.g. riscv32-unknown-elf   \x1b[31m┃" <<std::endl;
+        std::cout << "\x1b[31m┃\x1b[0m  -j, --jobs <count>                   Number of compiler threads \x1b[31m┃" <<std::endl;
+        std::cout << "\x1b[31m┃\x1b[0m  --cache-dir <path>                   Cache parsed files in path \x1b[31m┃" <<std::endl;
+        std::cout << "\x1b[31m┃\x1b[0m  --lazy-parse                         Only parse used functions  \x1b[31m┃" <<std::endl;
+        std::cout << "\x1b[31m┃\x1b[0m  -O0, -O1, -O2, -O3, -Os, -Oz         Optimization level (-O3)   \x1b[31m┃" <<std::endl;
+        std::cout << "\x1b[31m┃\x1b[0m  --passes=<pipeline>                  Custom LLVM pass pipeline  \x1b[31m┃" <<std::endl;
+        std::cout << "\x1b[31m┃\x1b[0m  --tiered                             Optimize hot functions     \x1b[31m┃" <<std::endl;
+        std::cout << "\x1b[31m┃\x1b[0m                                       while running (with -r)    \x1b[31m┃" <<std::endl;
+        std::cout << "\x1b[31m┃\x1b[0m  --tier-up-threshold=<calls>          Calls before optimizing    \x1b[31m┃" <<std::endl;
+        std::cout << "\x1b[31m┃\x1b[0m  --lazy[=function|file]               Compile functions on their \x1b[31m┃" <<std::endl;
+        std::cout << "\x1b[31m┃\x1b[0m                                       first call (with -r)       \x1b[31m┃" <<std::endl;
         std::cout << "\x1b[31m┃\x1b[0m  --debug                              Enable debug output        \x1b[31m┃" <<std::endl;
         std::cout << "\x1b[31m┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛" << std::endl;
         return 0;
@@ -65,8 +135,21 @@ int stride::cli::resolve_cli_command(const int argc, char** argv)
 CompilationOptions stride::cli::resolve_compilation_options_from_args(const int argc, char** argv)
 {
     CompilationOptions options = {
-        .mode       = CompilationMode::COMPILE_JIT,
-        .debug_mode = false
+        .source_files       = {},
+        .mode               = CompilationMode::COMPILE_JIT,
+        .debug_mode         = false,
+        .output_path        = {},
+        .program_name       = {},
+        .target_triple      = {},
+        .thread_count       = 0,
+        .cache_directory    = {},
+        .lazy_parsing       = false,
+        .optimization_level = OptimizationLevel::O3,
+        .pass_pipeline      = {},
+        .tiered_compilation = false,
+        .tier_up_threshold  = 1000,
+        .lazy_compilation   = false,
+        .lazy_partitioning  = LazyPartitioning::FUNCTION
     };
 
     for (int i = 0; i < argc; ++i)
@@ -120,6 +203,64 @@ CompilationOptions stride::cli::resolve_compilation_options_from_args(const int
                 options.target_triple = std::string(argv[++i]);
             }
         }
+
+        if (argument == "--cache-dir")
+        {
+            if (i + 1 < argc)
+            {
+                options.cache_directory = std::string(argv[++i]);
+            }
+        }
+
+        if (argument == "--lazy-parse")
+        {
+            options.lazy_parsing = true;
+        }
+
+        if (argument.starts_with("-O"))
+        {
+            options.optimization_level = parse_optimization_level(argument.substr(2));
+        }
+
+        if (argument.starts_with("--passes="))
+        {
+            options.pass_pipeline = argument.substr(9);
+        }
+
+        if (argument == "--tiered")
+        {
+            options.tiered_compilation = true;
+        }
+
+        if (argument.starts_with("--tier-up-threshold="))
+        {
+            options.tier_up_threshold = parse_positive_number(argument.substr(20), "tier-up threshold");
+        }
+
+        if (argument == "--lazy")
+        {
+            options.lazy_compilation = true;
+        }
+        else if (argument.starts_with("--lazy="))
+        {
+            options.lazy_compilation = true;
+            options.lazy_partitioning = parse_lazy_partitioning(argument.substr(7));
+        }
+
+        if (argument == "--jobs" || argument == "-j")
+        {
+            options.thread_count = parse_thread_count(i + 1 < argc ? std::string(argv[++i]) : "");
+        }
+        else if (argument.starts_with("-j"))
+        {
+            // `-jN`
+            options.thread_count = parse_thread_count(argument.substr(2));
+        }
+    }
+
+    if (options.lazy_compilation && options.tiered_compilation)
+    {
+        throw std::invalid_argument("--lazy and --tiered can't be combined");
     }
 
     return options;
@@ -131,7 +272,9 @@ int stride::cli::resolve_compile_command(const int argc, char** argv)
     auto options = resolve_compilation_options_from_args(argc, argv);
     options.mode = CompilationMode::COMPILE;
 
-    const auto program = Program::from_sources(options.source_files);
+    ThreadPool::set_shared_thread_count(options.thread_count);
+
+    const auto program = Program::from_sources(options);
 
     return program.compile(options);
 }
@@ -142,7 +285,9 @@ int stride::cli::resolve_run_command(const int argc, char** argv)
     auto options = resolve_compilation_options_from_args(argc, argv);
     options.mode = CompilationMode::COMPILE_JIT;
 
-    const auto program = Program::from_sources(options.source_files);
+    ThreadPool::set_shared_thread_count(options.thread_count);
+
+    const auto program = Program::from_sources(options);
 
     return program.compile_jit(options);
 }
@@ -1,5 +1,11 @@
 #include "program.h"
 
+#include "errors.h"
+#include "thread_pool.h"
+
+#include <exception>
+#include <format>
+#include <future>
 #include <iostream>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Module.h>
@@ -13,6 +19,90 @@ using namespace stride;
 #define STRINGIFY(x) #x
 #define TOSTRING(x) STRINGIFY(x)
 
+std::vector<std::string> Program::emit_object_files(
+    const std::vector<llvm::orc::ThreadSafeModule>& modules,
+    const cli::CompilationOptions& options,
+    const llvm::TargetMachine* target_machine)
+{
+    const auto base_name = options.program_name.empty() ? std::string("output") : options.program_name;
+
+    std::vector<std::string> filenames;
+    filenames.reserve(modules.size());
+    for (size_t index = 0; index < modules.size(); ++index)
+    {
+        auto filename = modules.size() == 1
+            ? std::format("{}.o", base_name)
+            : std::format("{}.{}.o", base_name, index);
+
+        if (!options.output_path.empty())
+        {
+            filename = options.output_path + "/" + filename;
+        }
+        filenames.push_back(std::move(filename));
+    }
+
+    auto& pool = ThreadPool::shared();
+    std::vector<std::future<void>> futures;
+    futures.reserve(modules.size());
+
+    for (size_t index = 0; index < modules.size(); ++index)
+    {
+        futures.push_back(
+            pool.submit(
+                [&module = modules[index], &filename = filenames[index], target_machine]
+                {
+                    std::error_code ec;
+                    llvm::raw_fd_ostream dest(filename, ec, llvm::sys::fs::OF_None);
+
+                    if (ec)
+                    {
+                        throw std::runtime_error(std::format("Could not open file: {}", ec.message()));
+                    }
+
+                    // Emit object file
+                    const auto file_target_machine = clone_target_machine(target_machine);
+                    llvm::legacy::PassManager pass;
+
+                    if (auto file_type = llvm::CodeGenFileType::ObjectFile;
+                        file_target_machine->addPassesToEmitFile(pass, dest, nullptr, file_type))
+                    {
+                        throw std::runtime_error("TargetMachine can't emit a file of this type");
+                    }
+
+                    module.withModuleDo([&](llvm::Module& m) { pass.run(m); });
+                    dest.flush();
+                }
+            )
+        );
+    }
+
+    // Every task has to finish before the errors are reported, as they refer to the modules
+    std::vector<std::exception_ptr> errors;
+    for (auto& future : futures)
+    {
+        try
+        {
+            pool.wait(future);
+        }
+        catch (...)
+        {
+            errors.push_back(std::current_exception());
+        }
+    }
+
+    if (!errors.empty())
+    {
+        rethrow_sorted_errors(std::move(errors));
+    }
+
+    for (const auto& filename : filenames)
+    {
+        std::cout << "Object file generated: " << filename << std::endl;
+    }
+
+    return filenames;
+}
+
 int Program::compile(const cli::CompilationOptions& options) const
 {
     // Initialize LLVM targets
@@ -47,40 +137,17 @@ int Program::compile(const cli::CompilationOptions& options) const
     llvm::TargetOptions opt;
     auto rm = std::optional<llvm::Reloc::Model>();
     auto target_machine =
-        target->createTargetMachine(target_triple, cpu, features, opt, rm);
-
-    llvm::LLVMContext context;
-    auto module = prepare_module(context, options, target_machine);
-
-    auto filename = options.program_name.empty() ? "output.o" : options.program_name + ".o";
-    if (!options.output_path.empty())
-    {
-        filename = options.output_path + "/" + filename;
-    }
-
-    std::error_code ec;
-    llvm::raw_fd_ostream dest(filename, ec, llvm::sys::fs::OF_None);
-
-    if (ec)
-    {
-        llvm::errs() << "Could not open file: " << ec.message();
-        return 1;
-    }
-
-    // Emit object file
-    llvm::legacy::PassManager pass;
-
-    if (auto file_type = llvm::CodeGenFileType::ObjectFile;
-        target_machine->addPassesToEmitFile(pass, dest, nullptr, file_type))
-    {
-        llvm::errs() << "TargetMachine can't emit a file of this type";
-        return 1;
-    }
-
-    pass.run(*module);
-    dest.flush();
-
-    std::cout << "Object file generated: " << filename << std::endl;
+        target->createTargetMachine(
+            target_triple,
+            cpu,
+            features,
+            opt,
+            rm,
+            std::nullopt,
+            get_codegen_opt_level(options.optimization_level));
+
+    const auto modules = prepare_modules(options, target_machine);
+    const auto object_files = emit_object_files(modules, options, target_machine);
 
     // Link object file to create executable
     // This is a simplified linking step. In a real-world scenario, you might want to identify the correct linker or use clang/gcc to link.
@@ -93,7 +160,8 @@ int Program::compile(const cli::CompilationOptions& options) const
     }
 
     std::string runtime_path = TOSTRING(STRIDE_RUNTIME_LIB_PATH);
-    std::vector<std::string> files = { runtime_path, filename};
+    std::vector<std::string> files = { runtime_path };
+    files.insert(files.end(), object_files.begin(), object_files.end());
 
     // Dead-code elimination and stripping differ by platform.
     //
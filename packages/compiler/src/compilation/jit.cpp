@@ -1,8 +1,13 @@
 #include "program.h"
+#include "thread_pool.h"
+#include "tiered_compilation.h"
 #include "../../include/runtime/stride_runtime.h"
 #include "runtime/symbols.h"
 
+#include <format>
 #include <iostream>
+#include <optional>
+#include <llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h>
 #include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
 #include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
@@ -35,6 +40,59 @@ llvm::Expected<llvm::orc::ExecutorAddr> locate_main_fn(llvm::orc::LLJIT* jit)
     return main_symbol_or_err;
 }
 
+/**
+ * Builds a JIT that compiles each partition on its first call, optimizing it on the compiling thread.
+ *
+ * Partitions are compiled on threads of LLVM's own, not on the shared pool, as compilations may block on each
+ * other, which the fixed number of workers of the pool could deadlock on. There are as many of them as workers
+ * in the pool, but they don't compete: partitions are only compiled once the program runs, after the pool has
+ * finished lowering the modules.
+ */
+static std::unique_ptr<llvm::orc::LLLazyJIT> create_lazy_jit(
+    llvm::orc::JITTargetMachineBuilder jtmb,
+    const llvm::TargetMachine* target_machine,
+    const cli::CompilationOptions& options
+)
+{
+    auto jit = llvm::cantFail(
+        llvm::orc::LLLazyJITBuilder()
+       .setJITTargetMachineBuilder(std::move(jtmb))
+       .setNumCompileThreads(ThreadPool::shared().get_thread_count())
+       .create()
+    );
+
+    // Functions are split off into partitions of their own by default
+    if (options.lazy_partitioning == cli::LazyPartitioning::FILE)
+    {
+        jit->getCompileOnDemandLayer().setPartitionFunction(
+            llvm::orc::CompileOnDemandLayer::compileWholeModule);
+    }
+
+    jit->getIRTransformLayer().setTransform(
+        [target_machine, options](
+        llvm::orc::ThreadSafeModule module,
+        const llvm::orc::MaterializationResponsibility&
+    ) -> llvm::Expected<llvm::orc::ThreadSafeModule>
+        {
+            try
+            {
+                module.withModuleDo(
+                    [&](llvm::Module& m)
+                    {
+                        const auto partition_target_machine = Program::clone_target_machine(target_machine);
+                        Program::optimize_module(m, partition_target_machine.get(), options);
+                    });
+            }
+            catch (const std::exception& e)
+            {
+                return llvm::make_error<llvm::StringError>(e.what(), llvm::inconvertibleErrorCode());
+            }
+            return module;
+        });
+
+    return jit;
+}
+
 int Program::compile_jit(const cli::CompilationOptions& options) const
 {
     llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
@@ -45,14 +103,6 @@ int Program::compile_jit(const cli::CompilationOptions& options) const
     llvm::InitializeNativeTargetAsmPrinter();
     llvm::InitializeNativeTargetAsmParser();
 
-    auto tsc = llvm::orc::ThreadSafeContext(
-        std::make_unique<llvm::LLVMContext>());
-
-    auto* context = tsc.withContextDo([](llvm::LLVMContext* ctx)
-    {
-        return ctx;
-    });
-
     auto jit_target_machine_builder =
         llvm::orc::JITTargetMachineBuilder::detectHost();
 
@@ -66,17 +116,39 @@ int Program::compile_jit(const cli::CompilationOptions& options) const
         return 1;
     }
     auto jtmb = std::move(*jit_target_machine_builder);
+    jtmb.setCodeGenOptLevel(get_codegen_opt_level(options.optimization_level));
 
     // We explicitly create the TargetMachine to use it for both the JIT and the Optimizer
     const auto target_machine = llvm::cantFail(jtmb.createTargetMachine());
 
+    // Tiers and partitions are optimized after the modules are prepared, which is too late to report an invalid pipeline
+    validate_pass_pipeline(options, target_machine.get());
+
+    // With tiers, the JIT only generates the unoptimized first tier; optimized code is generated separately
+    if (options.tiered_compilation)
+    {
+        jtmb.setCodeGenOptLevel(llvm::CodeGenOptLevel::None);
+    }
+
     // Register our runtime symbols manually to ensure they are available
     // Build the JIT using the existing TargetMachineBuilder
-    const auto jit = llvm::cantFail(
-        llvm::orc::LLJITBuilder()
-       .setJITTargetMachineBuilder(std::move(jtmb))
-       .create()
-    );
+    std::unique_ptr<llvm::orc::LLJIT> jit;
+    llvm::orc::LLLazyJIT* lazy_jit = nullptr;
+
+    if (options.lazy_compilation)
+    {
+        auto created_jit = create_lazy_jit(std::move(jtmb), target_machine.get(), options);
+        lazy_jit = created_jit.get();
+        jit = std::move(created_jit);
+    }
+    else
+    {
+        jit = llvm::cantFail(
+            llvm::orc::LLJITBuilder()
+           .setJITTargetMachineBuilder(std::move(jtmb))
+           .create()
+        );
+    }
 
     auto& jit_dylib = jit->getMainJITDylib();
 
@@ -86,12 +158,41 @@ int Program::compile_jit(const cli::CompilationOptions& options) const
                 jit->getDataLayout().getGlobalPrefix()))
     );
     runtime::register_jit_symbols(jit.get());
-    auto module = prepare_module(*context, options, target_machine.get());
 
-    llvm::orc::ThreadSafeModule thread_safe_module(
-        std::move(module),
-        std::move(tsc));
-    llvm::cantFail(jit->addIRModule(std::move(thread_safe_module)));
+    // Every file is a module of its own; the JIT links references between them
+    std::optional<TieredCompilation> tiered_compilation;
+    if (options.tiered_compilation)
+    {
+        tiered_compilation.emplace(jit.get(), clone_target_machine(target_machine.get()), options);
+
+        auto first_tier_options = options;
+        first_tier_options.optimization_level = cli::OptimizationLevel::O0;
+        first_tier_options.pass_pipeline.clear();
+
+        for (auto& module : prepare_modules(first_tier_options, target_machine.get()))
+        {
+            tiered_compilation->add_module(std::move(module));
+        }
+    }
+    else if (lazy_jit != nullptr)
+    {
+        // Partitions are optimized when they're first called, so the modules are only lowered up front
+        auto unoptimized_options = options;
+        unoptimized_options.optimization_level = cli::OptimizationLevel::O0;
+        unoptimized_options.pass_pipeline.clear();
+
+        for (auto& module : prepare_modules(unoptimized_options, target_machine.get()))
+        {
+            llvm::cantFail(lazy_jit->addLazyIRModule(std::move(module)));
+        }
+    }
+    else
+    {
+        for (auto& module : prepare_modules(options, target_machine.get()))
+        {
+            llvm::cantFail(jit->addIRModule(std::move(module)));
+        }
+    }
 
     if (auto err = jit->initialize(jit_dylib))
     {
@@ -113,6 +214,18 @@ int Program::compile_jit(const cli::CompilationOptions& options) const
     const auto main_fn = main_fn_executor->toPtr<int (*)()>();
     const int result = main_fn();
 
+    if (tiered_compilation.has_value())
+    {
+        tiered_compilation->wait();
+
+        if (options.debug_mode)
+        {
+            llvm::errs() << std::format(
+                "{} functions were optimized while running\n",
+                tiered_compilation->get_recompiled_count());
+        }
+    }
+
     if (auto err = jit->deinitialize(jit_dylib))
     {
         llvm::logAllUnhandledErrors(
@@ -1,12 +1,20 @@
 #include "program.h"
 
+#include "errors.h"
+#include "thread_pool.h"
 #include "ast/ast.h"
+#include "ast/serialization.h"
 #include "ast/visitor.h"
-#include "ast/nodes/traversal.h"
+#include "ast/visitor_pipeline.h"
 #include "runtime/symbols.h"
 
+#include <exception>
+#include <format>
+#include <future>
 #include <iostream>
+#include <optional>
 #include <ranges>
+#include <stdexcept>
 #include <llvm/Analysis/LoopAnalysisManager.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
@@ -15,6 +23,7 @@
 #include <llvm/IR/Module.h>
 #include <llvm/IR/PassManager.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/MC/TargetRegistry.h>
 #include <llvm/Passes/OptimizationLevel.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/DynamicLibrary.h>
@@ -22,70 +31,118 @@
 
 using namespace stride;
 
-Program Program::from_sources(const std::vector<std::string>& files)
+Program Program::from_sources(const cli::CompilationOptions& options)
 {
-    if (files.empty())
+    if (options.source_files.empty())
     {
         std::cout << "No valid stride files found" << std::endl;
         exit(0);
     }
 
-    auto ast = ast::Ast::parse_files(files);
+    std::optional<ast::AstCache> cache;
+    if (!options.cache_directory.empty())
+    {
+        cache.emplace(options.cache_directory);
+    }
+
+    auto ast = ast::Ast::parse_files(
+        options.source_files,
+        ThreadPool::shared(),
+        cache.has_value() ? &cache.value() : nullptr,
+        options.lazy_parsing
+    );
 
     return Program(std::move(ast));
 }
 
-std::unique_ptr<llvm::Module> Program::prepare_module(
-    llvm::LLVMContext& context,
-    const cli::CompilationOptions& options,
-    llvm::TargetMachine* target_machine) const
+std::unique_ptr<llvm::TargetMachine> Program::clone_target_machine(const llvm::TargetMachine* target_machine)
 {
-    llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
-    auto module = std::make_unique<llvm::Module>("stride_module", context);
-    module->setDataLayout(target_machine->createDataLayout());
-    module->setTargetTriple(target_machine->getTargetTriple());
-
-    llvm::IRBuilder<> builder(context);
-
-    ast::AstNodeTraverser traverser;
-    ast::ExpressionVisitor type_visitor;
-    ast::FunctionVisitor function_visitor;
-    ast::ImportVisitor import_visitor;
+    return std::unique_ptr<llvm::TargetMachine>(
+        target_machine->getTarget().createTargetMachine(
+            target_machine->getTargetTriple(),
+            target_machine->getTargetCPU(),
+            target_machine->getTargetFeatureString(),
+            target_machine->Options,
+            target_machine->getRelocationModel(),
+            target_machine->getCodeModel(),
+            target_machine->getOptLevel()
+        )
+    );
+}
 
-    for (const auto& [file_name, node] : this->_ast->get_files())
+llvm::CodeGenOptLevel Program::get_codegen_opt_level(const cli::OptimizationLevel level)
+{
+    switch (level)
     {
-        import_visitor.set_current_file_name(file_name);
-        traverser.visit_block(&import_visitor, node.get());
-
-        traverser.visit_block(&function_visitor, node.get());
+    case cli::OptimizationLevel::O0:
+        return llvm::CodeGenOptLevel::None;
+    case cli::OptimizationLevel::O1:
+        return llvm::CodeGenOptLevel::Less;
+    case cli::OptimizationLevel::O3:
+        return llvm::CodeGenOptLevel::Aggressive;
+    default:
+        return llvm::CodeGenOptLevel::Default;
     }
-    import_visitor.cross_register_symbols(this->_ast.get());
+}
 
-    for (const auto& node : this->_ast->get_files() | std::views::values)
+static llvm::OptimizationLevel get_pipeline_level(const cli::OptimizationLevel level)
+{
+    switch (level)
     {
-        runtime::register_runtime_symbols(node->get_context());
-        traverser.visit_block(&type_visitor, node.get());
+    case cli::OptimizationLevel::O1:
+        return llvm::OptimizationLevel::O1;
+    case cli::OptimizationLevel::O2:
+        return llvm::OptimizationLevel::O2;
+    case cli::OptimizationLevel::Os:
+        return llvm::OptimizationLevel::Os;
+    case cli::OptimizationLevel::Oz:
+        return llvm::OptimizationLevel::Oz;
+    default:
+        return llvm::OptimizationLevel::O3;
+    }
+}
 
-        node->validate();
-        node->resolve_forward_references(
-            module.get(),
-            &builder
-        );
-        node->codegen(module.get(), &builder);
+static llvm::ModulePassManager parse_pass_pipeline(llvm::PassBuilder& pass_builder, const std::string& pipeline)
+{
+    llvm::ModulePassManager module_pass_manager;
+    if (auto error = pass_builder.parsePassPipeline(module_pass_manager, pipeline))
+    {
+        throw std::invalid_argument(
+            std::format(
+                "Invalid pass pipeline '{}': {}",
+                pipeline,
+                llvm::toString(std::move(error))));
     }
+    return module_pass_manager;
+}
 
-    if (llvm::verifyModule(*module, &llvm::errs()))
+void Program::validate_pass_pipeline(
+    const cli::CompilationOptions& options,
+    const llvm::TargetMachine* target_machine)
+{
+    if (options.pass_pipeline.empty())
     {
-        module->print(llvm::errs(), nullptr);
-        throw std::runtime_error("LLVM IR verification failed");
+        return;
     }
 
-    if (options.debug_mode)
+    // Target machines register passes of their own, so the pipeline is parsed like it will be when it runs
+    const auto pipeline_target_machine = clone_target_machine(target_machine);
+    llvm::PassBuilder pass_builder(pipeline_target_machine.get());
+
+    parse_pass_pipeline(pass_builder, options.pass_pipeline);
+}
+
+void Program::optimize_module(
+    llvm::Module& module,
+    llvm::TargetMachine* target_machine,
+    const cli::CompilationOptions& options)
+{
+    // Without optimizations, not even the analyses have to be set up
+    if (options.pass_pipeline.empty() && options.optimization_level == cli::OptimizationLevel::O0)
     {
-        module->print(llvm::errs(), nullptr);
+        return;
     }
 
-    // optimizing
     llvm::LoopAnalysisManager loop_analysis_manager;
     llvm::FunctionAnalysisManager function_analysis_manager;
     llvm::CGSCCAnalysisManager cgscc_analysis_manager;
@@ -103,9 +160,149 @@ std::unique_ptr<llvm::Module> Program::prepare_module(
         cgscc_analysis_manager,
         module_analysis_manager);
 
-    llvm::ModulePassManager module_pass_manager =
-        pass_builder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
-    module_pass_manager.run(*module, module_analysis_manager);
+    auto module_pass_manager = options.pass_pipeline.empty()
+        ? pass_builder.buildPerModuleDefaultPipeline(get_pipeline_level(options.optimization_level))
+        : parse_pass_pipeline(pass_builder, options.pass_pipeline);
+
+    module_pass_manager.run(module, module_analysis_manager);
+}
+
+/// Lowers and optimizes a single file. Runs on a thread of its own, touching no LLVM state of other files.
+/// In debug mode, the IR is rendered into <code>debug_ir</code> before it's optimized.
+static llvm::orc::ThreadSafeModule generate_file_module(
+    const std::string& file_name,
+    ast::AstBlock* root,
+    llvm::TargetMachine* target_machine,
+    const cli::CompilationOptions& options,
+    std::string* debug_ir)
+{
+    auto context = std::make_unique<llvm::LLVMContext>();
+    auto module = std::make_unique<llvm::Module>(file_name, *context);
+    module->setDataLayout(target_machine->createDataLayout());
+    module->setTargetTriple(target_machine->getTargetTriple());
+
+    llvm::IRBuilder<> builder(*context);
+
+    root->resolve_forward_references(module.get(), &builder);
+    root->codegen(module.get(), &builder);
+
+    // Other files are verified at the same time, so the report is returned rather than printed
+    std::string verification_errors;
+    if (llvm::raw_string_ostream errors(verification_errors);
+        llvm::verifyModule(*module, &errors))
+    {
+        module->print(errors, nullptr);
+        throw std::runtime_error(
+            std::format("LLVM IR verification failed for '{}'\n{}", file_name, errors.str()));
+    }
+
+    if (debug_ir != nullptr)
+    {
+        llvm::raw_string_ostream ir(*debug_ir);
+        module->print(ir, nullptr);
+    }
+
+    Program::optimize_module(*module, target_machine, options);
+
+    return llvm::orc::ThreadSafeModule(std::move(module), llvm::orc::ThreadSafeContext(std::move(context)));
+}
+
+std::vector<llvm::orc::ThreadSafeModule> Program::prepare_modules(
+    const cli::CompilationOptions& options,
+    const llvm::TargetMachine* target_machine) const
+{
+    llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
+
+    // An invalid pipeline is reported once, before any file is analyzed, rather than by every file
+    validate_pass_pipeline(options, target_machine);
+
+    // Nodes and types created during analysis live as long as the parsed ones
+    ast::AstArena::Scope arena_scope(this->_ast->get_arena());
+
+    // Bodies skipped by lazy parsing are only needed once something may call them
+    this->_ast->parse_reachable_functions();
+
+    ast::ExpressionVisitor type_visitor;
+    ast::FunctionVisitor function_visitor;
+    ast::ImportVisitor import_visitor;
+
+    // Imports and function declarations are gathered in one traversal. Typing expressions needs the
+    // symbols of every file, so it waits until all of them have been registered.
+    ast::VisitorPipeline pipeline;
+    pipeline.add(&import_visitor);
+    pipeline.add(&function_visitor);
+    pipeline.add(&type_visitor, { &import_visitor, &function_visitor });
+    pipeline.on_complete(
+        &import_visitor,
+        [&]
+        {
+            import_visitor.cross_register_symbols(this->_ast.get());
+            for (const auto& node : this->_ast->get_files() | std::views::values)
+            {
+                runtime::register_runtime_symbols(node->get_context());
+            }
+        });
+    // Once all symbols are registered, every file is typed and validated on a thread of its own
+    pipeline.on_file_complete(
+        &type_visitor,
+        [](const std::string&, ast::AstBlock* root)
+        {
+            root->validate();
+        });
+
+    auto& pool = ThreadPool::shared();
+    pipeline.run(this->_ast->get_files(), pool);
+
+    // Every file is lowered into a context of its own, so files are lowered and optimized concurrently
+    const auto& files = this->_ast->get_files();
+    std::vector<std::string> debug_irs(files.size());
+    std::vector<std::future<llvm::orc::ThreadSafeModule>> futures;
+    futures.reserve(files.size());
+
+    for (size_t index = 0; const auto& [file_name, root] : files)
+    {
+        auto* debug_ir = options.debug_mode ? &debug_irs[index] : nullptr;
+        ++index;
+
+        futures.push_back(
+            pool.submit(
+                [&file_name, &options, root = root.get(), target_machine, debug_ir, arena = &this->_ast->get_arena()]
+                {
+                    ast::AstArena::Scope file_arena_scope(*arena);
+                    const auto file_target_machine = clone_target_machine(target_machine);
+                    return generate_file_module(file_name, root, file_target_machine.get(), options, debug_ir);
+                }
+            )
+        );
+    }
+
+    // Every task has to finish before the errors are reported, as they refer to the AST
+    std::vector<llvm::orc::ThreadSafeModule> modules;
+    std::vector<std::exception_ptr> errors;
+    for (auto& future : futures)
+    {
+        try
+        {
+            modules.push_back(pool.wait(future));
+        }
+        catch (...)
+        {
+            errors.push_back(std::current_exception());
+        }
+    }
+
+    if (!errors.empty())
+    {
+        rethrow_sorted_errors(std::move(errors));
+    }
+
+    if (options.debug_mode)
+    {
+        for (const auto& debug_ir : debug_irs)
+        {
+            llvm::errs() << debug_ir;
+        }
+    }
 
-    return module;
+    return modules;
 }
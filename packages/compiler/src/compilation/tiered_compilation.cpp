@@ -0,0 +1,296 @@
+#include "tiered_compilation.h"
+
+#include "program.h"
+#include "thread_pool.h"
+#include "ast/symbols.h"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
+#include <llvm/ExecutionEngine/Orc/Core.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/raw_ostream.h>
+
+using namespace stride;
+
+namespace
+{
+    constexpr auto TIER_UP_FN_NAME = "__stride_tier_up";
+    constexpr auto FIRST_TIER_SUFFIX = ".tier0";
+    constexpr auto SECOND_TIER_SUFFIX = ".tier1";
+    constexpr auto POINTER_SUFFIX = ".tier_pointer";
+    constexpr auto COUNTER_SUFFIX = ".calls";
+
+    /// Variadic functions can't forward their arguments through a stub, and main only runs once
+    bool is_tierable(const llvm::Function& function)
+    {
+        return !function.isDeclaration()
+            && !function.isVarArg()
+            && function.getName() != MAIN_FN_NAME;
+    }
+
+    template <typename T>
+    T take_value(llvm::Expected<T> value)
+    {
+        if (!value)
+        {
+            throw std::runtime_error(llvm::toString(value.takeError()));
+        }
+        return std::move(*value);
+    }
+}
+
+TieredCompilation::TieredCompilation(
+    llvm::orc::LLJIT* jit,
+    std::unique_ptr<llvm::TargetMachine> target_machine,
+    const cli::CompilationOptions& options
+) :
+    _jit(jit),
+    _target_machine(std::move(target_machine)),
+    _options(options)
+{
+    llvm::orc::SymbolMap symbols;
+    symbols[jit->mangleAndIntern(TIER_UP_FN_NAME)] = llvm::orc::ExecutorSymbolDef(
+        llvm::orc::ExecutorAddr::fromPtr(&TieredCompilation::tier_up),
+        llvm::JITSymbolFlags::Exported
+    );
+
+    llvm::cantFail(jit->getMainJITDylib().define(llvm::orc::absoluteSymbols(std::move(symbols))));
+}
+
+TieredCompilation::~TieredCompilation()
+{
+    this->wait();
+}
+
+void TieredCompilation::add_module(llvm::orc::ThreadSafeModule module)
+{
+    // Recompiled functions live in modules of their own, which can only refer to symbols that aren't private
+    module.withModuleDo([&](llvm::Module& m) { this->_promoter(m); });
+
+    const size_t module_index = this->_sources.size();
+    this->_sources.push_back(llvm::orc::cloneToNewContext(module));
+
+    module.withModuleDo([&](llvm::Module& m) { this->instrument(m, module_index); });
+    llvm::cantFail(this->_jit->addIRModule(std::move(module)));
+}
+
+void TieredCompilation::instrument(llvm::Module& module, const size_t module_index)
+{
+    auto& context = module.getContext();
+    auto* pointer_type = llvm::PointerType::getUnqual(context);
+    auto* counter_type = llvm::Type::getInt64Ty(context);
+
+    const auto tier_up_fn = module.getOrInsertFunction(
+        TIER_UP_FN_NAME,
+        llvm::FunctionType::get(llvm::Type::getVoidTy(context), { pointer_type, counter_type }, false)
+    );
+    auto* compilation = llvm::ConstantExpr::getIntToPtr(
+        llvm::ConstantInt::get(counter_type, reinterpret_cast<uintptr_t>(this)),
+        pointer_type
+    );
+
+    std::vector<llvm::Function*> functions;
+    for (auto& function : module)
+    {
+        if (is_tierable(function))
+        {
+            functions.push_back(&function);
+        }
+    }
+
+    for (auto* function : functions)
+    {
+        const auto name = function->getName().str();
+        const auto function_index = this->_functions.size();
+        this->_functions.push_back({ .name = name, .module_index = module_index });
+
+        // The stub takes the place of the function, whose body becomes the first tier
+        auto* stub = llvm::Function::Create(
+            function->getFunctionType(),
+            function->getLinkage(),
+            function->getAddressSpace(),
+            "",
+            &module
+        );
+        stub->copyAttributesFrom(function);
+        function->replaceAllUsesWith(stub);
+        stub->takeName(function);
+
+        function->setName(name + FIRST_TIER_SUFFIX);
+        function->setLinkage(llvm::GlobalValue::InternalLinkage);
+        function->setVisibility(llvm::GlobalValue::DefaultVisibility);
+
+        auto* tier_pointer = new llvm::GlobalVariable(
+            module,
+            pointer_type,
+            false,
+            llvm::GlobalValue::ExternalLinkage,
+            function,
+            name + POINTER_SUFFIX
+        );
+
+        // The stub forwards its arguments to the current tier, which returns to the caller itself
+        llvm::IRBuilder<> stub_builder(llvm::BasicBlock::Create(context, "entry", stub));
+        auto* current_tier = stub_builder.CreateAlignedLoad(pointer_type, tier_pointer, llvm::Align(8));
+        current_tier->setAtomic(llvm::AtomicOrdering::Acquire);
+
+        std::vector<llvm::Value*> arguments;
+        for (auto& argument : stub->args())
+        {
+            arguments.push_back(&argument);
+        }
+
+        auto* call = stub_builder.CreateCall(function->getFunctionType(), current_tier, arguments);
+        call->setTailCallKind(llvm::CallInst::TCK_MustTail);
+        call->setCallingConv(function->getCallingConv());
+        call->setAttributes(function->getAttributes());
+
+        if (call->getType()->isVoidTy())
+        {
+            stub_builder.CreateRetVoid();
+        }
+        else
+        {
+            stub_builder.CreateRet(call);
+        }
+
+        // The first tier counts its calls after its allocas, which have to stay in the entry block
+        auto* counter = new llvm::GlobalVariable(
+            module,
+            counter_type,
+            false,
+            llvm::GlobalValue::InternalLinkage,
+            llvm::ConstantInt::get(counter_type, 0),
+            name + COUNTER_SUFFIX
+        );
+
+        auto& entry = function->getEntryBlock();
+        const auto first_instruction = std::find_if_not(
+            entry.begin(),
+            entry.end(),
+            [](const llvm::Instruction& instruction) { return llvm::isa<llvm::AllocaInst>(instruction); }
+        );
+        auto* body = entry.splitBasicBlock(first_instruction, "tier.body");
+        entry.getTerminator()->eraseFromParent();
+
+        auto* tier_up_block = llvm::BasicBlock::Create(context, "tier.up", function, body);
+
+        llvm::IRBuilder<> counter_builder(&entry);
+        auto* previous_calls = counter_builder.CreateAtomicRMW(
+            llvm::AtomicRMWInst::Add,
+            counter,
+            llvm::ConstantInt::get(counter_type, 1),
+            llvm::Align(8),
+            llvm::AtomicOrdering::Monotonic
+        );
+        auto* is_hot = counter_builder.CreateICmpEQ(
+            previous_calls,
+            llvm::ConstantInt::get(counter_type, this->_options.tier_up_threshold - 1)
+        );
+        counter_builder.CreateCondBr(is_hot, tier_up_block, body);
+
+        llvm::IRBuilder<> tier_up_builder(tier_up_block);
+        tier_up_builder.CreateCall(
+            tier_up_fn,
+            { compilation, llvm::ConstantInt::get(counter_type, function_index) }
+        );
+        tier_up_builder.CreateBr(body);
+    }
+}
+
+void TieredCompilation::tier_up(TieredCompilation* compilation, const uint64_t function_index)
+{
+    // Runs on the thread of the program, which only waits for the task to be queued
+    std::lock_guard lock(compilation->_recompilations_mutex);
+    compilation->_recompilations.push_back(
+        ThreadPool::shared().submit(
+            [compilation, function_index]
+            {
+                compilation->recompile(compilation->_functions[function_index]);
+            }
+        )
+    );
+}
+
+void TieredCompilation::recompile(const TieredFunction& function)
+{
+    try
+    {
+        // Only the function is defined; everything it refers to is declared, and resolved to the first module
+        auto module = llvm::orc::cloneToNewContext(
+            this->_sources[function.module_index],
+            [&](const llvm::GlobalValue& value)
+            {
+                return value.getName() == function.name;
+            }
+        );
+
+        const auto target_machine = Program::clone_target_machine(this->_target_machine.get());
+        const auto optimized_name = function.name + SECOND_TIER_SUFFIX;
+
+        auto object = module.withModuleDo(
+            [&](llvm::Module& m)
+            {
+                // Global constructors already ran with the first tier
+                for (const auto* list_name : { "llvm.global_ctors", "llvm.global_dtors" })
+                {
+                    if (auto* list = m.getNamedGlobal(list_name))
+                    {
+                        list->eraseFromParent();
+                    }
+                }
+
+                auto* optimized = m.getFunction(function.name);
+                optimized->setName(optimized_name);
+                optimized->setLinkage(llvm::GlobalValue::ExternalLinkage);
+                optimized->setVisibility(llvm::GlobalValue::DefaultVisibility);
+
+                Program::optimize_module(m, target_machine.get(), this->_options);
+                return take_value(llvm::orc::SimpleCompiler(*target_machine)(m));
+            }
+        );
+
+        if (auto error = this->_jit->addObjectFile(std::move(object)))
+        {
+            throw std::runtime_error(llvm::toString(std::move(error)));
+        }
+
+        const auto address = take_value(this->_jit->lookup(optimized_name));
+        const auto tier_pointer = take_value(this->_jit->lookup(function.name + POINTER_SUFFIX));
+
+        // Calls that start from now on run the second tier
+        std::atomic_ref(*tier_pointer.toPtr<void**>()).store(address.toPtr<void*>(), std::memory_order_release);
+        ++this->_recompiled_count;
+    }
+    catch (const std::exception& e)
+    {
+        // The function keeps running its first tier
+        llvm::errs() << std::format("Could not optimize '{}': {}\n", function.name, e.what());
+    }
+}
+
+void TieredCompilation::wait()
+{
+    // Recompilations that are still running may not request others, but the program might
+    while (true)
+    {
+        std::vector<std::future<void>> recompilations;
+        {
+            std::lock_guard lock(this->_recompilations_mutex);
+            recompilations.swap(this->_recompilations);
+        }
+
+        if (recompilations.empty())
+        {
+            return;
+        }
+
+        for (auto& recompilation : recompilations)
+        {
+            ThreadPool::shared().wait(recompilation);
+        }
+    }
+}
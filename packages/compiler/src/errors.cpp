@@ -44,32 +44,12 @@ std::string stride::make_source_error(
             suggestion.empty() ? "" : std::format("┃ {}", suggestion));
     }
 
-    size_t line_start = source_position.offset;
-    while (line_start > 0 && source_file->source[line_start - 1] != '\n')
-    {
-        line_start--;
-    }
-
-    size_t line_end = source_position.offset;
-    while (line_end < source_file->source.length() && source_file->source[
-        line_end] != '\n')
-    {
-        line_end++;
-    }
-
-    size_t line_number = 1;
-    for (size_t i = 0; i < line_start; i++)
-    {
-        if (source_file->source[i] == '\n')
-        {
-            line_number++;
-        }
-    }
+    const auto [line_number, line_start, line_end] = source_file->get_line(source_position.offset);
 
     // Not static: must reflect the current call's source/offset.
-    const std::string line_str = source_file->source.substr(
+    const auto line_str = std::string(source_file->source.substr(
         line_start,
-        line_end - line_start);
+        line_end - line_start));
 
     const auto line_nr_str = std::to_string(line_number);
     const size_t column_in_line = source_position.offset - line_start;
@@ -120,7 +100,7 @@ std::string stride::make_source_error(
             error);
     }
 
-    const auto& src = source_file->source;
+    const std::string_view src = source_file->source;
 
     // Compute line start, end, and 1-based number for a source offset.
     struct LineInfo
@@ -135,22 +115,9 @@ std::string stride::make_source_error(
 
     auto get_line_info = [&](const size_t offset) -> LineInfo
     {
-        size_t start = offset;
-        while (start > 0 && src[start - 1] != '\n')
-            start--;
-
-        size_t end = offset;
-        while (end < src.size() && src[end] != '\n')
-            end++;
+        const auto line = source_file->get_line(offset);
 
-        size_t number = 1;
-        for (size_t i = 0; i < start; i++)
-        {
-            if (src[i] == '\n')
-                number++;
-        }
-
-        return { start, end, number };
+        return { line.start, line.end, line.number };
     };
 
     // Sort references by source offset.
@@ -192,9 +159,9 @@ std::string stride::make_source_error(
     for (size_t group_idx = 0; group_idx < line_groups.size(); group_idx++)
     {
         const auto& group = line_groups[group_idx];
-        const std::string line_content = src.substr(
+        const auto line_content = std::string(src.substr(
             group.info.line_start,
-            group.info.line_end - group.info.line_start);
+            group.info.line_end - group.info.line_start));
         const std::string line_nr_str = std::to_string(group.info.line_number);
 
         // base_padding: offset in underline string so underline[base_padding + column] 
@@ -331,3 +298,72 @@ std::string stride::make_source_error(
 
     return result;
 }
+
+void stride::rethrow_sorted_errors(std::vector<std::exception_ptr> errors)
+{
+    struct SortedError
+    {
+        std::exception_ptr error;
+        const parsing_error* error_details;
+        std::optional<std::pair<std::string_view, size_t>> position;
+    };
+
+    std::vector<SortedError> sorted_errors;
+    sorted_errors.reserve(errors.size());
+
+    for (auto& error : errors)
+    {
+        SortedError sorted_error{ .error = std::move(error), .error_details = nullptr, .position = std::nullopt };
+        try
+        {
+            std::rethrow_exception(sorted_error.error);
+        }
+        catch (const parsing_error& caught)
+        {
+            // The exception object lives as long as the exception_ptr referring to it
+            sorted_error.error_details = &caught;
+
+            if (const auto& source_position = caught.get_source_position();
+                source_position.has_value() && source_position->source != nullptr)
+            {
+                sorted_error.position = std::make_pair(
+                    std::string_view(source_position->source->path),
+                    source_position->offset);
+            }
+        }
+        catch (...) {}
+
+        sorted_errors.push_back(std::move(sorted_error));
+    }
+
+    std::ranges::stable_sort(
+        sorted_errors,
+        [](const SortedError& lhs, const SortedError& rhs)
+        {
+            if (!lhs.position.has_value() || !rhs.position.has_value())
+            {
+                return lhs.position.has_value() && !rhs.position.has_value();
+            }
+            return lhs.position.value() < rhs.position.value();
+        });
+
+    const bool all_parsing_errors = std::ranges::all_of(
+        sorted_errors,
+        [](const SortedError& error)
+        {
+            return error.error_details != nullptr;
+        });
+
+    if (sorted_errors.size() == 1 || !all_parsing_errors)
+    {
+        std::rethrow_exception(sorted_errors.front().error);
+    }
+
+    std::string message;
+    for (const auto& error : sorted_errors)
+    {
+        message += error.error_details->what();
+        message += "\n";
+    }
+    throw parsing_error(message);
+}
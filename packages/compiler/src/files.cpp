@@ -2,27 +2,344 @@
 
 #include "errors.h"
 
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CSTRIDE_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define CSTRIDE_HAS_MMAP 0
+#endif
 
 using namespace stride;
 
+namespace
+{
+    /*
+     * Source file registry
+     *
+     * Maps compact file ids to live source files. Lookups happen for every lexeme access and are
+     * lock-free; the table is split into fixed-size chunks that are allocated on demand and never
+     * moved, so readers only need two atomic loads. Registration and removal take the mutex.
+     *
+     * The low bits of an id select a slot of the table, the high bits are the generation of that slot.
+     * Slots are recycled once their file is destroyed, but every reuse starts a new generation, so that
+     * the ids of destroyed files don't resolve to whichever file took their slot. A slot whose generations
+     * are used up is retired rather than starting over, as ids of its first generations may still be around.
+     *
+     * Ids are reserved while a file is constructed, and the file is only published to readers once it is
+     * fully constructed.
+     */
+    constexpr size_t REGISTRY_CHUNK_SIZE = 1024;
+    constexpr size_t REGISTRY_MAX_CHUNKS = 1024;
+
+    constexpr SourceFileId REGISTRY_SLOT_BITS = 20;
+    constexpr SourceFileId REGISTRY_SLOT_MASK = (SourceFileId{ 1 } << REGISTRY_SLOT_BITS) - 1;
+
+    static_assert(REGISTRY_CHUNK_SIZE * REGISTRY_MAX_CHUNKS == size_t{ 1 } << REGISTRY_SLOT_BITS);
+
+    using RegistryChunk = std::array<std::atomic<SourceFile*>, REGISTRY_CHUNK_SIZE>;
+
+    std::array<std::atomic<RegistryChunk*>, REGISTRY_MAX_CHUNKS> registry_chunks{};
+    std::mutex registry_mutex;
+
+    /// Ids that the next files can take, in the slots of destroyed files
+    std::vector<SourceFileId> registry_free_ids;
+    SourceFileId registry_next_slot = 0;
+
+    SourceFileId get_slot(const SourceFileId id)
+    {
+        return id & REGISTRY_SLOT_MASK;
+    }
+
+    /// The id of the next generation of the slot of <code>id</code>, if it has one left
+    std::optional<SourceFileId> next_generation(const SourceFileId id)
+    {
+        constexpr SourceFileId generation_step = SourceFileId{ 1 } << REGISTRY_SLOT_BITS;
+
+        // The invalid id is never handed out, so the slot it's in has one generation less
+        if (id >= INVALID_SOURCE_FILE_ID - generation_step)
+        {
+            return std::nullopt;
+        }
+        return id + generation_step;
+    }
+
+    std::atomic<SourceFile*>& get_registry_entry(const SourceFileId id)
+    {
+        const auto slot = get_slot(id);
+        return (*registry_chunks[slot / REGISTRY_CHUNK_SIZE].load(std::memory_order_acquire))[slot % REGISTRY_CHUNK_SIZE];
+    }
+
+    SourceFileId reserve_source_file_id()
+    {
+        std::lock_guard lock(registry_mutex);
+
+        if (!registry_free_ids.empty())
+        {
+            const auto id = registry_free_ids.back();
+            registry_free_ids.pop_back();
+            return id;
+        }
+
+        if (registry_next_slot > REGISTRY_SLOT_MASK)
+        {
+            throw std::runtime_error("Exceeded the maximum number of simultaneously loaded source files");
+        }
+
+        const auto id = registry_next_slot++;
+        auto& chunk = registry_chunks[id / REGISTRY_CHUNK_SIZE];
+        if (chunk.load(std::memory_order_acquire) == nullptr)
+        {
+            // Chunks live for the remainder of the process, as readers may hold on to them without locking.
+            chunk.store(new RegistryChunk{}, std::memory_order_release);
+        }
+
+        return id;
+    }
+
+    void publish_source_file(SourceFile* file)
+    {
+        get_registry_entry(file->id).store(file, std::memory_order_release);
+    }
+
+    void unregister_source_file(const SourceFileId id)
+    {
+        std::lock_guard lock(registry_mutex);
+
+        get_registry_entry(id).store(nullptr, std::memory_order_release);
+
+        if (const auto next_id = next_generation(id))
+        {
+            registry_free_ids.push_back(next_id.value());
+        }
+    }
+}
+
+SourceFile::SourceFile(std::string path, std::string source) :
+    path(std::move(path)),
+    id(reserve_source_file_id()),
+    _owned_source(std::move(source))
+{
+    this->source = this->_owned_source;
+
+    publish_source_file(this);
+}
+
+SourceFile::SourceFile(std::string path, const char* mapped_data, const size_t mapped_length) :
+    path(std::move(path)),
+    source(mapped_data, mapped_length),
+    id(reserve_source_file_id()),
+    _mapped_data(mapped_data),
+    _mapped_length(mapped_length)
+{
+    publish_source_file(this);
+}
+
+SourceFile::~SourceFile()
+{
+    unregister_source_file(this->id);
+
+#if CSTRIDE_HAS_MMAP
+    if (this->_mapped_data != nullptr)
+    {
+        munmap(const_cast<char*>(this->_mapped_data), this->_mapped_length);
+    }
+#endif
+}
+
+void SourceFile::set_unescaped_literal(const size_t offset, std::string value)
+{
+    this->_unescaped_literals.insert_or_assign(offset, std::move(value));
+}
+
+std::string_view SourceFile::get_unescaped_literal(const size_t offset) const
+{
+    if (const auto it = this->_unescaped_literals.find(offset);
+        it != this->_unescaped_literals.end())
+    {
+        return it->second;
+    }
+    return {};
+}
+
+SourceLine SourceFile::get_line(const size_t offset) const
+{
+    std::call_once(this->_line_starts_built, [this]
+    {
+        this->_line_starts.push_back(0);
+        for (size_t i = 0; i < this->source.size(); ++i)
+        {
+            if (this->source[i] == '\n')
+            {
+                this->_line_starts.push_back(i + 1);
+            }
+        }
+    });
+
+    // The last line start that is at or before the offset
+    const auto it = std::ranges::upper_bound(this->_line_starts, offset) - 1;
+    const auto index = static_cast<size_t>(it - this->_line_starts.begin());
+
+    const size_t start = *it;
+    const size_t end = index + 1 < this->_line_starts.size()
+        ? this->_line_starts[index + 1] - 1
+        : this->source.size();
+
+    // Follow the offset through the later revisions, moving the line along with the line breaks
+    // that were added or removed before it
+    auto number = static_cast<int64_t>(index + 1);
+    if (this->_edits != nullptr)
+    {
+        size_t position = offset;
+        for (size_t i = this->_first_later_edit; i < this->_edits->size(); ++i)
+        {
+            const auto& edit = (*this->_edits)[i];
+            if (position < edit.offset)
+            {
+                continue;
+            }
+
+            // The text was replaced, so it has no line in later revisions
+            if (position < edit.removed_end)
+            {
+                break;
+            }
+
+            position = position - edit.removed_end + edit.offset + edit.inserted_length;
+            number += edit.line_delta;
+        }
+    }
+
+    return { static_cast<size_t>(number), start, end };
+}
+
+void SourceFile::add_revision(SourceFile& revision, const SourceEdit& edit)
+{
+    if (this->_edits == nullptr)
+    {
+        this->_edits = std::make_shared<std::vector<LineShift>>();
+    }
+
+    const auto count_line_breaks = [](const std::string_view text)
+    {
+        return static_cast<int64_t>(std::ranges::count(text, '\n'));
+    };
+
+    this->_edits->push_back({
+        edit.offset,
+        edit.removed_end(),
+        edit.replacement.size(),
+        count_line_breaks(edit.replacement) - count_line_breaks(this->source.substr(edit.offset, edit.removed_length))
+    });
+
+    revision._edits = this->_edits;
+    revision._first_later_edit = this->_edits->size();
+}
+
+SourceFile* stride::get_source_file(const SourceFileId id)
+{
+    if (id == INVALID_SOURCE_FILE_ID)
+    {
+        return nullptr;
+    }
+
+    const auto slot = get_slot(id);
+    const auto* chunk = registry_chunks[slot / REGISTRY_CHUNK_SIZE].load(std::memory_order_acquire);
+    if (chunk == nullptr)
+    {
+        return nullptr;
+    }
+
+    // A slot that has been reused holds a file of another generation
+    auto* file = (*chunk)[slot % REGISTRY_CHUNK_SIZE].load(std::memory_order_acquire);
+    return file != nullptr && file->id == id ? file : nullptr;
+}
+
+#if CSTRIDE_HAS_MMAP
+/// Maps the file at `path` if it is a regular file of at least `SOURCE_MMAP_THRESHOLD` bytes.
+static std::shared_ptr<SourceFile> try_map_file(const std::string& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat file_stat{};
+    if (fstat(fd, &file_stat) != 0
+        || !S_ISREG(file_stat.st_mode)
+        || static_cast<size_t>(file_stat.st_size) < SOURCE_MMAP_THRESHOLD)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    const auto length = static_cast<size_t>(file_stat.st_size);
+    void* data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    // The lexer reads the file front to back exactly once
+    madvise(data, length, MADV_SEQUENTIAL);
+
+    return std::make_shared<SourceFile>(path, static_cast<const char*>(data), length);
+}
+#endif
+
 std::shared_ptr<SourceFile> stride::read_file(const std::string& path)
 {
-    const std::ifstream file(path);
+#if CSTRIDE_HAS_MMAP
+    if (auto mapped = try_map_file(path))
+    {
+        return mapped;
+    }
+#endif
+
+    std::ifstream file(path, std::ios::binary);
 
     if (!file)
     {
         throw parsing_error("Failed to open file: " + path);
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-
-    auto content = buffer.str();
+    std::string content{ std::istreambuf_iterator(file), std::istreambuf_iterator<char>() };
 
     return std::make_shared<SourceFile>(path, std::move(content));
 }
 
+std::shared_ptr<SourceFile> stride::apply_edit(const SourceFile& file, const SourceEdit& edit)
+{
+    if (edit.offset > file.source.size() || edit.removed_length > file.source.size() - edit.offset)
+    {
+        throw std::out_of_range("Edit range exceeds the bounds of " + file.path);
+    }
+
+    std::string content;
+    content.reserve(file.source.size() - edit.removed_length + edit.replacement.size());
+    content.append(file.source.substr(0, edit.offset));
+    content.append(edit.replacement);
+    content.append(file.source.substr(edit.removed_end()));
+
+    return std::make_shared<SourceFile>(file.path, std::move(content));
+}
+
 SourceFragment SourceFragment::combine(const SourceFragment& first, const SourceFragment& last)
 {
     return SourceFragment(
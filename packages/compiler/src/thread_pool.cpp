@@ -0,0 +1,168 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+using namespace stride;
+
+namespace
+{
+    /// The pool and queue of the worker running on this thread, if any
+    thread_local const ThreadPool* current_pool = nullptr;
+    thread_local size_t current_queue = 0;
+
+    std::mutex shared_pool_mutex;
+    size_t shared_thread_count = 0;
+}
+
+ThreadPool::ThreadPool(size_t thread_count)
+{
+    if (thread_count == 0)
+    {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    this->_queues.reserve(thread_count + 1);
+    for (size_t i = 0; i <= thread_count; ++i)
+    {
+        this->_queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    this->_workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        this->_workers.emplace_back(&ThreadPool::run_worker, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(this->_idle_mutex);
+        this->_stopping = true;
+    }
+    this->_idle_condition.notify_all();
+
+    for (auto& worker : this->_workers)
+    {
+        worker.join();
+    }
+}
+
+bool ThreadPool::is_worker_thread() const
+{
+    return current_pool == this;
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    std::lock_guard lock(shared_pool_mutex);
+
+    // Intentionally leaked, so that no worker is joined while static destructors run
+    static ThreadPool* pool = new ThreadPool(shared_thread_count);
+    return *pool;
+}
+
+void ThreadPool::set_shared_thread_count(const size_t thread_count)
+{
+    std::lock_guard lock(shared_pool_mutex);
+    shared_thread_count = thread_count;
+}
+
+void ThreadPool::push(Task task)
+{
+    const auto queue_index = this->is_worker_thread() ? current_queue : this->_workers.size();
+
+    {
+        // Counted under the idle lock, so a worker can't miss it between checking and going to sleep.
+        // Counting before queueing keeps the count from dropping below zero when the task is taken.
+        std::lock_guard lock(this->_idle_mutex);
+        this->_queued_task_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        auto& queue = *this->_queues[queue_index];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    this->_idle_condition.notify_one();
+}
+
+bool ThreadPool::try_pop(const size_t queue_index, Task& task, const bool steal)
+{
+    auto& queue = *this->_queues[queue_index];
+    std::lock_guard lock(queue.mutex);
+
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+
+    // The owner takes its newest task, which is the most likely to still be in cache.
+    // Thieves take the oldest, which tends to be the largest remaining piece of work.
+    if (steal)
+    {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+    }
+    else
+    {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+    }
+
+    this->_queued_task_count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ThreadPool::run_pending_task()
+{
+    const auto shared_queue = this->_workers.size();
+
+    Task task;
+    bool found = this->is_worker_thread() && this->try_pop(current_queue, task, false);
+
+    // Tasks submitted from outside the pool come next, in the order they were submitted
+    found = found || this->try_pop(shared_queue, task, true);
+
+    const auto first_victim = this->is_worker_thread() ? current_queue + 1 : 0;
+    for (size_t i = 0; !found && i < shared_queue; ++i)
+    {
+        found = this->try_pop((first_victim + i) % shared_queue, task, true);
+    }
+
+    if (!found)
+    {
+        return false;
+    }
+
+    // Exceptions are captured by the packaged task, and delivered through its future
+    task();
+    return true;
+}
+
+void ThreadPool::run_worker(const size_t index)
+{
+    current_pool = this;
+    current_queue = index;
+
+    while (true)
+    {
+        if (this->run_pending_task())
+        {
+            continue;
+        }
+
+        std::unique_lock lock(this->_idle_mutex);
+        this->_idle_condition.wait(
+            lock,
+            [this]
+            {
+                return this->_stopping || this->_queued_task_count.load(std::memory_order_relaxed) > 0;
+            });
+
+        if (this->_stopping && this->_queued_task_count.load(std::memory_order_relaxed) == 0)
+        {
+            return;
+        }
+    }
+}
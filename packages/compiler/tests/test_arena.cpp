@@ -0,0 +1,138 @@
+#include "errors.h"
+#include "thread_pool.h"
+#include "utils.h"
+#include "ast/arena.h"
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    const std::string SOURCE =
+        "type Point = {\n"
+        "    x: i32;\n"
+        "    y: i32;\n"
+        "};\n"
+        "fn length(p: Point): i32 {\n"
+        "    for (let i: i32 = 0; i < 10; i++) {\n"
+        "        if (p.x > i) {\n"
+        "            return p.x * p.x + p.y * p.y;\n"
+        "        }\n"
+        "    }\n"
+        "    return 0;\n"
+        "}\n";
+
+    std::unique_ptr<AstBlock> parse(const std::string& code)
+    {
+        auto tokens = tokenizer::tokenize(std::make_shared<SourceFile>("test.sr", code));
+        return parse_sequential(make_context(), tokens);
+    }
+}
+
+TEST(Arena, NodesAreAllocatedFromInstalledArena)
+{
+    AstArena arena;
+    {
+        AstArena::Scope arena_scope(arena);
+        EXPECT_EQ(AstArena::current(), &arena);
+
+        const auto root = parse(SOURCE);
+        ASSERT_NE(root, nullptr);
+        EXPECT_EQ(root->get_children().size(), 2);
+    }
+
+    EXPECT_EQ(AstArena::current(), nullptr);
+    EXPECT_GT(arena.get_allocated_bytes(), 0);
+}
+
+TEST(Arena, NodesUseHeapWithoutArena)
+{
+    AstArena arena;
+    const auto root = parse(SOURCE);
+
+    ASSERT_NE(root, nullptr);
+    EXPECT_EQ(arena.get_allocated_bytes(), 0);
+}
+
+TEST(Arena, ScopesNest)
+{
+    AstArena outer;
+    AstArena inner;
+
+    AstArena::Scope outer_scope(outer);
+    const auto* first = static_cast<std::byte*>(outer.allocate(32));
+    {
+        AstArena::Scope inner_scope(inner);
+        EXPECT_EQ(AstArena::current(), &inner);
+        inner.allocate(32);
+    }
+    EXPECT_EQ(AstArena::current(), &outer);
+
+    // The outer arena keeps bumping through the chunk it had before the inner scope
+    const auto* second = static_cast<std::byte*>(outer.allocate(32));
+    EXPECT_EQ(second, first + 32);
+}
+
+TEST(Arena, LargeAllocationsGetTheirOwnChunk)
+{
+    AstArena arena;
+    AstArena::Scope arena_scope(arena);
+
+    const auto* small = static_cast<std::byte*>(arena.allocate(32));
+    const auto* large = static_cast<std::byte*>(arena.allocate(AstArena::CHUNK_SIZE));
+    const auto* next = static_cast<std::byte*>(arena.allocate(32));
+
+    EXPECT_NE(large, small + 32);
+    EXPECT_EQ(next, small + 32);
+}
+
+TEST(Arena, AllocationsHaveNoHeader)
+{
+    constexpr auto alignment = alignof(std::max_align_t);
+
+    AstArena arena;
+    auto* heap_memory = allocate_ast_memory(24);
+    void* arena_memory;
+    {
+        AstArena::Scope arena_scope(arena);
+        arena_memory = allocate_ast_memory(24);
+    }
+
+    // Arena memory only takes the allocation rounded up, and both kinds are aligned for any object
+    EXPECT_EQ(arena.get_allocated_bytes(), 2 * alignment);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(heap_memory) % alignment, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(arena_memory) % alignment, 0);
+
+    // Only the heap memory is released; the arena memory goes with its arena
+    deallocate_ast_memory(arena_memory);
+    deallocate_ast_memory(heap_memory);
+}
+
+TEST(Arena, ThreadsShareAnArena)
+{
+    AstArena arena;
+    ThreadPool pool(4);
+
+    std::vector<std::future<size_t>> futures;
+    for (int i = 0; i < 16; ++i)
+    {
+        futures.push_back(pool.submit([&arena]
+        {
+            AstArena::Scope arena_scope(arena);
+            return parse(SOURCE)->get_children().size();
+        }));
+    }
+
+    for (auto& future : futures)
+    {
+        EXPECT_EQ(pool.wait(future), 2);
+    }
+}
+
+TEST(Arena, ParsedFilesCanBeAnalyzed)
+{
+    AstArena arena;
+    AstArena::Scope arena_scope(arena);
+
+    EXPECT_NO_THROW(tests::assert_compiles(SOURCE));
+}
@@ -0,0 +1,291 @@
+#include "errors.h"
+#include "utils.h"
+#include "thread_pool.h"
+#include "ast/closures.h"
+#include "ast/serialization.h"
+#include "ast/nodes/function_declaration.h"
+
+#include <filesystem>
+#include <fstream>
+#include <regex>
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    const std::string SOURCE =
+        "type Point<T> = {\n"
+        "    x: T;\n"
+        "    y: T;\n"
+        "};\n"
+        "type Scale = (f64) -> f64;\n"
+        "enum Color { Red: 1, Green: 2, Blue }\n"
+        "const origin: Point<i32> = Point<i32>::{ x: 0, y: 0 };\n"
+        "const double: (i32) -> i32 = (v: i32): i32 -> {\n"
+        "    return v * 2;\n"
+        "};\n"
+        "module Geometry {\n"
+        "    fn area(w: f64, h: f64): f64 {\n"
+        "        return w * h;\n"
+        "    }\n"
+        "}\n"
+        "fn main(): i32 {\n"
+        "    let values: i32[] = [1, 2, 3];\n"
+        "    let total: i64 = 0L;\n"
+        "    let letter: char = 'a';\n"
+        "    let name: string = \"stride\\n\";\n"
+        "    let ratio: f64 = 1.5;\n"
+        "    for (let i: i32 = 0; i < 3; i++) {\n"
+        "        if (values[i] > 1 && !false) {\n"
+        "            total += values[i] as i64;\n"
+        "        } else {\n"
+        "            continue;\n"
+        "        }\n"
+        "    }\n"
+        "    while (total > 100L) {\n"
+        "        total -= 1L;\n"
+        "        break;\n"
+        "    }\n"
+        "    return double(origin.x) + -1;\n"
+        "}\n";
+
+    std::unique_ptr<AstBlock> parse(const std::shared_ptr<SourceFile>& source)
+    {
+        auto tokens = tokenizer::tokenize(source);
+        return parse_sequential(make_context(), tokens);
+    }
+
+    void analyze(AstBlock* root)
+    {
+        AstNodeTraverser traverser;
+        ImportVisitor import_visitor;
+        FunctionVisitor function_visitor;
+        ExpressionVisitor type_visitor;
+
+        import_visitor.set_current_file_name("test.sr");
+        traverser.visit_block(&import_visitor, root);
+        traverser.visit_block(&function_visitor, root);
+
+        runtime::register_runtime_symbols(root->get_context());
+        traverser.visit_block(&type_visitor, root);
+
+        root->validate();
+    }
+
+    /// Tree of <code>root</code>, without the unique suffixes of local variable names
+    std::string tree_of(AstBlock* root)
+    {
+        static const std::regex unique_suffix(R"(\(([A-Za-z_][\w]*)\.\d+\))");
+
+        return std::regex_replace(root->to_string(), unique_suffix, "($1)");
+    }
+
+    /// Empty cache directory, removed again when the test ends
+    struct TemporaryDirectory
+    {
+        std::filesystem::path path;
+
+        explicit TemporaryDirectory(const std::string& name) :
+            path(std::filesystem::temp_directory_path() / name)
+        {
+            std::filesystem::remove_all(this->path);
+        }
+
+        ~TemporaryDirectory()
+        {
+            std::filesystem::remove_all(this->path);
+        }
+    };
+}
+
+TEST(AstCache, RoundTripPreservesTree)
+{
+    const auto source = std::make_shared<SourceFile>("test.sr", SOURCE);
+    const auto root = parse(source);
+
+    const auto data = serialize_ast(root.get());
+    ASSERT_TRUE(data.has_value());
+
+    const auto loaded = deserialize_ast(*data, source);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(tree_of(loaded.get()), tree_of(root.get()));
+
+    // Source positions refer to the same file
+    EXPECT_EQ(loaded->get_source(), source);
+    ASSERT_EQ(loaded->get_children().size(), root->get_children().size());
+    for (size_t i = 0; i < root->get_children().size(); ++i)
+    {
+        const auto& expected = root->get_children()[i]->get_source_fragment();
+        const auto& actual = loaded->get_children()[i]->get_source_fragment();
+        EXPECT_EQ(actual.offset, expected.offset);
+        EXPECT_EQ(actual.length, expected.length);
+    }
+}
+
+TEST(AstCache, RoundTripRestoresParsedDefinitions)
+{
+    const auto source = std::make_shared<SourceFile>("test.sr", SOURCE);
+    const auto data = serialize_ast(parse(source).get());
+    ASSERT_TRUE(data.has_value());
+
+    const auto loaded = deserialize_ast(*data, source);
+    ASSERT_NE(loaded, nullptr);
+
+    const auto& context = loaded->get_context();
+    ASSERT_TRUE(context->get_type_definition("Point").has_value());
+    EXPECT_TRUE(context->get_type_definition("Point").value()->is_generic());
+    EXPECT_TRUE(context->get_type_definition("Scale").has_value());
+    EXPECT_NE(context->get_symbol_def("Color"), nullptr);
+
+    EXPECT_NO_THROW(analyze(loaded.get()));
+}
+
+TEST(AstCache, LoadedTreesGetUniqueNames)
+{
+    const auto source = std::make_shared<SourceFile>("test.sr", SOURCE);
+    const auto root = parse(source);
+    const auto data = serialize_ast(root.get());
+    ASSERT_TRUE(data.has_value());
+
+    const auto first = deserialize_ast(*data, source);
+    const auto second = deserialize_ast(*data, source);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+
+    const auto lambda_name = [](const AstBlock* block)
+    {
+        for (const auto& child : block->get_children())
+        {
+            if (const auto* declaration = dynamic_cast<AstVariableDeclaration*>(child.get()))
+            {
+                if (const auto* lambda =
+                    dynamic_cast<AstLambdaFunctionExpression*>(declaration->get_initial_value()))
+                {
+                    return std::string(lambda->get_scoped_function_name());
+                }
+            }
+        }
+        return std::string();
+    };
+
+    EXPECT_TRUE(lambda_name(first.get()).starts_with(ANONYMOUS_FN_PREFIX));
+    EXPECT_NE(lambda_name(first.get()), lambda_name(root.get()));
+    EXPECT_NE(lambda_name(first.get()), lambda_name(second.get()));
+}
+
+TEST(AstCache, RejectsMismatchingSource)
+{
+    const auto source = std::make_shared<SourceFile>("test.sr", SOURCE);
+    const auto data = serialize_ast(parse(source).get());
+    ASSERT_TRUE(data.has_value());
+
+    const auto edited = std::make_shared<SourceFile>("test.sr", SOURCE + "\n");
+    EXPECT_EQ(deserialize_ast(*data, edited), nullptr);
+}
+
+TEST(AstCache, RejectsMalformedData)
+{
+    const auto source = std::make_shared<SourceFile>("test.sr", SOURCE);
+    const auto data = serialize_ast(parse(source).get());
+    ASSERT_TRUE(data.has_value());
+
+    // Every truncation must be detected, rather than read past the end
+    for (size_t length = 0; length < data->size(); length += 7)
+    {
+        EXPECT_EQ(deserialize_ast(std::string_view(*data).substr(0, length), source), nullptr);
+    }
+
+    auto corrupt = *data;
+    corrupt.back() = static_cast<char>(0xFF);
+    EXPECT_EQ(deserialize_ast(corrupt, source), nullptr);
+}
+
+TEST(AstCache, UnchangedFilesAreLoadedFromCache)
+{
+    const TemporaryDirectory directory("cstride_ast_cache");
+    const AstCache cache(directory.path / "cache");
+
+    const auto path = directory.path / "main.sr";
+    std::ofstream(path, std::ios::binary) << SOURCE;
+
+    ThreadPool pool(2);
+    const auto parsed = Ast::parse_files({ path.string() }, pool, &cache);
+
+    ASSERT_TRUE(std::filesystem::exists(cache.get_entry_path(hash_source(SOURCE))));
+    EXPECT_NE(cache.load(read_file(path.string())), nullptr);
+
+    // A cached tree is indistinguishable from a parsed one
+    const auto loaded = Ast::parse_files({ path.string() }, pool, &cache);
+    EXPECT_EQ(
+        tree_of(loaded->get_files().at(path.string()).get()),
+        tree_of(parsed->get_files().at(path.string()).get()));
+
+    // An edit changes the key, so the file is parsed again
+    std::ofstream(path, std::ios::binary | std::ios::app) << "fn added(): void {}\n";
+    const auto edited = Ast::parse_files({ path.string() }, pool, &cache);
+    EXPECT_EQ(
+        edited->get_files().at(path.string())->get_children().size(),
+        parsed->get_files().at(path.string())->get_children().size() + 1);
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(cache.get_directory()), {}), 2);
+}
+
+TEST(AstCache, CorruptEntriesAreReparsed)
+{
+    const TemporaryDirectory directory("cstride_ast_cache_corrupt");
+    const AstCache cache(directory.path / "cache");
+
+    const auto path = directory.path / "main.sr";
+    std::ofstream(path, std::ios::binary) << SOURCE;
+    std::ofstream(cache.get_entry_path(hash_source(SOURCE)), std::ios::binary) << "not an AST";
+
+    ThreadPool pool(1);
+    const auto ast = Ast::parse_files({ path.string() }, pool, &cache);
+    EXPECT_EQ(
+        ast->get_files().at(path.string())->get_children().size(),
+        parse(read_file(path.string()))->get_children().size());
+}
+
+TEST(AstCache, ParseErrorsAreNotCached)
+{
+    const TemporaryDirectory directory("cstride_ast_cache_error");
+    const AstCache cache(directory.path / "cache");
+
+    const auto path = directory.path / "broken.sr";
+    std::ofstream(path) << "fn broken(: i32 {";
+
+    ThreadPool pool(1);
+    EXPECT_THROW(Ast::parse_files({ path.string() }, pool, &cache), parsing_error);
+    EXPECT_TRUE(std::filesystem::is_empty(cache.get_directory()));
+}
+
+TEST(AstCache, LazilyParsedFilesAreLoadedFromCache)
+{
+    const TemporaryDirectory directory("cstride_ast_cache_lazy");
+    const AstCache cache(directory.path / "cache");
+
+    const auto path = directory.path / "main.sr";
+    std::ofstream(path, std::ios::binary) << SOURCE;
+
+    ThreadPool pool(2);
+    const auto parsed = Ast::parse_files({ path.string() }, pool, &cache, true);
+
+    // Deferred bodies aren't checked, so their entries are kept apart from those of eager parses
+    ASSERT_TRUE(std::filesystem::exists(cache.get_entry_path(hash_source(SOURCE), true)));
+    EXPECT_FALSE(std::filesystem::exists(cache.get_entry_path(hash_source(SOURCE))));
+    EXPECT_EQ(cache.load(read_file(path.string())), nullptr);
+
+    const auto loaded = Ast::parse_files({ path.string() }, pool, &cache, true);
+    const auto& children = loaded->get_files().at(path.string())->get_children();
+
+    const auto* main = dynamic_cast<IAstFunction*>(children.back().get());
+    ASSERT_NE(main, nullptr);
+    EXPECT_TRUE(main->has_deferred_body());
+
+    // The stored tokens parse into the same bodies, escaped string literals included
+    EXPECT_EQ(parsed->parse_reachable_functions(), loaded->parse_reachable_functions());
+    EXPECT_FALSE(main->has_deferred_body());
+    EXPECT_EQ(
+        tree_of(loaded->get_files().at(path.string()).get()),
+        tree_of(parsed->get_files().at(path.string()).get()));
+}
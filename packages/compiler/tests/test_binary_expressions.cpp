@@ -0,0 +1,118 @@
+#include "errors.h"
+#include "utils.h"
+#include "ast/nodes/expression.h"
+
+#include <regex>
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    /// Parses a single expression and returns its tree, with identifiers and integers shown as written
+    std::string parse_tree(const std::string& code)
+    {
+        auto set = tokenizer::tokenize(std::make_shared<SourceFile>("test.sr", code));
+        const auto expression = parse_inline_expression(make_context(), set);
+        EXPECT_FALSE(set.has_next()) << "Expression wasn't fully parsed: " << code;
+
+        static const std::regex identifier(R"(Identifier<(\w+)\(\w+\)>)");
+        static const std::regex integer(R"(IntLiteral\((\d+) \(\d+ bit\)\))");
+
+        const auto tree = std::regex_replace(expression->to_string(), identifier, "$1");
+        return std::regex_replace(tree, integer, "$1");
+    }
+}
+
+TEST(BinaryExpressions, PrecedenceTableIsOrdered)
+{
+    static_assert(precedes(TokenType::STAR, TokenType::PLUS));
+    static_assert(precedes(TokenType::PLUS, TokenType::LT));
+    static_assert(precedes(TokenType::LT, TokenType::DOUBLE_EQUALS));
+    static_assert(precedes(TokenType::DOUBLE_EQUALS, TokenType::DOUBLE_AMPERSAND));
+    static_assert(precedes(TokenType::DOUBLE_AMPERSAND, TokenType::DOUBLE_PIPE));
+    static_assert(precedes(TokenType::KEYWORD_AS, TokenType::STAR));
+    static_assert(!precedes(TokenType::SLASH, TokenType::PERCENT));
+    static_assert(get_operator_precedence(TokenType::SEMICOLON).precedence == 0);
+}
+
+TEST(BinaryExpressions, ArithmeticPrecedence)
+{
+    EXPECT_EQ(parse_tree("a + b * c"), "BinaryOp(a, +, BinaryOp(b, *, c))");
+    EXPECT_EQ(parse_tree("a * b + c"), "BinaryOp(BinaryOp(a, *, b), +, c)");
+    EXPECT_EQ(parse_tree("a - b / c % d"), "BinaryOp(a, -, BinaryOp(BinaryOp(b, /, c), %, d))");
+    EXPECT_EQ(parse_tree("a * b + c * d"), "BinaryOp(BinaryOp(a, *, b), +, BinaryOp(c, *, d))");
+}
+
+TEST(BinaryExpressions, LeftAssociativity)
+{
+    EXPECT_EQ(parse_tree("a - b - c"), "BinaryOp(BinaryOp(a, -, b), -, c)");
+    EXPECT_EQ(parse_tree("a / b * c"), "BinaryOp(BinaryOp(a, /, b), *, c)");
+    EXPECT_EQ(parse_tree("a && b && c"), "LogicalOp(LogicalOp(a, &&, b), &&, c)");
+    EXPECT_EQ(parse_tree("a == b == c"), "ComparisonOp(ComparisonOp(a, ==, b), ==, c)");
+}
+
+TEST(BinaryExpressions, ComparisonPrecedence)
+{
+    EXPECT_EQ(parse_tree("a + 1 < b * 2"), "ComparisonOp(BinaryOp(a, +, 1), <, BinaryOp(b, *, 2))");
+    EXPECT_EQ(parse_tree("a < b == c >= d"), "ComparisonOp(ComparisonOp(a, <, b), ==, ComparisonOp(c, >=, d))");
+    EXPECT_EQ(parse_tree("a != b <= c"), "ComparisonOp(a, !=, ComparisonOp(b, <=, c))");
+    EXPECT_EQ(parse_tree("a > b"), "ComparisonOp(a, >, b)");
+}
+
+TEST(BinaryExpressions, LogicalPrecedence)
+{
+    EXPECT_EQ(parse_tree("a || b && c"), "LogicalOp(a, ||, LogicalOp(b, &&, c))");
+    EXPECT_EQ(parse_tree("a && b || c"), "LogicalOp(LogicalOp(a, &&, b), ||, c)");
+    EXPECT_EQ(
+        parse_tree("a < 1 || b == 2 && c"),
+        "LogicalOp(ComparisonOp(a, <, 1), ||, LogicalOp(ComparisonOp(b, ==, 2), &&, c))"
+    );
+}
+
+TEST(BinaryExpressions, UnaryOperatorsBindTightest)
+{
+    EXPECT_EQ(parse_tree("-a * b"), "BinaryOp(UnaryOp(a-), *, b)");
+    EXPECT_EQ(parse_tree("!a && b"), "LogicalOp(UnaryOp(a!), &&, b)");
+}
+
+TEST(BinaryExpressions, CastsBindTighterThanBinaryOperators)
+{
+    EXPECT_EQ(parse_tree("a as i64 + b"), "BinaryOp(TypeCastOp(a, i64), +, b)");
+    EXPECT_EQ(parse_tree("a + b as i64"), "BinaryOp(a, +, TypeCastOp(b, i64))");
+    EXPECT_EQ(parse_tree("a as i32 as i64"), "TypeCastOp(TypeCastOp(a, i32), i64)");
+}
+
+TEST(BinaryExpressions, ParenthesesOverridePrecedence)
+{
+    EXPECT_EQ(parse_tree("(a + b) * c"), "BinaryOp(BinaryOp(a, +, b), *, c)");
+    EXPECT_EQ(parse_tree("a && (b || c)"), "LogicalOp(a, &&, LogicalOp(b, ||, c))");
+}
+
+TEST(BinaryExpressions, LongExpressions)
+{
+    std::string code = "a";
+    std::string expected = "a";
+    for (int i = 0; i < 500; ++i)
+    {
+        code += " + b";
+        expected = std::format("BinaryOp({}, +, b)", expected);
+    }
+
+    EXPECT_EQ(parse_tree(code), expected);
+}
+
+TEST(BinaryExpressions, MissingOperand)
+{
+    EXPECT_THROW(parse_tree("a + ;"), parsing_error);
+    EXPECT_THROW(parse_tree("a < / b;"), parsing_error);
+}
+
+TEST(BinaryExpressions, Compiles)
+{
+    tests::assert_compiles(R"(
+        fn compute(a: i32, b: i32, c: i64): bool {
+            return a + b * 2 as i64 - c % 3 > c / 2 && a != b || !(a == 0);
+        }
+    )");
+}
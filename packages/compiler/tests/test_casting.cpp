@@ -0,0 +1,101 @@
+#include "errors.h"
+#include "utils.h"
+#include "ast/casting.h"
+#include "ast/nodes/expression.h"
+#include "ast/nodes/function_declaration.h"
+#include "ast/nodes/literal_values.h"
+#include "ast/nodes/types.h"
+
+using namespace stride;
+using namespace stride::ast;
+using namespace stride::tests;
+
+namespace
+{
+    const auto SOURCE = std::make_shared<SourceFile>("test.sr", "");
+    const SourceFragment POSITION(SOURCE, 0, 0);
+
+    std::unique_ptr<IAstExpression> make_int(const std::shared_ptr<ParsingContext>& context, const int64_t value)
+    {
+        return std::make_unique<AstIntLiteral>(POSITION, context, PrimitiveType::INT32, value);
+    }
+}
+
+TEST(Casting, KindsIdentifyConcreteClasses)
+{
+    const auto context = make_context();
+    const auto literal = make_int(context, 1);
+
+    EXPECT_EQ(literal->get_kind(), AstNodeKind::INT_LITERAL);
+    EXPECT_TRUE(isa<AstIntLiteral>(literal.get()));
+    EXPECT_TRUE(isa<AstLiteral>(literal.get()));
+    EXPECT_TRUE(isa<IAstExpression>(literal.get()));
+    EXPECT_FALSE(isa<AstFpLiteral>(literal.get()));
+    EXPECT_FALSE(isa<IBinaryOp>(literal.get()));
+    EXPECT_FALSE(isa<IAstType>(literal.get()));
+
+    // Literal base classes are told apart by their value type
+    EXPECT_TRUE(isa<IAstLiteralBase<int64_t>>(literal.get()));
+    EXPECT_FALSE(isa<IAstLiteralBase<bool>>(literal.get()));
+}
+
+TEST(Casting, DynCastChecksTheKind)
+{
+    const auto context = make_context();
+    const auto operation = std::make_unique<AstBinaryArithmeticOp>(
+        POSITION,
+        context,
+        make_int(context, 1),
+        BinaryOpType::ADD,
+        make_int(context, 2));
+    IAstNode* node = operation.get();
+
+    EXPECT_EQ(cast_ast<IBinaryOp*>(node), operation.get());
+    EXPECT_EQ(cast_expr<AstBinaryArithmeticOp*>(node), operation.get());
+    EXPECT_EQ(cast_expr<AstComparisonOp*>(node), nullptr);
+    EXPECT_EQ(cast_expr<IAstFunction*>(node), nullptr);
+    EXPECT_EQ(cast_type<IAstType*>(node), nullptr);
+    EXPECT_EQ(cast<IBinaryOp*>(node)->get_left()->get_kind(), AstNodeKind::INT_LITERAL);
+
+    const IAstNode* null_node = nullptr;
+    EXPECT_EQ(cast_expr<const IAstExpression*>(null_node), nullptr);
+
+    // Interfaces that aren't node classes are still checked with RTTI
+    EXPECT_NE(dyn_cast<IReducible*>(node), nullptr);
+    EXPECT_EQ(dyn_cast<IAstContainer*>(node), nullptr);
+}
+
+TEST(Casting, TypesHaveTypeKinds)
+{
+    const auto context = make_context();
+    const std::unique_ptr<IAstType> type = std::make_unique<AstArrayType>(
+        POSITION,
+        context,
+        std::make_unique<AstPrimitiveType>(POSITION, context, PrimitiveType::INT8),
+        0);
+
+    EXPECT_TRUE(isa<IAstType>(type.get()));
+    EXPECT_FALSE(isa<IAstExpression>(type.get()));
+    EXPECT_NE(cast_type<AstArrayType*>(type.get()), nullptr);
+    EXPECT_EQ(cast_type<AstPrimitiveType*>(type.get()), nullptr);
+
+    const auto clone = type->clone_ty();
+    EXPECT_EQ(clone->get_kind(), AstNodeKind::ARRAY_TYPE);
+}
+
+TEST(Casting, ClonedFunctionsAreFunctions)
+{
+    const auto block = parse_code("fn answer(): i32 { return 42; }");
+    ASSERT_EQ(block->get_children().size(), 1);
+
+    auto* declaration = cast_ast<AstFunctionDeclaration*>(block->get_children()[0].get());
+    ASSERT_NE(declaration, nullptr);
+    EXPECT_TRUE(isa<IAstFunction>(declaration));
+
+    // Functions clone to plain IAstFunction nodes, which have a kind of their own
+    const auto clone = declaration->clone();
+    EXPECT_EQ(clone->get_kind(), AstNodeKind::FUNCTION);
+    EXPECT_NE(cast_expr<IAstFunction*>(clone.get()), nullptr);
+    EXPECT_EQ(cast_expr<AstFunctionDeclaration*>(clone.get()), nullptr);
+    EXPECT_EQ(cast_expr<AstLambdaFunctionExpression*>(clone.get()), nullptr);
+}
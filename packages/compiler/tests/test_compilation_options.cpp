@@ -0,0 +1,84 @@
+#include "program.h"
+#include "utils.h"
+
+#include <stdexcept>
+
+using namespace stride;
+using cli::OptimizationLevel;
+
+TEST(CompilationOptions, OptimizationLevelDefaultsToO3)
+{
+    const auto options = tests::resolve_options({ "main.sr" });
+
+    EXPECT_EQ(options.optimization_level, OptimizationLevel::O3);
+    EXPECT_TRUE(options.pass_pipeline.empty());
+}
+
+TEST(CompilationOptions, OptimizationLevelsAreParsed)
+{
+    EXPECT_EQ(tests::resolve_options({ "-O0" }).optimization_level, OptimizationLevel::O0);
+    EXPECT_EQ(tests::resolve_options({ "-O1" }).optimization_level, OptimizationLevel::O1);
+    EXPECT_EQ(tests::resolve_options({ "-O2" }).optimization_level, OptimizationLevel::O2);
+    EXPECT_EQ(tests::resolve_options({ "-O3" }).optimization_level, OptimizationLevel::O3);
+    EXPECT_EQ(tests::resolve_options({ "-Os" }).optimization_level, OptimizationLevel::Os);
+    EXPECT_EQ(tests::resolve_options({ "-Oz" }).optimization_level, OptimizationLevel::Oz);
+}
+
+TEST(CompilationOptions, BareOptimizationFlagIsO2)
+{
+    EXPECT_EQ(tests::resolve_options({ "-O" }).optimization_level, OptimizationLevel::O2);
+}
+
+TEST(CompilationOptions, LastOptimizationLevelWins)
+{
+    EXPECT_EQ(tests::resolve_options({ "-O0", "-Oz" }).optimization_level, OptimizationLevel::Oz);
+}
+
+TEST(CompilationOptions, InvalidOptimizationLevelsAreRejected)
+{
+    for (const auto* level : { "-O4", "-Ofast", "-Og", "-O00", "-O 2" })
+    {
+        EXPECT_THROW(tests::resolve_options({ level }), std::invalid_argument) << level;
+    }
+}
+
+TEST(CompilationOptions, PassPipelineIsKeptAsWritten)
+{
+    const auto options = tests::resolve_options({ "-O1", "--passes=function(instcombine,simplifycfg)" });
+
+    EXPECT_EQ(options.pass_pipeline, "function(instcombine,simplifycfg)");
+    EXPECT_EQ(options.optimization_level, OptimizationLevel::O1);
+}
+
+TEST(CompilationOptions, InvalidPassPipelineIsReportedBeforeAnalysis)
+{
+    // The file doesn't type check, which would be reported first if it were analyzed
+    const tests::TemporaryFile file(
+        "cstride_invalid_pipeline.sr",
+        "fn main(): i32 { return undefined_value; }\n");
+
+    const auto options = tests::resolve_options({ "--passes=not-a-pass", file.path.string() });
+    const auto target_machine = tests::create_host_target_machine();
+    const auto program = Program::from_sources(options);
+
+    try
+    {
+        program.prepare_modules(options, target_machine.get());
+        FAIL() << "Expected the pass pipeline to be rejected";
+    }
+    catch (const std::invalid_argument& error)
+    {
+        const std::string message = error.what();
+        EXPECT_NE(message.find("Invalid pass pipeline 'not-a-pass'"), std::string::npos) << message;
+    }
+}
+
+TEST(CompilationOptions, ValidPassPipelinesAreAccepted)
+{
+    const auto target_machine = tests::create_host_target_machine();
+
+    EXPECT_NO_THROW(Program::validate_pass_pipeline(
+        tests::resolve_options({ "--passes=function(instcombine,simplifycfg)" }),
+        target_machine.get()));
+    EXPECT_NO_THROW(Program::validate_pass_pipeline(tests::resolve_options({}), target_machine.get()));
+}
@@ -0,0 +1,145 @@
+#include "errors.h"
+#include "utils.h"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    std::filesystem::path write_temp_file(const std::string& name, const std::string& content)
+    {
+        const auto path = std::filesystem::temp_directory_path() / name;
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+        return path;
+    }
+
+    std::string generate_source(const size_t min_size)
+    {
+        std::string source;
+        for (int i = 0; source.size() < min_size; ++i)
+        {
+            source += std::format("fn f{}(a: i32): i32 {{ return a + {}; }} // \"comment\"\n", i, i);
+        }
+        return source;
+    }
+}
+
+TEST(Files, SmallFilesAreRead)
+{
+    const auto path = write_temp_file("cstride_small.sr", "let x: i32 = 1;");
+    const auto file = read_file(path.string());
+
+    EXPECT_FALSE(file->is_memory_mapped());
+    EXPECT_EQ(file->source, "let x: i32 = 1;");
+
+    std::filesystem::remove(path);
+}
+
+TEST(Files, LargeFilesAreMapped)
+{
+    const auto content = generate_source(SOURCE_MMAP_THRESHOLD);
+    const auto path = write_temp_file("cstride_large.sr", content);
+    const auto file = read_file(path.string());
+
+#if defined(__unix__) || defined(__APPLE__)
+    EXPECT_TRUE(file->is_memory_mapped());
+#endif
+    EXPECT_EQ(file->source, content);
+
+    // Mapped and in-memory sources must lex identically
+    const auto mapped_tokens = tokenizer::tokenize(file);
+    const auto read_tokens = tokenizer::tokenize(std::make_shared<SourceFile>("read.sr", content));
+
+    ASSERT_EQ(mapped_tokens.size(), read_tokens.size());
+    for (int64_t i = 0; i < mapped_tokens.size(); ++i)
+    {
+        EXPECT_EQ(mapped_tokens.at(i).get_type(), read_tokens.at(i).get_type());
+        EXPECT_EQ(mapped_tokens.at(i).get_lexeme(), read_tokens.at(i).get_lexeme());
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(Files, MissingFileThrows)
+{
+    EXPECT_THROW(auto _ = read_file("/nonexistent/cstride/file.sr"), parsing_error);
+}
+
+TEST(Files, LineIndex)
+{
+    const auto file = std::make_shared<SourceFile>("lines.sr", "ab\n\ncd\nef");
+
+    const auto first = file->get_line(1);
+    EXPECT_EQ(first.number, 1);
+    EXPECT_EQ(first.start, 0);
+    EXPECT_EQ(first.end, 2);
+
+    // A line break belongs to the line it ends
+    EXPECT_EQ(file->get_line(2).number, 1);
+
+    const auto empty = file->get_line(3);
+    EXPECT_EQ(empty.number, 2);
+    EXPECT_EQ(empty.start, empty.end);
+
+    const auto last = file->get_line(8);
+    EXPECT_EQ(last.number, 4);
+    EXPECT_EQ(last.start, 7);
+    EXPECT_EQ(last.end, 9);
+}
+
+TEST(Files, DiagnosticsUseLineIndex)
+{
+    const auto file = std::make_shared<SourceFile>("lines.sr", "let a = 1;\nlet b = 2;\nlet c = oops;\n");
+    const auto offset = file->source.find("oops");
+
+    const auto error = make_source_error(ErrorType::SYNTAX_ERROR, "Bad", SourceFragment(file, offset, 4));
+
+    EXPECT_NE(error.find("3 \x1b[37mlet c = oops;"), std::string::npos) << error;
+}
+
+TEST(Files, TokensOfDestroyedFilesDontResolveToTheirSuccessor)
+{
+    auto first = std::make_shared<SourceFile>("first.sr", "first");
+    const ast::Token token(TokenType::IDENTIFIER, first->id, 0, 5);
+    const auto first_id = first->id;
+    first.reset();
+
+    // The next file takes the slot of the destroyed one, under a new generation
+    const auto second = std::make_shared<SourceFile>("second.sr", "other");
+    EXPECT_NE(second->id, first_id);
+    EXPECT_EQ(get_source_file(first_id), nullptr);
+    EXPECT_EQ(get_source_file(second->id), second.get());
+
+    EXPECT_EQ(token.get_lexeme(), "");
+    EXPECT_EQ(token.get_source_fragment().source, nullptr);
+}
+
+TEST(Files, TokensOfUnsharedFilesHaveNoFragmentSource)
+{
+    const SourceFile file("unshared.sr", "name");
+    const ast::Token token(TokenType::IDENTIFIER, file.id, 0, 4);
+
+    EXPECT_EQ(token.get_lexeme(), "name");
+    EXPECT_EQ(token.get_lexeme(file), "name");
+    EXPECT_EQ(token.get_source_fragment().source, nullptr);
+}
+
+TEST(Files, SlotsAreRetiredBeforeTheirGenerationsWrap)
+{
+    auto file = std::make_shared<SourceFile>("first.sr", "first");
+    const auto first_id = file->id;
+
+    // Each file takes the slot of the one destroyed before it, until the slot runs out of generations
+    for (int edit = 0; edit < 5000; ++edit)
+    {
+        file.reset();
+        file = std::make_shared<SourceFile>("edited.sr", "edited");
+
+        ASSERT_NE(file->id, first_id) << "after " << edit << " edits";
+        ASSERT_EQ(get_source_file(first_id), nullptr);
+    }
+}
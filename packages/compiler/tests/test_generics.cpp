@@ -1,6 +1,10 @@
+#include "errors.h"
 #include "utils.h"
+#include "ast/generics.h"
 #include <gtest/gtest.h>
 
+using namespace stride;
+using namespace stride::ast;
 using namespace stride::tests;
 
 TEST(Generics, ResolveGenericNamedTypeUnderlyingType)
@@ -98,3 +102,75 @@ TEST(Generics, FunctionSignatureMismatch)
         }
     )");
 }
+
+TEST(Generics, InstantiationsAreSharedByTheirUses)
+{
+    const auto [block, context] = parse_code_with_context(R"(
+        type Vector<T> = { x: T; y: T; };
+        const a: Vector<i32> = Vector<i32>::{ x: 1, y: 2 };
+        const b: Vector<i32> = Vector<i32>::{ x: 3, y: 4 };
+        const c: Vector<f32> = Vector<f32>::{ x: 1.0, y: 2.0 };
+    )");
+
+    const auto definition = context->get_type_definition("Vector");
+    ASSERT_TRUE(definition.has_value());
+
+    // One instantiation per distinct list of type arguments, however often it is used
+    EXPECT_EQ(definition.value()->get_instantiations().size(), 2);
+
+    const auto position = block->get_source_fragment();
+    const auto make_vector_type = [&](const PrimitiveType element_type)
+    {
+        GenericTypeList arguments;
+        arguments.push_back(std::make_unique<AstPrimitiveType>(position, context, element_type));
+        return std::make_unique<AstAliasType>(position, context, "Vector", SRFLAG_NONE, std::move(arguments));
+    };
+
+    const auto first = make_vector_type(PrimitiveType::INT32);
+    const auto second = make_vector_type(PrimitiveType::INT32);
+    const auto other = make_vector_type(PrimitiveType::FLOAT32);
+
+    EXPECT_EQ(first->get_underlying_type(), second->get_underlying_type());
+    EXPECT_NE(first->get_underlying_type(), other->get_underlying_type());
+    EXPECT_EQ(first->clone_as<AstAliasType>()->get_underlying_type(), first->get_underlying_type());
+    EXPECT_EQ(definition.value()->get_instantiations().size(), 2);
+}
+
+TEST(Generics, AliasArgumentsAreToldApartByTheirDefinitions)
+{
+    // Both modules use Box<Id>, but their Id is a different type
+    const auto [block, context] = parse_code_with_context(R"(
+        type Box<T> = { value: T; };
+        module A {
+            type Id = i32;
+            const a: Box<Id> = Box<Id>::{ value: 1 };
+        }
+        module B {
+            type Id = string;
+            const b: Box<Id> = Box<Id>::{ value: "one" };
+        }
+    )");
+
+    const auto definition = context->get_type_definition("Box");
+    ASSERT_TRUE(definition.has_value());
+
+    EXPECT_EQ(definition.value()->get_instantiations().size(), 2);
+}
+
+TEST(Generics, GenericsResolvingToThemselvesAreRejected)
+{
+    assert_throws_message(R"(
+        type Left<T> = Right<T>;
+        type Right<T> = Left<T>;
+        const value: Left<i32> = 1;
+    )", "Generic type 'Left' resolves to itself");
+}
+
+TEST(Generics, SelfReferencingMembersAreResolvedLazily)
+{
+    assert_compiles(R"(
+        type Promise<T> = { value: T; then: () -> Promise<T>; };
+        type Pair<T> = { first: Promise<T>; second: Promise<T>; };
+        fn make(p: Pair<i32>): i32 { return 0; }
+    )");
+}
@@ -0,0 +1,224 @@
+#include "errors.h"
+#include "utils.h"
+#include "ast/incremental.h"
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    const std::string SOURCE =
+        "fn first(x: i32): i32 {\n"
+        "    return x + 1;\n"
+        "}\n"
+        "fn second(x: i32): i32 {\n"
+        "    return first(x) * 2;\n"
+        "}\n"
+        "fn third(x: i32): i32 {\n"
+        "    return second(x) - 3;\n"
+        "}\n";
+
+    void analyze(AstBlock* root)
+    {
+        AstNodeTraverser traverser;
+        ImportVisitor import_visitor;
+        FunctionVisitor function_visitor;
+        ExpressionVisitor type_visitor;
+
+        import_visitor.set_current_file_name("test.sr");
+        traverser.visit_block(&import_visitor, root);
+        traverser.visit_block(&function_visitor, root);
+
+        runtime::register_runtime_symbols(root->get_context());
+        traverser.visit_block(&type_visitor, root);
+
+        root->validate();
+    }
+
+    SourceEdit replace(const std::string_view source, const std::string_view text, std::string replacement)
+    {
+        return { source.find(text), text.size(), std::move(replacement) };
+    }
+}
+
+TEST(Incremental, InitialParseParsesEveryStatement)
+{
+    IncrementalParser parser(std::make_shared<SourceFile>("test.sr", SOURCE));
+    parser.parse();
+
+    ASSERT_NE(parser.get_root(), nullptr);
+    EXPECT_EQ(parser.get_root()->get_children().size(), 3);
+    EXPECT_EQ(parser.get_parsed_statement_count(), 3);
+    EXPECT_EQ(parser.get_reused_statement_count(), 0);
+    EXPECT_NO_THROW(analyze(parser.get_root()));
+}
+
+TEST(Incremental, EditInsideFunctionOnlyReparsesThatFunction)
+{
+    IncrementalParser parser(std::make_shared<SourceFile>("test.sr", SOURCE));
+    parser.parse();
+    analyze(parser.get_root());
+
+    parser.update(replace(parser.get_source()->source, "* 2", "* 20 + 4"));
+
+    ASSERT_NE(parser.get_root(), nullptr);
+    EXPECT_EQ(parser.get_parsed_statement_count(), 1);
+    EXPECT_EQ(parser.get_reused_statement_count(), 2);
+    EXPECT_NE(parser.get_source()->source.find("* 20 + 4"), std::string_view::npos);
+
+    // Analysis starts over on the updated tree
+    EXPECT_NO_THROW(analyze(parser.get_root()));
+}
+
+TEST(Incremental, EditAddingLinesMovesFollowingStatements)
+{
+    IncrementalParser parser(std::make_shared<SourceFile>("test.sr", SOURCE));
+    parser.parse();
+
+    const auto line_of = [&](const size_t statement)
+    {
+        const auto& fragment = parser.get_root()->get_children()[statement]->get_source_fragment();
+        return fragment.source->get_line(fragment.offset).number;
+    };
+
+    parser.update(replace(parser.get_source()->source, "return x + 1;", "const y: i32 = x;\n    return y + 1;"));
+
+    ASSERT_NE(parser.get_root(), nullptr);
+    EXPECT_EQ(parser.get_root()->get_children().size(), 3);
+    EXPECT_EQ(parser.get_parsed_statement_count(), 1);
+    EXPECT_EQ(parser.get_reused_statement_count(), 2);
+    EXPECT_NO_THROW(analyze(parser.get_root()));
+
+    // The reused statements still refer to the first revision, but report the lines they moved to
+    EXPECT_NE(parser.get_root()->get_children()[2]->get_source(), parser.get_source());
+    EXPECT_EQ(line_of(1), 5);
+    EXPECT_EQ(line_of(2), 8);
+
+    parser.update(replace(parser.get_source()->source, "const y: i32 = x;\n    return y + 1;", "return x + 1;"));
+
+    ASSERT_NE(parser.get_root(), nullptr);
+    EXPECT_EQ(parser.get_reused_statement_count(), 2);
+    EXPECT_EQ(line_of(1), 4);
+    EXPECT_EQ(line_of(2), 7);
+}
+
+TEST(Incremental, RecoversFromSyntaxErrors)
+{
+    IncrementalParser parser(std::make_shared<SourceFile>("test.sr", SOURCE));
+    parser.parse();
+
+    EXPECT_THROW(
+        parser.update(replace(parser.get_source()->source, "return first(x) * 2;", "return first(x) * ;")),
+        parsing_error);
+    EXPECT_EQ(parser.get_root(), nullptr);
+
+    parser.update(replace(parser.get_source()->source, "* ;", "* 2;"));
+
+    ASSERT_NE(parser.get_root(), nullptr);
+    EXPECT_EQ(parser.get_root()->get_children().size(), 3);
+    EXPECT_EQ(parser.get_source()->source, SOURCE);
+    EXPECT_NO_THROW(analyze(parser.get_root()));
+}
+
+TEST(Incremental, DuplicateTypeIsReported)
+{
+    const std::string code =
+        "type First = {\n"
+        "    value: i32;\n"
+        "};\n"
+        "type Second = {\n"
+        "    value: i32;\n"
+        "};\n"
+        "type Third = {\n"
+        "    value: i32;\n"
+        "};\n";
+
+    IncrementalParser parser(std::make_shared<SourceFile>("test.sr", code));
+    parser.parse();
+
+    EXPECT_THROW(
+        parser.update(replace(parser.get_source()->source, "type Third", "type First")),
+        parsing_error);
+    EXPECT_EQ(parser.get_root(), nullptr);
+
+    const auto source = parser.get_source()->source;
+    parser.update({ source.rfind("First"), 5, "Fourth" });
+
+    ASSERT_NE(parser.get_root(), nullptr);
+    EXPECT_EQ(parser.get_root()->get_children().size(), 3);
+
+    // The second type ends right before the edit, within the lookahead of the parser
+    EXPECT_EQ(parser.get_reused_statement_count(), 1);
+    EXPECT_EQ(parser.get_parsed_statement_count(), 2);
+}
+
+TEST(Incremental, ReusedTypeConflictingWithRenamedTypeIsParsedAgain)
+{
+    const std::string code =
+        "type First = {\n"
+        "    value: i32;\n"
+        "};\n"
+        "type Second = {\n"
+        "    value: i32;\n"
+        "};\n"
+        "type Third = {\n"
+        "    value: i32;\n"
+        "};\n";
+
+    IncrementalParser fresh(std::make_shared<SourceFile>("test.sr", code));
+    fresh.parse();
+    const auto definition_count = fresh.get_context()->get_symbol_count();
+
+    IncrementalParser parser(std::make_shared<SourceFile>("test.sr", code));
+    parser.parse();
+
+    // The reused third type conflicts with the renamed first one, so it is dropped with its definitions
+    EXPECT_THROW(
+        parser.update(replace(parser.get_source()->source, "type First", "type Third")),
+        parsing_error);
+    EXPECT_EQ(parser.get_root(), nullptr);
+
+    parser.update(replace(parser.get_source()->source, "type Third", "type First"));
+
+    ASSERT_NE(parser.get_root(), nullptr);
+    EXPECT_EQ(parser.get_root()->get_children().size(), 3);
+    EXPECT_EQ(parser.get_source()->source, code);
+    EXPECT_EQ(parser.get_context()->get_symbol_count(), definition_count);
+
+    parser.update(replace(parser.get_source()->source, "type Second", "type Fourth"));
+
+    ASSERT_NE(parser.get_root(), nullptr);
+    EXPECT_EQ(parser.get_root()->get_children().size(), 3);
+    EXPECT_EQ(parser.get_context()->get_symbol_count(), definition_count);
+}
+
+TEST(Incremental, ReusedStatementsUseTheInstantiationsOfReparsedGenericTypes)
+{
+    const std::string code =
+        "type Vector<T> = {\n"
+        "    x: T;\n"
+        "    y: T;\n"
+        "};\n"
+        "fn sum(): i32 {\n"
+        "    const v: Vector<i32> = Vector<i32>::{ x: 1, y: 2 };\n"
+        "    return v.x + v.y;\n"
+        "}\n";
+
+    IncrementalParser parser(std::make_shared<SourceFile>("test.sr", code));
+    parser.parse();
+    analyze(parser.get_root());
+
+    // The function keeps its instantiation of the previous definition, which is destroyed with it
+    parser.update(replace(parser.get_source()->source, "Vector<T> = {\n    x: T;\n    y: T;", "Vector<U> = {\n    x: U;\n    y: U;"));
+
+    ASSERT_NE(parser.get_root(), nullptr);
+    EXPECT_EQ(parser.get_reused_statement_count(), 1);
+    EXPECT_NO_THROW(analyze(parser.get_root()));
+
+    // Once a member is renamed, the function no longer type checks
+    parser.update(replace(parser.get_source()->source, "    x: U;", "    z: U;"));
+
+    ASSERT_NE(parser.get_root(), nullptr);
+    EXPECT_EQ(parser.get_reused_statement_count(), 1);
+    EXPECT_THROW(analyze(parser.get_root()), parsing_error);
+}
@@ -0,0 +1,90 @@
+#include "utils.h"
+#include "ast/interner.h"
+#include "ast/symbols.h"
+
+#include <thread>
+
+using namespace stride;
+using namespace stride::ast;
+
+TEST(Interner, SameStringSameId)
+{
+    const auto first = InternedString("interner_test_value");
+    const auto second = InternedString(std::string("interner_") + "test_value");
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first.id(), second.id());
+    EXPECT_EQ(first.str(), "interner_test_value");
+    EXPECT_NE(first, InternedString("interner_test_other"));
+}
+
+TEST(Interner, EmptyStringIsDefault)
+{
+    EXPECT_EQ(InternedString(), InternedString(""));
+    EXPECT_TRUE(InternedString().empty());
+    EXPECT_EQ(InternedString().str(), "");
+}
+
+TEST(Interner, FindDoesNotIntern)
+{
+    const auto size = interner::size();
+
+    EXPECT_FALSE(InternedString::find("interner_test_never_interned").has_value());
+    EXPECT_EQ(interner::size(), size);
+
+    const auto interned = InternedString("interner_test_found");
+    EXPECT_EQ(InternedString::find("interner_test_found"), interned);
+}
+
+TEST(Interner, LexerInternsIdentifiers)
+{
+    const auto source = std::make_shared<SourceFile>("test.sr", "let interner_test_identifier = 1;");
+    const auto _ = tokenizer::tokenize(source);
+
+    EXPECT_TRUE(InternedString::find("interner_test_identifier").has_value());
+}
+
+TEST(Interner, SymbolsCompareInternalNames)
+{
+    const auto a = Symbol(SourceFragment(nullptr, 0, 0), "module", "value");
+    const auto b = Symbol(SourceFragment(nullptr, 0, 0), "module__value");
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.internal_name.str(), "module__value");
+    EXPECT_NE(a.name, b.name);
+}
+
+TEST(Interner, ConcurrentInterning)
+{
+    constexpr int thread_count = 8;
+    constexpr int names_per_thread = 2000;
+
+    std::vector<std::vector<InternedId>> ids(thread_count);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (int i = 0; i < names_per_thread; ++i)
+            {
+                ids[t].push_back(interner::intern("interner_test_concurrent_" + std::to_string(i)));
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int t = 1; t < thread_count; ++t)
+    {
+        EXPECT_EQ(ids[0], ids[t]);
+    }
+
+    for (int i = 0; i < names_per_thread; ++i)
+    {
+        EXPECT_EQ(interner::resolve(ids[0][i]), "interner_test_concurrent_" + std::to_string(i));
+    }
+}
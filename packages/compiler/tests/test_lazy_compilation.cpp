@@ -0,0 +1,60 @@
+#include "program.h"
+#include "utils.h"
+
+#include <stdexcept>
+
+using namespace stride;
+
+namespace
+{
+    const std::string SOURCE =
+        "module Math {\n"
+        "    fn square(x: i32): i32 { return x * x; }\n"
+        "}\n"
+        "fn never_called(): i32 { return 1; }\n"
+        "fn main(): i32 {\n"
+        "    return Math::square(6) + 6;\n"
+        "}\n";
+
+    int run(const tests::TemporaryFile& file, const std::string& lazy_argument)
+    {
+        const auto options = tests::resolve_options({ lazy_argument, file.path.string() });
+        const auto program = Program::from_sources(options);
+
+        return program.compile_jit(options);
+    }
+}
+
+TEST(LazyCompilation, OptionsSelectThePartitioning)
+{
+    const auto by_function = tests::resolve_options({ "--lazy" });
+    EXPECT_TRUE(by_function.lazy_compilation);
+    EXPECT_EQ(by_function.lazy_partitioning, cli::LazyPartitioning::FUNCTION);
+
+    const auto by_file = tests::resolve_options({ "--lazy=file" });
+    EXPECT_TRUE(by_file.lazy_compilation);
+    EXPECT_EQ(by_file.lazy_partitioning, cli::LazyPartitioning::FILE);
+
+    EXPECT_FALSE(tests::resolve_options({}).lazy_compilation);
+    EXPECT_THROW(tests::resolve_options({ "--lazy=module" }), std::invalid_argument);
+}
+
+TEST(LazyCompilation, CantBeCombinedWithTiers)
+{
+    EXPECT_THROW(tests::resolve_options({ "--lazy", "--tiered" }), std::invalid_argument);
+    EXPECT_THROW(tests::resolve_options({ "--tiered", "--lazy=file" }), std::invalid_argument);
+}
+
+TEST(LazyCompilation, FunctionsRunWhenCompiledOnTheirFirstCall)
+{
+    const tests::TemporaryFile file("cstride_lazy_function.sr", SOURCE);
+
+    EXPECT_EQ(run(file, "--lazy"), 42);
+}
+
+TEST(LazyCompilation, FilesRunWhenCompiledOnTheirFirstCall)
+{
+    const tests::TemporaryFile file("cstride_lazy_file.sr", SOURCE);
+
+    EXPECT_EQ(run(file, "--lazy=file"), 42);
+}
@@ -0,0 +1,197 @@
+#include "errors.h"
+#include "utils.h"
+#include "thread_pool.h"
+#include "ast/nodes/function_declaration.h"
+#include "ast/nodes/module.h"
+
+#include <ranges>
+#include <regex>
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    const std::string SOURCE =
+        "module Math {\n"
+        "    fn square(x: i32): i32 { return x * x; }\n"
+        "    fn cube(x: i32): i32 { return x * x * x; }\n"
+        "}\n"
+        "fn factorial(n: i32): i32 {\n"
+        "    if (n <= 1) { return 1; }\n"
+        "    return n * factorial(n - 1);\n"
+        "}\n"
+        "fn unused(): i32 {\n"
+        "    return \"not an i32\" + * ;\n"
+        "}\n"
+        "pub fn exported(): i32 { return 1; }\n"
+        "fn main(): i32 {\n"
+        "    return Math::square(3) + factorial(4);\n"
+        "}\n";
+
+    std::unique_ptr<Ast> parse_lazily(const tests::TemporaryFile& file)
+    {
+        ThreadPool pool(1);
+        return Ast::parse_files({ file.path.string() }, pool, nullptr, true);
+    }
+
+    /// All named functions of a file, including those in modules
+    void collect_functions(const AstBlock* block, std::vector<IAstFunction*>& functions)
+    {
+        for (const auto& child : block->get_children())
+        {
+            if (auto* function = dynamic_cast<IAstFunction*>(child.get()))
+            {
+                functions.push_back(function);
+            }
+            else if (auto* module = dynamic_cast<AstModule*>(child.get()))
+            {
+                collect_functions(module->get_body(), functions);
+            }
+        }
+    }
+
+    std::vector<std::string> deferred_functions(Ast& ast)
+    {
+        std::vector<IAstFunction*> functions;
+        for (const auto& node : ast.get_files() | std::views::values)
+        {
+            collect_functions(node.get(), functions);
+        }
+
+        std::vector<std::string> names;
+        for (const auto* function : functions)
+        {
+            if (function->has_deferred_body())
+            {
+                names.push_back(function->get_function_name());
+            }
+        }
+        return names;
+    }
+
+    void compile(Ast& ast, llvm::Module& module)
+    {
+        AstArena::Scope arena_scope(ast.get_arena());
+
+        AstNodeTraverser traverser;
+        ImportVisitor import_visitor;
+        FunctionVisitor function_visitor;
+        ExpressionVisitor type_visitor;
+
+        for (const auto& [file_name, node] : ast.get_files())
+        {
+            import_visitor.set_current_file_name(file_name);
+            traverser.visit_block(&import_visitor, node.get());
+            traverser.visit_block(&function_visitor, node.get());
+        }
+
+        llvm::IRBuilder<> builder(module.getContext());
+        for (const auto& node : ast.get_files() | std::views::values)
+        {
+            runtime::register_runtime_symbols(node->get_context());
+            traverser.visit_block(&type_visitor, node.get());
+
+            node->validate();
+            node->resolve_forward_references(&module, &builder);
+            node->codegen(&module, &builder);
+        }
+    }
+}
+
+TEST(LazyParsing, DefersFunctionBodies)
+{
+    const tests::TemporaryFile file("cstride_lazy_defer.sr", SOURCE + "fn generic<T>(value: T): T { return value; }\n");
+    const auto ast = parse_lazily(file);
+
+    // Generic functions are always parsed
+    EXPECT_EQ(
+        deferred_functions(*ast),
+        (std::vector<std::string>{ "square", "cube", "factorial", "unused", "exported", "main" }));
+}
+
+TEST(LazyParsing, ParsesReachableFunctionsOnly)
+{
+    // Functions are matched by name only, so both functions named square are parsed
+    const tests::TemporaryFile file(
+        "cstride_lazy_reachable.sr",
+        SOURCE + "module Extra { fn square(x: i64): i64 { return x * x; } }\n");
+    const auto ast = parse_lazily(file);
+
+    EXPECT_EQ(ast->parse_reachable_functions(), 5);
+    EXPECT_EQ(deferred_functions(*ast), (std::vector<std::string>{ "cube", "unused" }));
+
+    // Nothing is left to parse afterwards
+    EXPECT_EQ(ast->parse_reachable_functions(), 0);
+}
+
+TEST(LazyParsing, UnreachableFunctionsAreNotGenerated)
+{
+    const tests::TemporaryFile file("cstride_lazy_codegen.sr", SOURCE);
+    const auto ast = parse_lazily(file);
+    ast->parse_reachable_functions();
+
+    llvm::LLVMContext context;
+    llvm::Module module("test_module", context);
+    ASSERT_NO_THROW(compile(*ast, module));
+
+    EXPECT_NE(module.getFunction("main"), nullptr);
+    EXPECT_NE(module.getFunction("factorial"), nullptr);
+
+    for (const auto& function : module.functions())
+    {
+        EXPECT_FALSE(function.getName().contains("unused"));
+        EXPECT_FALSE(function.getName().contains("cube"));
+    }
+}
+
+TEST(LazyParsing, MatchesEagerParsing)
+{
+    const std::string source =
+        "module Math { fn square(x: i32): i32 { return x * x; } }\n"
+        "fn main(): i32 {\n"
+        "    let value: i32 = Math::square(3);\n"
+        "    return value;\n"
+        "}\n";
+    const tests::TemporaryFile file("cstride_lazy_eager.sr", source);
+
+    ThreadPool pool(1);
+    const auto eager = Ast::parse_files({ file.path.string() }, pool);
+    const auto lazy = parse_lazily(file);
+    lazy->parse_reachable_functions();
+
+    const auto& eager_file = eager->get_files().at(file.path.string());
+    const auto& lazy_file = lazy->get_files().at(file.path.string());
+    ASSERT_EQ(lazy_file->get_children().size(), eager_file->get_children().size());
+
+    for (size_t i = 0; i < eager_file->get_children().size(); ++i)
+    {
+        // Local variables get a unique suffix each time they are parsed
+        const auto without_suffixes = [](std::string tree)
+        {
+            return std::regex_replace(tree, std::regex(R"(\(([A-Za-z_][\w]*)\.\d+\))"), "($1)");
+        };
+
+        EXPECT_EQ(
+            without_suffixes(lazy_file->get_children()[i]->to_string()),
+            without_suffixes(eager_file->get_children()[i]->to_string()));
+    }
+}
+
+TEST(LazyParsing, MalformedBodiesAreReportedRightAway)
+{
+    const tests::TemporaryFile file("cstride_lazy_unbalanced.sr", "fn broken(): i32 { return 1;\n");
+
+    EXPECT_THROW(parse_lazily(file), parsing_error);
+}
+
+TEST(LazyParsing, ErrorsInReachedBodiesAreReported)
+{
+    const tests::TemporaryFile file(
+        "cstride_lazy_error.sr",
+        "fn helper(): i32 { return 1 + * ; }\n"
+        "fn main(): i32 { return helper(); }\n");
+    const auto ast = parse_lazily(file);
+
+    EXPECT_THROW(ast->parse_reachable_functions(), parsing_error);
+}
@@ -0,0 +1,260 @@
+#include "errors.h"
+#include "thread_pool.h"
+#include "utils.h"
+#include "ast/symbols.h"
+
+#include <atomic>
+#include <mutex>
+#include <ranges>
+#include <set>
+#include <thread>
+
+using namespace stride;
+using namespace stride::ast;
+using namespace stride::tests;
+
+namespace
+{
+    /// Counts the files it visits, and the threads it visits them from
+    class ThreadRecordingVisitor : public IVisitor
+    {
+        bool _thread_safe;
+        std::mutex _mutex;
+        std::vector<std::string> _files;
+        std::set<std::thread::id> _threads;
+
+    public:
+        explicit ThreadRecordingVisitor(const bool thread_safe) :
+            _thread_safe(thread_safe) {}
+
+        void begin_file(const std::string& file_name, AstBlock*) override
+        {
+            std::lock_guard lock(this->_mutex);
+            this->_files.push_back(file_name);
+            this->_threads.insert(std::this_thread::get_id());
+        }
+
+        [[nodiscard]]
+        bool is_thread_safe() const override
+        {
+            return this->_thread_safe;
+        }
+
+        [[nodiscard]]
+        std::vector<std::string> get_sorted_files()
+        {
+            std::lock_guard lock(this->_mutex);
+            auto files = this->_files;
+            std::ranges::sort(files);
+            return files;
+        }
+
+        [[nodiscard]]
+        const std::set<std::thread::id>& get_threads() const
+        {
+            return this->_threads;
+        }
+    };
+
+    std::unique_ptr<AstBlock> parse_file(const std::string& path, const std::string& code)
+    {
+        const auto source = std::make_shared<SourceFile>(path, code);
+        auto tokens = tokenizer::tokenize(source);
+        return parse_sequential(std::make_shared<ParsingContext>(), tokens);
+    }
+
+    parsing_error make_error(const std::shared_ptr<SourceFile>& source, const size_t offset, const std::string& message)
+    {
+        return parsing_error(ErrorType::SEMANTIC_ERROR, message, SourceFragment(source, offset, 1));
+    }
+
+    std::map<std::string, std::unique_ptr<AstBlock>> make_files(const size_t count, const bool with_errors)
+    {
+        std::map<std::string, std::unique_ptr<AstBlock>> files;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto path = std::format("file_{:02}.sr", i);
+            const auto value = with_errors ? std::format("undefined_{}", i) : std::to_string(i);
+            files.emplace(path, parse_file(path, std::format("fn f_{}(): i32 {{ return {}; }}", i, value)));
+        }
+        return files;
+    }
+}
+
+TEST(ParallelAnalysis, ErrorsAreSortedByFileAndOffset)
+{
+    const auto a = std::make_shared<SourceFile>("a.sr", "0123456789abcdef");
+    const auto b = std::make_shared<SourceFile>("b.sr", "0123456789abcdef");
+
+    std::vector<std::exception_ptr> errors = {
+        std::make_exception_ptr(make_error(b, 1, "first in b")),
+        std::make_exception_ptr(make_error(a, 12, "second in a")),
+        std::make_exception_ptr(parsing_error("no position")),
+        std::make_exception_ptr(make_error(a, 3, "first in a")),
+    };
+
+    try
+    {
+        rethrow_sorted_errors(errors);
+    }
+    catch (const parsing_error& error)
+    {
+        const std::string message = error.what();
+        const auto first_in_a = message.find("first in a");
+        const auto second_in_a = message.find("second in a");
+        const auto first_in_b = message.find("first in b");
+        const auto no_position = message.find("no position");
+
+        ASSERT_NE(no_position, std::string::npos);
+        EXPECT_LT(first_in_a, second_in_a);
+        EXPECT_LT(second_in_a, first_in_b);
+        EXPECT_LT(first_in_b, no_position);
+    }
+}
+
+TEST(ParallelAnalysis, SingleErrorsAreRethrownAsIs)
+{
+    const auto error = std::make_exception_ptr(std::runtime_error("only error"));
+    EXPECT_THROW(rethrow_sorted_errors({ error }), std::runtime_error);
+
+    // Errors that can't be combined are reported by the first one
+    const auto source = std::make_shared<SourceFile>("a.sr", "0123456789");
+    try
+    {
+        rethrow_sorted_errors({
+            std::make_exception_ptr(std::runtime_error("unpositioned")),
+            std::make_exception_ptr(make_error(source, 4, "positioned"))
+        });
+        FAIL() << "Expected an error";
+    }
+    catch (const parsing_error& error)
+    {
+        EXPECT_TRUE(error.get_source_position().has_value());
+        EXPECT_NE(std::string(error.what()).find("positioned"), std::string::npos);
+    }
+}
+
+TEST(ParallelAnalysis, ThreadSafePhasesVisitFilesConcurrently)
+{
+    ThreadPool pool(4);
+    ThreadRecordingVisitor sequential(false);
+    ThreadRecordingVisitor concurrent(true);
+
+    std::atomic<size_t> completed_files = 0;
+
+    VisitorPipeline pipeline;
+    pipeline.add(&sequential);
+    pipeline.add(&concurrent, { &sequential });
+    pipeline.on_file_complete(&concurrent, [&](const std::string&, AstBlock*) { ++completed_files; });
+
+    const auto files = make_files(16, false);
+    pipeline.run(files, pool);
+
+    std::vector<std::string> expected_files;
+    for (const auto& file_name : files | std::views::keys)
+    {
+        expected_files.push_back(file_name);
+    }
+
+    EXPECT_EQ(sequential.get_sorted_files(), expected_files);
+    EXPECT_EQ(concurrent.get_sorted_files(), expected_files);
+    EXPECT_EQ(completed_files, files.size());
+
+    // Visitors that aren't thread-safe stay on the calling thread
+    EXPECT_EQ(sequential.get_threads(), std::set{ std::this_thread::get_id() });
+    EXPECT_FALSE(concurrent.get_threads().contains(std::this_thread::get_id()));
+}
+
+TEST(ParallelAnalysis, ErrorsOfConcurrentFilesAreDeterministic)
+{
+    ThreadPool pool(4);
+
+    std::optional<std::string> first_message;
+    for (int run = 0; run < 5; ++run)
+    {
+        ExpressionVisitor type_visitor;
+        FunctionVisitor function_visitor;
+
+        VisitorPipeline pipeline;
+        pipeline.add(&function_visitor);
+        pipeline.add(&type_visitor, { &function_visitor });
+
+        const auto files = make_files(8, true);
+        try
+        {
+            pipeline.run(files, pool);
+            FAIL() << "Expected the undefined identifiers to be reported";
+        }
+        catch (const parsing_error& error)
+        {
+            const std::string message = error.what();
+
+            // Every file reports its error, in the order of the files
+            size_t previous = 0;
+            for (size_t i = 0; i < files.size(); ++i)
+            {
+                const auto position = message.find(std::format("undefined_{}", i));
+                ASSERT_NE(position, std::string::npos) << message;
+                EXPECT_GE(position, previous);
+                previous = position;
+            }
+
+            if (first_message.has_value())
+            {
+                EXPECT_EQ(message, first_message.value());
+            }
+            first_message = message;
+        }
+    }
+}
+
+TEST(ParallelAnalysis, RootTypesCanBeLookedUpWhileDefining)
+{
+    const auto source = std::make_shared<SourceFile>("types.sr", "");
+    const SourceFragment position(source, 0, 0);
+    const auto root = std::make_shared<ParsingContext>();
+
+    root->define_type(
+        Symbol(position, "Shared"),
+        std::make_unique<AstPrimitiveType>(position, root, PrimitiveType::INT32),
+        {},
+        VisibilityModifier::PUBLIC);
+
+    std::atomic<bool> defining = true;
+    std::atomic<size_t> missed_lookups = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i)
+    {
+        readers.emplace_back(
+            [&]
+            {
+                do
+                {
+                    if (!root->get_type_definition("Shared").has_value())
+                    {
+                        ++missed_lookups;
+                    }
+                }
+                while (defining);
+            });
+    }
+
+    // Global variables are defined in the root context of their file while other files read it
+    for (int i = 0; i < 2000; ++i)
+    {
+        root->define_variable(
+            Symbol(position, std::format("global_{}", i)),
+            std::make_unique<AstPrimitiveType>(position, root, PrimitiveType::INT64),
+            VisibilityModifier::PRIVATE);
+    }
+
+    defining = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(missed_lookups, 0);
+    EXPECT_EQ(root->get_symbol_count(), 2001);
+}
@@ -0,0 +1,163 @@
+#include "errors.h"
+#include "utils.h"
+
+#include <thread>
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    /// Analyzes and lowers the files through the compiler's own pipeline, one module per file
+    std::vector<llvm::orc::ThreadSafeModule> prepare_modules(const std::vector<const tests::TemporaryFile*>& files)
+    {
+        std::vector<std::string> arguments = { "-O0" };
+        for (const auto* file : files)
+        {
+            arguments.push_back(file->path.string());
+        }
+
+        const auto options = tests::resolve_options(arguments);
+        const auto target_machine = tests::create_host_target_machine();
+        const auto program = Program::from_sources(options);
+
+        return program.prepare_modules(options, target_machine.get());
+    }
+
+    llvm::Function* find_function(const llvm::Module& module, const std::string& name_part)
+    {
+        for (auto& function : module.functions())
+        {
+            if (function.getName().contains(name_part))
+            {
+                return const_cast<llvm::Function*>(&function);
+            }
+        }
+        return nullptr;
+    }
+}
+
+TEST(ParallelCodegen, FilesAreLoweredIntoContextsOfTheirOwn)
+{
+    const tests::TemporaryFile geometry(
+        "parallel_codegen_geometry.sr",
+        "package Geometry;\n"
+        "module shapes {\n"
+        "    pub fn area(width: i32, height: i32): i32 { return width * height; }\n"
+        "}\n");
+    const tests::TemporaryFile main_file(
+        "parallel_codegen_main.sr",
+        "import Geometry::{\n"
+        "    shapes::area,\n"
+        "};\n"
+        "fn main(): i32 {\n"
+        "    for (let i: i32 = 0; i < 3; i++) {\n"
+        "        if (shapes::area(i, 2) > 2) {\n"
+        "            return i;\n"
+        "        }\n"
+        "    }\n"
+        "    return 0;\n"
+        "}\n");
+
+    // Modules are returned in the order of their files, which have been verified while lowering
+    const auto modules = prepare_modules({ &geometry, &main_file });
+    ASSERT_EQ(modules.size(), 2);
+
+    const auto* geometry_module = modules[0].getModuleUnlocked();
+    const auto* main_module = modules[1].getModuleUnlocked();
+    ASSERT_EQ(geometry_module->getName(), geometry.path.string());
+
+    // The function is defined by its own file, and only declared by the file calling it
+    const auto* definition = find_function(*geometry_module, "area");
+    const auto* declaration = find_function(*main_module, "area");
+    ASSERT_NE(definition, nullptr);
+    ASSERT_NE(declaration, nullptr);
+
+    EXPECT_FALSE(definition->isDeclaration());
+    EXPECT_TRUE(declaration->isDeclaration());
+    EXPECT_EQ(definition->getName(), declaration->getName());
+    EXPECT_NE(&definition->getContext(), &declaration->getContext());
+}
+
+TEST(ParallelCodegen, GlobalsOfOtherFilesAreDeclared)
+{
+    const tests::TemporaryFile constants(
+        "parallel_codegen_constants.sr",
+        "package Constants;\n"
+        "module limits {\n"
+        "    pub const maximum: i32 = 16;\n"
+        "}\n");
+    const tests::TemporaryFile main_file(
+        "parallel_codegen_limits.sr",
+        "import Constants::{\n"
+        "    limits::maximum,\n"
+        "};\n"
+        "fn main(): i32 {\n"
+        "    return limits::maximum * 2;\n"
+        "}\n");
+
+    const auto modules = prepare_modules({ &constants, &main_file });
+    ASSERT_EQ(modules.size(), 2);
+
+    const auto* constants_module = modules[0].getModuleUnlocked();
+    const auto* main_module = modules[1].getModuleUnlocked();
+
+    // The global is defined by its own file, and declared as an external global by the file reading it
+    const llvm::GlobalVariable* definition = nullptr;
+    for (const auto& global : constants_module->globals())
+    {
+        if (global.getName().contains("maximum"))
+        {
+            definition = &global;
+        }
+    }
+    ASSERT_NE(definition, nullptr);
+
+    const auto* declaration = main_module->getNamedGlobal(definition->getName());
+    ASSERT_NE(declaration, nullptr);
+
+    EXPECT_FALSE(definition->isDeclaration());
+    EXPECT_TRUE(declaration->isDeclaration());
+    EXPECT_EQ(declaration->getLinkage(), llvm::GlobalValue::ExternalLinkage);
+}
+
+TEST(ParallelCodegen, LoopsOfConcurrentFilesDontShareTheirBlocks)
+{
+    // Break and continue resolve against the loop stack of the thread lowering the file
+    std::vector<std::thread> threads;
+    std::atomic<size_t> failures = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [&failures, i]
+            {
+                try
+                {
+                    for (int iteration = 0; iteration < 10; ++iteration)
+                    {
+                        tests::assert_compiles(std::format(
+                            "fn main(): i32 {{\n"
+                            "    for (let j: i32 = 0; j < {}; j++) {{\n"
+                            "        if (j == 2) {{ continue; }}\n"
+                            "        if (j == 5) {{ break; }}\n"
+                            "    }}\n"
+                            "    return 0;\n"
+                            "}}\n",
+                            i + 8));
+                    }
+                }
+                catch (...)
+                {
+                    ++failures;
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures, 0);
+}
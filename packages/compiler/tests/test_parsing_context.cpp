@@ -0,0 +1,220 @@
+#include "errors.h"
+#include "utils.h"
+
+using namespace stride;
+using namespace stride::ast;
+using namespace stride::ast::definition;
+
+namespace
+{
+    const auto SOURCE = std::make_shared<SourceFile>("test.sr", "");
+    const SourceFragment POSITION(SOURCE, 0, 0);
+
+    std::unique_ptr<IAstType> make_type(const std::shared_ptr<ParsingContext>& context, const PrimitiveType type)
+    {
+        return std::make_unique<AstPrimitiveType>(POSITION, context, type);
+    }
+
+    std::unique_ptr<AstFunctionType> make_function_type(
+        const std::shared_ptr<ParsingContext>& context,
+        const PrimitiveType parameter_type
+    )
+    {
+        std::vector<std::unique_ptr<IAstType>> parameters;
+        parameters.push_back(make_type(context, parameter_type));
+
+        return std::make_unique<AstFunctionType>(
+            POSITION,
+            context,
+            std::move(parameters),
+            make_type(context, PrimitiveType::INT32));
+    }
+
+    bool is_primitive(const IAstType* type, const PrimitiveType expected)
+    {
+        const auto* primitive = dynamic_cast<const AstPrimitiveType*>(type);
+        return primitive != nullptr && primitive->get_primitive_type() == expected;
+    }
+}
+
+TEST(ParsingContext, InnerScopesShadowOuterScopes)
+{
+    const auto global = make_context();
+    const auto function = make_context(global, ContextType::FUNCTION);
+    const auto block = make_context(function, ContextType::CONTROL_FLOW);
+
+    global->define_variable(Symbol(POSITION, "value"), make_type(global, PrimitiveType::INT32), VisibilityModifier::PUBLIC);
+    function->define_variable(Symbol(POSITION, "value"), make_type(function, PrimitiveType::INT64), VisibilityModifier::PRIVATE);
+
+    ASSERT_NE(block->lookup_variable("value"), nullptr);
+    EXPECT_TRUE(is_primitive(block->lookup_variable("value")->get_type(), PrimitiveType::INT64));
+    EXPECT_TRUE(is_primitive(global->lookup_variable("value")->get_type(), PrimitiveType::INT32));
+
+    EXPECT_TRUE(block->is_field_defined_globally("value"));
+    EXPECT_FALSE(block->is_field_defined_in_scope("value"));
+    EXPECT_EQ(block->lookup_variable("missing"), nullptr);
+}
+
+TEST(ParsingContext, RawNamesMatchTheFirstDefinition)
+{
+    const auto global = make_context();
+    const auto function = make_context(global, ContextType::FUNCTION);
+
+    function->define_variable(
+        Symbol(POSITION, "", "counter", "counter.1"),
+        make_type(function, PrimitiveType::INT32),
+        VisibilityModifier::PRIVATE);
+    function->define_variable(
+        Symbol(POSITION, "", "counter", "counter.2"),
+        make_type(function, PrimitiveType::INT64),
+        VisibilityModifier::PRIVATE);
+
+    EXPECT_EQ(function->get_variable_def("counter"), nullptr);
+    ASSERT_NE(function->get_variable_def("counter", true), nullptr);
+    EXPECT_EQ(function->get_variable_def("counter", true)->get_internal_symbol_name(), "counter.1");
+    EXPECT_EQ(function->get_variable_def("counter.2")->get_internal_symbol_name(), "counter.2");
+}
+
+TEST(ParsingContext, OverloadsAreFoundBySignature)
+{
+    const auto global = make_context();
+    const auto function = make_context(global, ContextType::FUNCTION);
+
+    global->define_function(Symbol(POSITION, "convert"), make_function_type(global, PrimitiveType::INT32), VisibilityModifier::PUBLIC);
+    global->define_function(Symbol(POSITION, "convert"), make_function_type(global, PrimitiveType::FLOAT64), VisibilityModifier::PUBLIC);
+
+    std::vector<std::unique_ptr<IAstType>> arguments;
+    arguments.push_back(make_type(global, PrimitiveType::FLOAT64));
+
+    const auto definition = function->get_function_definition("convert", arguments);
+    ASSERT_TRUE(definition.has_value());
+    EXPECT_TRUE(is_primitive(definition.value()->get_type()->get_parameter_types()[0].get(), PrimitiveType::FLOAT64));
+
+    arguments.push_back(make_type(global, PrimitiveType::FLOAT64));
+    EXPECT_FALSE(function->get_function_definition("convert", arguments).has_value());
+
+    EXPECT_THROW(
+        global->define_function(Symbol(POSITION, "convert"), make_function_type(global, PrimitiveType::INT32), VisibilityModifier::PUBLIC),
+        parsing_error);
+}
+
+TEST(ParsingContext, DiscardedDefinitionsAreNoLongerFound)
+{
+    const auto global = make_context();
+    global->define_type(Symbol(POSITION, "Parsed"), make_type(global, PrimitiveType::INT32), {}, VisibilityModifier::PUBLIC);
+    global->mark_parsed();
+
+    global->define_variable(Symbol(POSITION, "analyzed"), make_type(global, PrimitiveType::INT32), VisibilityModifier::PUBLIC);
+    global->define_function(Symbol(POSITION, "helper"), make_function_type(global, PrimitiveType::INT32), VisibilityModifier::PUBLIC);
+    ASSERT_NE(global->lookup_variable("analyzed"), nullptr);
+
+    global->discard_analysis();
+
+    EXPECT_EQ(global->lookup_variable("analyzed"), nullptr);
+    EXPECT_EQ(global->lookup_symbol("helper"), nullptr);
+    EXPECT_TRUE(global->get_type_definition("Parsed").has_value());
+
+    // Definitions can be made again after being discarded
+    EXPECT_NO_THROW(
+        global->define_function(Symbol(POSITION, "helper"), make_function_type(global, PrimitiveType::INT32), VisibilityModifier::PUBLIC));
+}
+
+TEST(ParsingContext, TakenDefinitionsCanBeRestored)
+{
+    const auto global = make_context();
+    global->define_symbol(Symbol(POSITION, "Red"), SymbolType::ENUM_MEMBER);
+
+    auto definitions = global->take_symbols();
+    EXPECT_EQ(global->get_symbol_def("Red"), nullptr);
+
+    global->restore_symbols(std::move(definitions), false);
+    ASSERT_NE(global->get_symbol_def("Red"), nullptr);
+    EXPECT_TRUE(global->get_definition_by_internal_name("Red").has_value());
+}
+
+TEST(ParsingContext, FirstMatchingOverloadWins)
+{
+    const auto global = make_context();
+
+    // Aliases have no parameter hash, so this overload is compared structurally
+    global->define_type(Symbol(POSITION, "Number"), make_type(global, PrimitiveType::INT32), {}, VisibilityModifier::PUBLIC);
+    std::vector<std::unique_ptr<IAstType>> alias_parameters;
+    alias_parameters.push_back(std::make_unique<AstAliasType>(POSITION, global, "Number"));
+    global->define_function(
+        Symbol(POSITION, "describe"),
+        std::make_unique<AstFunctionType>(POSITION, global, std::move(alias_parameters), make_type(global, PrimitiveType::INT32)),
+        VisibilityModifier::PUBLIC);
+
+    // Enough overloads for them to be looked up by hash
+    for (const auto type : {
+             PrimitiveType::INT8, PrimitiveType::INT16, PrimitiveType::INT64, PrimitiveType::UINT8,
+             PrimitiveType::UINT16, PrimitiveType::UINT32, PrimitiveType::UINT64, PrimitiveType::FLOAT32,
+             PrimitiveType::FLOAT64
+         })
+    {
+        global->define_function(Symbol(POSITION, "describe"), make_function_type(global, type), VisibilityModifier::PUBLIC);
+    }
+
+    // i32 equals Number, which is defined first
+    EXPECT_THROW(
+        global->define_function(Symbol(POSITION, "describe"), make_function_type(global, PrimitiveType::INT32), VisibilityModifier::PUBLIC),
+        parsing_error);
+
+    std::vector<std::unique_ptr<IAstType>> arguments;
+    arguments.push_back(make_type(global, PrimitiveType::INT32));
+
+    auto definition = global->get_function_definition("describe", arguments);
+    ASSERT_TRUE(definition.has_value());
+    EXPECT_NE(dynamic_cast<AstAliasType*>(definition.value()->get_type()->get_parameter_types()[0].get()), nullptr);
+
+    arguments[0] = make_type(global, PrimitiveType::FLOAT64);
+    definition = global->get_function_definition("describe", arguments);
+    ASSERT_TRUE(definition.has_value());
+    EXPECT_TRUE(is_primitive(definition.value()->get_type()->get_parameter_types()[0].get(), PrimitiveType::FLOAT64));
+
+    arguments[0] = make_type(global, PrimitiveType::BOOL);
+    EXPECT_FALSE(global->get_function_definition("describe", arguments).has_value());
+}
+
+TEST(ParsingContext, VariadicOverloadsAcceptMoreArguments)
+{
+    const auto global = make_context();
+    global->define_function(
+        Symbol(POSITION, "print"),
+        make_function_type(global, PrimitiveType::STRING),
+        VisibilityModifier::PUBLIC,
+        SRFLAG_FN_TYPE_VARIADIC);
+
+    std::vector<std::unique_ptr<IAstType>> arguments;
+    arguments.push_back(make_type(global, PrimitiveType::STRING));
+    EXPECT_TRUE(global->get_function_definition("print", arguments).has_value());
+
+    arguments.push_back(make_type(global, PrimitiveType::INT32));
+    EXPECT_TRUE(global->get_function_definition("print", arguments).has_value());
+
+    arguments.erase(arguments.begin());
+    EXPECT_FALSE(global->get_function_definition("print", arguments).has_value());
+}
+
+TEST(ParsingContext, ParameterHashesDistinguishShapes)
+{
+    const auto global = make_context();
+
+    const auto tuple_of = [&](const PrimitiveType type)
+    {
+        std::vector<std::unique_ptr<IAstType>> members;
+        members.push_back(make_type(global, type));
+
+        std::vector<std::unique_ptr<IAstType>> parameters;
+        parameters.push_back(std::make_unique<AstTupleType>(POSITION, global, std::move(members)));
+        return parameters;
+    };
+
+    EXPECT_EQ(hash_parameter_types(tuple_of(PrimitiveType::INT32)), hash_parameter_types(tuple_of(PrimitiveType::INT32)));
+    EXPECT_NE(hash_parameter_types(tuple_of(PrimitiveType::INT32)), hash_parameter_types(tuple_of(PrimitiveType::INT64)));
+
+    // nil equals optional types, so it can't be hashed
+    std::vector<std::unique_ptr<IAstType>> nil_parameters;
+    nil_parameters.push_back(make_type(global, PrimitiveType::NIL));
+    EXPECT_FALSE(hash_parameter_types(nil_parameters).has_value());
+}
@@ -0,0 +1,121 @@
+#include "utils.h"
+#include "ast/tokens/scanner.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    std::vector<std::string> corpus()
+    {
+        std::vector<std::string> sources = {
+            "",
+            " ",
+            "\"",
+            "\\",
+            "*/",
+            std::string(100, ' ') + "x",
+            std::string(31, '\t') + "\n" + std::string(40, '\r'),
+            "\"" + std::string(63, 'a') + "\\\"" + std::string(20, 'b') + "\"",
+            "\"" + std::string(30, '\\') + "\"" + std::string(17, 'c') + "\"",
+            "\"" + std::string(40, 'a') + "\\",
+            "/*" + std::string(45, '*') + "/",
+            "/*" + std::string(31, 'x') + "*",
+            "// " + std::string(70, '/') + "\nlet x = 1;",
+        };
+
+        const std::filesystem::path stdlib_dir = CSTRIDE_STDLIB_DIR;
+        for (const auto& entry : std::filesystem::directory_iterator(stdlib_dir))
+        {
+            if (entry.path().extension() != ".sr")
+            {
+                continue;
+            }
+
+            std::ifstream file(entry.path());
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            sources.push_back(buffer.str());
+        }
+
+        return sources;
+    }
+
+    std::vector<std::tuple<TokenType, size_t, size_t, std::string>> lex(const std::string& code)
+    {
+        std::vector<std::tuple<TokenType, size_t, size_t, std::string>> tokens;
+
+        try
+        {
+            const auto source = std::make_shared<SourceFile>("test.sr", code);
+            const auto set = tokenizer::tokenize(source);
+
+            for (int64_t i = 0; i < set.size(); ++i)
+            {
+                const auto& token = set.at(i);
+                tokens.emplace_back(
+                    token.get_type(),
+                    token.get_source_fragment().offset,
+                    token.get_source_fragment().length,
+                    std::string(token.get_lexeme()));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            tokens.emplace_back(TokenType::END_OF_FILE, 0, 0, e.what());
+        }
+        return tokens;
+    }
+}
+
+TEST(Scanner, PrimitivesAgreeWithScalar)
+{
+    const auto& scalar = scanner::get_scanner(scanner::ScannerIsa::SCALAR);
+
+    for (const auto isa : scanner::supported_isas())
+    {
+        const auto& vectorized = scanner::get_scanner(isa);
+
+        for (const auto& source : corpus())
+        {
+            const std::string_view src = source;
+
+            for (size_t i = 0; i <= src.size(); ++i)
+            {
+                ASSERT_EQ(scalar.skip_whitespace(src, i), vectorized.skip_whitespace(src, i));
+                ASSERT_EQ(scalar.find_line_end(src, i), vectorized.find_line_end(src, i));
+                ASSERT_EQ(scalar.find_block_comment_end(src, i), vectorized.find_block_comment_end(src, i));
+                ASSERT_EQ(scalar.find_string_end(src, i), vectorized.find_string_end(src, i));
+            }
+        }
+    }
+}
+
+TEST(Scanner, TokensAgreeWithScalar)
+{
+    const auto sources = corpus();
+
+    scanner::force_isa(scanner::ScannerIsa::SCALAR);
+
+    std::vector<std::vector<std::tuple<TokenType, size_t, size_t, std::string>>> expected;
+    for (const auto& source : sources)
+    {
+        expected.push_back(lex(source));
+    }
+
+    for (const auto isa : scanner::supported_isas())
+    {
+        scanner::force_isa(isa);
+
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            EXPECT_EQ(expected[i], lex(sources[i])) << "Source:\n" << sources[i];
+        }
+    }
+
+    scanner::force_isa(scanner::supported_isas().back());
+}
@@ -0,0 +1,166 @@
+#include "errors.h"
+#include "thread_pool.h"
+#include "utils.h"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace stride;
+using namespace stride::ast;
+
+TEST(ThreadPool, RunsSubmittedTasks)
+{
+    ThreadPool pool(4);
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; ++i)
+    {
+        futures.push_back(pool.submit([i] { return i * i; }));
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(pool.wait(futures[i]), i * i);
+    }
+}
+
+TEST(ThreadPool, DeliversExceptions)
+{
+    ThreadPool pool(2);
+
+    auto future = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+
+    EXPECT_THROW(pool.wait(future), std::runtime_error);
+}
+
+TEST(ThreadPool, NestedTasksDontDeadlock)
+{
+    // More nested waits than workers; the waiting workers have to run the inner tasks themselves
+    ThreadPool pool(2);
+
+    std::vector<std::future<int>> outer;
+    for (int i = 0; i < 8; ++i)
+    {
+        outer.push_back(pool.submit([&pool]
+        {
+            std::vector<std::future<int>> inner;
+            for (int j = 0; j < 8; ++j)
+            {
+                inner.push_back(pool.submit([j] { return j; }));
+            }
+
+            int sum = 0;
+            for (auto& future : inner)
+            {
+                sum += pool.wait(future);
+            }
+            return sum;
+        }));
+    }
+
+    for (auto& future : outer)
+    {
+        EXPECT_EQ(pool.wait(future), 28);
+    }
+}
+
+TEST(ThreadPool, FinishesQueuedTasksOnDestruction)
+{
+    std::atomic<int> completed = 0;
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 50; ++i)
+        {
+            pool.submit([&completed] { ++completed; });
+        }
+    }
+
+    EXPECT_EQ(completed, 50);
+}
+
+TEST(ThreadPool, ParsesFilesInParallel)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "cstride_thread_pool";
+    std::filesystem::create_directories(directory);
+
+    std::vector<FilePath> files;
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto path = directory / std::format("file{}.sr", i);
+        std::ofstream file(path);
+
+        // Files of different sizes, so they aren't scheduled in the order given
+        for (int j = 0; j <= i * (i % 3); ++j)
+        {
+            file << std::format("fn f{}_{}(a: i32): i32 {{ return a + {}; }}\n", i, j, j);
+        }
+        files.push_back(path.string());
+    }
+
+    ThreadPool pool(4);
+    const auto ast = Ast::parse_files(files, pool);
+
+    ASSERT_EQ(ast->get_files().size(), files.size());
+    for (int i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(ast->get_files().at(files[i])->get_children().size(), static_cast<size_t>(i * (i % 3) + 1));
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ThreadPool, ParseErrorsAreReported)
+{
+    const auto path = std::filesystem::temp_directory_path() / "cstride_thread_pool_error.sr";
+    std::ofstream(path) << "fn broken(: i32 {";
+
+    ThreadPool pool(2);
+    EXPECT_THROW(Ast::parse_files({ path.string() }, pool), parsing_error);
+
+    std::filesystem::remove(path);
+}
+
+TEST(ThreadPool, ParseErrorsWaitForEveryFile)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "cstride_thread_pool_errors";
+    std::filesystem::create_directories(directory);
+
+    std::vector<FilePath> files;
+    for (int i = 0; i < 12; ++i)
+    {
+        const auto path = directory / std::format("file{:02}.sr", i);
+        files.push_back(path.string());
+        std::ofstream file(path);
+
+        // The broken files are the smallest, so they fail while larger files are still being parsed
+        if (i == 4 || i == 9)
+        {
+            file << "fn broken(: i32 {";
+            continue;
+        }
+        for (int j = 0; j <= i * 20; ++j)
+        {
+            file << std::format("fn f{}_{}(a: i32): i32 {{ return a + {}; }}\n", i, j, j);
+        }
+    }
+
+    ThreadPool pool(4);
+    try
+    {
+        Ast::parse_files(files, pool);
+        FAIL() << "Expected a parsing error";
+    }
+    catch (const parsing_error& error)
+    {
+        // Both errors are reported, in the order of their files
+        const std::string message = error.what();
+        const auto first = message.find("file04.sr");
+        const auto second = message.find("file09.sr");
+
+        ASSERT_NE(first, std::string::npos) << message;
+        ASSERT_NE(second, std::string::npos) << message;
+        EXPECT_LT(first, second);
+    }
+
+    std::filesystem::remove_all(directory);
+}
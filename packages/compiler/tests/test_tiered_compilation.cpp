@@ -0,0 +1,127 @@
+#include "program.h"
+#include "tiered_compilation.h"
+#include "utils.h"
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Support/SourceMgr.h>
+
+using namespace stride;
+
+namespace
+{
+    // The internal function is promoted, so that the recompiled function can still call it
+    constexpr auto SOURCE = R"(
+        define internal i32 @twice(i32 %x) {
+        entry:
+          %result = add i32 %x, %x
+          ret i32 %result
+        }
+
+        define i32 @square_twice(i32 %x) {
+        entry:
+          %slot = alloca i32
+          store i32 %x, ptr %slot
+          %value = load i32, ptr %slot
+          %square = mul i32 %value, %value
+          %result = call i32 @twice(i32 %square)
+          ret i32 %result
+        }
+
+        define i32 @sum(i32 %count, ...) {
+        entry:
+          ret i32 %count
+        }
+
+        define i32 @main() {
+        entry:
+          ret i32 0
+        }
+    )";
+
+    llvm::orc::ThreadSafeModule parse_module(const llvm::TargetMachine* target_machine)
+    {
+        auto context = std::make_unique<llvm::LLVMContext>();
+
+        llvm::SMDiagnostic diagnostic;
+        auto module = llvm::parseAssemblyString(SOURCE, diagnostic, *context);
+        if (module == nullptr)
+        {
+            throw std::runtime_error(diagnostic.getMessage().str());
+        }
+
+        module->setDataLayout(target_machine->createDataLayout());
+        module->setTargetTriple(target_machine->getTargetTriple());
+
+        return llvm::orc::ThreadSafeModule(std::move(module), llvm::orc::ThreadSafeContext(std::move(context)));
+    }
+
+    template <typename T>
+    T lookup(llvm::orc::LLJIT& jit, const std::string& name)
+    {
+        return llvm::cantFail(jit.lookup(name)).toPtr<T>();
+    }
+
+    bool is_defined(llvm::orc::LLJIT& jit, const std::string& name)
+    {
+        auto symbol = jit.lookup(name);
+        if (!symbol)
+        {
+            llvm::consumeError(symbol.takeError());
+            return false;
+        }
+        return true;
+    }
+}
+
+TEST(TieredCompilation, HotFunctionsAreRedirectedToOptimizedCode)
+{
+    const auto target_machine = tests::create_host_target_machine();
+    const auto options = tests::resolve_options({ "-O2", "--tiered", "--tier-up-threshold=3" });
+
+    auto jit = llvm::cantFail(llvm::orc::LLJITBuilder().create());
+    TieredCompilation tiered_compilation(jit.get(), Program::clone_target_machine(target_machine.get()), options);
+    tiered_compilation.add_module(parse_module(target_machine.get()));
+
+    // Callers reach the function through its stub, which jumps to the tier its pointer holds
+    const auto square_twice = lookup<int (*)(int)>(*jit, "square_twice");
+    auto** tier_pointer = lookup<void**>(*jit, "square_twice.tier_pointer");
+    void* first_tier = *tier_pointer;
+
+    EXPECT_NE(first_tier, reinterpret_cast<void*>(square_twice));
+
+    EXPECT_EQ(square_twice(3), 18);
+    EXPECT_EQ(square_twice(4), 32);
+    tiered_compilation.wait();
+
+    EXPECT_EQ(tiered_compilation.get_recompiled_count(), 0);
+    EXPECT_EQ(*tier_pointer, first_tier);
+
+    // The third call reaches the threshold, of both the function and the function it calls
+    EXPECT_EQ(square_twice(5), 50);
+    tiered_compilation.wait();
+
+    EXPECT_EQ(tiered_compilation.get_recompiled_count(), 2);
+    EXPECT_EQ(*tier_pointer, lookup<void*>(*jit, "square_twice.tier1"));
+
+    // Later calls run the second tier, which doesn't count its calls
+    EXPECT_EQ(square_twice(6), 72);
+    tiered_compilation.wait();
+    EXPECT_EQ(tiered_compilation.get_recompiled_count(), 2);
+}
+
+TEST(TieredCompilation, VariadicFunctionsAndMainAreNotTiered)
+{
+    const auto target_machine = tests::create_host_target_machine();
+    const auto options = tests::resolve_options({ "--tiered" });
+
+    auto jit = llvm::cantFail(llvm::orc::LLJITBuilder().create());
+    TieredCompilation tiered_compilation(jit.get(), Program::clone_target_machine(target_machine.get()), options);
+    tiered_compilation.add_module(parse_module(target_machine.get()));
+
+    EXPECT_TRUE(is_defined(*jit, "square_twice.tier_pointer"));
+    EXPECT_FALSE(is_defined(*jit, "sum.tier_pointer"));
+    EXPECT_FALSE(is_defined(*jit, "main.tier_pointer"));
+
+    EXPECT_EQ(lookup<int (*)()>(*jit, "main")(), 0);
+}
@@ -0,0 +1,81 @@
+#include "errors.h"
+#include "utils.h"
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    TokenSet tokenize(const std::string& code)
+    {
+        return tokenizer::tokenize(std::make_shared<SourceFile>("test.sr", code));
+    }
+}
+
+TEST(TokenSet, SubsetSharesTokens)
+{
+    const auto set = tokenize("a ( b c ) d");
+    const auto subset = set.create_subset(2, 2);
+
+    EXPECT_EQ(subset.size(), 2);
+    EXPECT_EQ(subset.at(0).get_lexeme(), "b");
+    EXPECT_EQ(subset.last().get_lexeme(), "c");
+    EXPECT_EQ(&subset.at(0), &set.at(2));
+    EXPECT_EQ(subset.at(2).get_type(), TokenType::END_OF_FILE);
+    EXPECT_THROW(auto _ = subset.create_subset(1, 2), std::out_of_range);
+}
+
+TEST(TokenSet, FindClosingBracket)
+{
+    const auto set = tokenize("( [ ( ) ] { ) } ( ]");
+
+    EXPECT_EQ(set.find_closing_bracket(0), 6);
+    EXPECT_EQ(set.find_closing_bracket(1), 4);
+    EXPECT_EQ(set.find_closing_bracket(2), 3);
+    EXPECT_EQ(set.find_closing_bracket(5), 7);
+    EXPECT_EQ(set.find_closing_bracket(8), -1);
+    EXPECT_EQ(set.find_closing_bracket(3), -1);
+
+    // Closing brackets outside the subset are not visible to it.
+    const auto subset = set.create_subset(0, 5);
+    EXPECT_EQ(subset.find_closing_bracket(0), -1);
+    EXPECT_EQ(subset.find_closing_bracket(1), 4);
+}
+
+TEST(TokenSet, CollectNestedBlocks)
+{
+    constexpr int depth = 512;
+
+    std::string code;
+    for (int i = 0; i < depth; ++i)
+    {
+        code += "{ a ";
+    }
+    for (int i = 0; i < depth; ++i)
+    {
+        code += "} ";
+    }
+    code += "b";
+
+    auto set = tokenize(code);
+
+    for (int i = 0; i < depth - 1; ++i)
+    {
+        auto block = collect_block(set);
+        ASSERT_TRUE(block.has_value());
+
+        set = block.value();
+        EXPECT_EQ(set.next().get_lexeme(), "a");
+    }
+
+    const auto innermost = collect_block(set);
+    ASSERT_TRUE(innermost.has_value());
+    EXPECT_EQ(innermost->size(), 1);
+}
+
+TEST(TokenSet, CollectUnmatchedBlock)
+{
+    auto set = tokenize("{ a { b }");
+
+    EXPECT_THROW(auto _ = collect_block(set), parsing_error);
+}
@@ -0,0 +1,230 @@
+#include "errors.h"
+#include "utils.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    struct LexResult
+    {
+        std::vector<std::tuple<TokenType, size_t, size_t, std::string>> tokens;
+        std::string error;
+    };
+
+    LexResult lex(const std::string& code, const tokenizer::LexerBackend backend)
+    {
+        LexResult result;
+        try
+        {
+            const auto source = std::make_shared<SourceFile>("test.sr", code);
+            const auto set = tokenizer::tokenize(source, backend);
+
+            for (int64_t i = 0; i < set.size(); ++i)
+            {
+                const auto token = set.at(i);
+                result.tokens.emplace_back(
+                    token.get_type(),
+                    token.get_source_fragment().offset,
+                    token.get_source_fragment().length,
+                    std::string(token.get_lexeme()));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            result.error = e.what();
+        }
+        return result;
+    }
+
+    void assert_backends_agree(const std::string& code)
+    {
+        const auto regex = lex(code, tokenizer::LexerBackend::REGEX);
+        const auto state_machine = lex(code, tokenizer::LexerBackend::STATE_MACHINE);
+
+        EXPECT_EQ(regex.error, state_machine.error) << "Source:\n" << code;
+        ASSERT_EQ(regex.tokens.size(), state_machine.tokens.size()) << "Source:\n" << code;
+
+        for (size_t i = 0; i < regex.tokens.size(); ++i)
+        {
+            EXPECT_EQ(regex.tokens[i], state_machine.tokens[i])
+                << "Token " << i << " differs for source:\n" << code;
+        }
+    }
+
+    std::vector<TokenType> token_types(const std::string& code)
+    {
+        std::vector<TokenType> types;
+        for (const auto& [type, offset, length, lexeme] : lex(code, tokenizer::LexerBackend::STATE_MACHINE).tokens)
+        {
+            types.push_back(type);
+        }
+        return types;
+    }
+}
+
+TEST(Tokenizer, KeywordsAndIdentifiers)
+{
+    EXPECT_EQ(token_types("let letter pub public i32 i32x $i32 const$x true falsey"),
+              (std::vector{
+                  TokenType::KEYWORD_LET,
+                  TokenType::IDENTIFIER,
+                  TokenType::KEYWORD_PUBLIC,
+                  TokenType::IDENTIFIER,
+                  TokenType::PRIMITIVE_INT32,
+                  TokenType::IDENTIFIER,
+                  TokenType::IDENTIFIER,
+                  TokenType::KEYWORD_CONST,
+                  TokenType::IDENTIFIER,
+                  TokenType::BOOLEAN_LITERAL,
+                  TokenType::IDENTIFIER
+                  }));
+}
+
+TEST(Tokenizer, NumericLiterals)
+{
+    EXPECT_EQ(token_types("0xFF 12 12L 1.5 .5 3.14D 7d 0xFg"),
+              (std::vector{
+                  TokenType::HEX_LITERAL,
+                  TokenType::INTEGER_LITERAL,
+                  TokenType::LONG_INTEGER_LITERAL,
+                  TokenType::FLOAT_LITERAL,
+                  TokenType::FLOAT_LITERAL,
+                  TokenType::DOUBLE_LITERAL,
+                  TokenType::DOUBLE_LITERAL,
+                  TokenType::INTEGER_LITERAL,
+                  TokenType::IDENTIFIER
+                  }));
+}
+
+TEST(Tokenizer, Operators)
+{
+    EXPECT_EQ(token_types("**= ** *= <<= << -> <- ... .. ::"),
+              (std::vector{
+                  TokenType::DOUBLE_ASTERISK_EQ,
+                  TokenType::DOUBLE_STAR,
+                  TokenType::STAR_EQUALS,
+                  TokenType::DOUBLE_LT_EQ,
+                  TokenType::LT,
+                  TokenType::LT,
+                  TokenType::RARROW,
+                  TokenType::LARROW,
+                  TokenType::THREE_DOTS,
+                  TokenType::DOT,
+                  TokenType::DOT,
+                  TokenType::DOUBLE_COLON
+                  }));
+}
+
+TEST(Tokenizer, UnexpectedCharacter)
+{
+    const auto source = std::make_shared<SourceFile>("test.sr", "let # = 1;");
+
+    EXPECT_THROW(auto _ = tokenizer::tokenize(source), parsing_error);
+}
+
+TEST(Tokenizer, StringLiteralLexemes)
+{
+    const auto source = std::make_shared<SourceFile>("test.sr", R"(let a = "plain"; let b = "line\n";)");
+    const auto set = tokenizer::tokenize(source);
+
+    EXPECT_EQ(set.at(3).get_lexeme(), "plain");
+    EXPECT_EQ(set.at(3).get_source_fragment().length, 7);
+    EXPECT_EQ(set.at(8).get_lexeme(), "line\n");
+    EXPECT_EQ(set.at(8).get_source_fragment().offset, 25);
+}
+
+TEST(Tokenizer, BackendsAgreeOnEdgeCases)
+{
+    for (const auto* code : {
+             "",
+             "   \n\t\r ",
+             "\"unterminated",
+             R"("escaped \" quote" "\\" "a\\\"b")",
+             R"('a' '\n' '\'' '' 'ab')",
+             "// comment\nlet x = 1; /* block\n comment */ let y = 2;",
+             "/* unterminated comment",
+             "a/*b*/c//d",
+             "x.5 1.d 1..2 12.5.3 0x 0x1$",
+             "fn main(): void { return; }",
+             "let é = 1;",
+         })
+    {
+        assert_backends_agree(code);
+    }
+}
+
+TEST(Tokenizer, BackendsAgreeOnStandardLibrary)
+{
+    const std::filesystem::path stdlib_dir = CSTRIDE_STDLIB_DIR;
+    ASSERT_TRUE(std::filesystem::exists(stdlib_dir));
+
+    for (const auto& entry : std::filesystem::directory_iterator(stdlib_dir))
+    {
+        if (entry.path().extension() != ".sr")
+        {
+            continue;
+        }
+
+        std::ifstream file(entry.path());
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+
+        assert_backends_agree(buffer.str());
+    }
+}
+
+TEST(Tokenizer, RetokenizeMatchesFullTokenize)
+{
+    struct EditCase
+    {
+        std::string code;
+        SourceEdit edit;
+    };
+
+    const std::vector<EditCase> cases = {
+        { "let value: i32 = 1;", { 5, 0, "_renamed" } },
+        { "let value: i32 = 1;", { 17, 1, "12.5" } },
+        { "fn a(): void {}\nfn b(): void {}", { 0, 0, "/*" } },
+        { "fn a(): void {}\n/* fn b(): void {} */", { 16, 2, "" } },
+        { "let s: string = \"a\\nb\";\nlet t: i32 = 1;", { 18, 0, "\\t" } },
+        { "let s: string = \"abc\";\nlet t: i32 = 1;", { 16, 1, "" } },
+        { "a = b; // comment\nc = d;", { 7, 2, "" } },
+        { "x = 1;", { 6, 0, "\ny = 2;" } },
+        { "x = 1; y = 2;", { 0, 7, "" } },
+    };
+
+    for (const auto& [code, edit] : cases)
+    {
+        const auto source = std::make_shared<SourceFile>("test.sr", code);
+        const auto edited = apply_edit(*source, edit);
+
+        const auto expected = lex(std::string(edited->source), tokenizer::LexerBackend::STATE_MACHINE);
+
+        LexResult actual;
+        try
+        {
+            const auto retokenized = tokenizer::retokenize(tokenizer::tokenize(source), edited, edit);
+            for (int64_t i = 0; i < retokenized.tokens.size(); ++i)
+            {
+                const auto token = retokenized.tokens.at(i);
+                actual.tokens.emplace_back(
+                    token.get_type(),
+                    token.get_source_fragment().offset,
+                    token.get_source_fragment().length,
+                    std::string(token.get_lexeme()));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            actual.error = e.what();
+        }
+
+        EXPECT_EQ(expected.error, actual.error) << "Source:\n" << edited->source;
+        EXPECT_EQ(expected.tokens, actual.tokens) << "Source:\n" << edited->source;
+    }
+}
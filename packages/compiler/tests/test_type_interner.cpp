@@ -0,0 +1,177 @@
+#include "errors.h"
+#include "utils.h"
+#include "ast/nodes/type_interner.h"
+
+#include <thread>
+
+using namespace stride;
+using namespace stride::ast;
+
+namespace
+{
+    const auto SOURCE = std::make_shared<SourceFile>("test.sr", "");
+    const SourceFragment POSITION(SOURCE, 0, 0);
+
+    std::unique_ptr<IAstType> make_primitive(
+        const std::shared_ptr<ParsingContext>& context,
+        const PrimitiveType type,
+        const int flags = SRFLAG_NONE
+    )
+    {
+        return std::make_unique<AstPrimitiveType>(POSITION, context, type, flags);
+    }
+
+    std::unique_ptr<IAstType> make_array(const std::shared_ptr<ParsingContext>& context, const PrimitiveType type)
+    {
+        return std::make_unique<AstArrayType>(POSITION, context, make_primitive(context, type), 0);
+    }
+
+    std::unique_ptr<IAstType> make_object(
+        const std::shared_ptr<ParsingContext>& context,
+        const std::string& name,
+        const PrimitiveType member_type
+    )
+    {
+        ObjectTypeMemberList members;
+        members.emplace_back("value", make_primitive(context, member_type));
+        return std::make_unique<AstObjectType>(POSITION, context, name, std::move(members));
+    }
+}
+
+TEST(TypeInterner, EqualStructuresShareAnId)
+{
+    const auto context = make_context();
+
+    const auto first = make_array(context, PrimitiveType::INT32);
+    const auto second = make_array(context, PrimitiveType::INT32);
+
+    EXPECT_EQ(first->get_type_id(), second->get_type_id());
+    EXPECT_EQ(&first->get_interned_type(), &second->get_interned_type());
+    EXPECT_NE(first->get_type_id(), make_array(context, PrimitiveType::INT64)->get_type_id());
+
+    const auto& key = type_interner::resolve(first->get_type_id());
+    EXPECT_EQ(key.kind, TypeKind::ARRAY);
+    ASSERT_EQ(key.children.size(), 1);
+    EXPECT_EQ(type_interner::resolve(key.children[0]).kind, TypeKind::PRIMITIVE);
+}
+
+TEST(TypeInterner, FlagsChangeTheIdButNotTheShape)
+{
+    const auto context = make_context();
+
+    const auto plain = make_primitive(context, PrimitiveType::INT32);
+    const auto optional = make_primitive(context, PrimitiveType::INT32, SRFLAG_TYPE_OPTIONAL);
+
+    EXPECT_NE(plain->get_type_id(), optional->get_type_id());
+    EXPECT_EQ(plain->get_interned_type().shape, optional->get_interned_type().shape);
+    EXPECT_TRUE(plain->equals(optional.get()));
+
+    // Changing the flags interns the type again
+    const auto previous_id = optional->get_type_id();
+    optional->set_flags(SRFLAG_NONE);
+    EXPECT_NE(optional->get_type_id(), previous_id);
+    EXPECT_EQ(optional->get_type_id(), plain->get_type_id());
+}
+
+TEST(TypeInterner, ClonesKeepTheirIdentity)
+{
+    const auto context = make_context();
+    const auto type = make_array(context, PrimitiveType::FLOAT64);
+
+    // Comparing doesn't intern types
+    EXPECT_TRUE(type->equals(make_array(context, PrimitiveType::FLOAT64).get()));
+    EXPECT_FALSE(type->is_interned());
+    EXPECT_FALSE(type->clone_ty()->is_interned());
+
+    type->intern();
+    const auto& interned_type = type->get_interned_type();
+
+    const auto clone = type->clone_ty();
+    EXPECT_EQ(&clone->get_interned_type(), &interned_type);
+    EXPECT_TRUE(clone->equals(type.get()));
+}
+
+TEST(TypeInterner, ExactTypesAreDecidedByShape)
+{
+    const auto context = make_context();
+
+    const auto first = make_array(context, PrimitiveType::INT32);
+    const auto second = make_array(context, PrimitiveType::INT64);
+    first->intern();
+    second->intern();
+
+    EXPECT_TRUE(first->get_interned_type().is_exact);
+    EXPECT_FALSE(first->equals(second.get()));
+    EXPECT_FALSE(make_primitive(context, PrimitiveType::NIL)->get_interned_type().is_exact);
+
+    // nil still equals optional types
+    const auto optional = make_primitive(context, PrimitiveType::INT32, SRFLAG_TYPE_OPTIONAL);
+    EXPECT_TRUE(make_primitive(context, PrimitiveType::NIL)->equals(optional.get()));
+}
+
+TEST(TypeInterner, AliasesAreComparedStructurally)
+{
+    const auto context = make_context();
+    context->define_type(Symbol(POSITION, "Number"), make_primitive(context, PrimitiveType::INT32), {}, VisibilityModifier::PUBLIC);
+
+    const auto alias = std::make_unique<AstAliasType>(POSITION, context, "Number");
+    const auto primitive = make_primitive(context, PrimitiveType::INT32);
+
+    alias->intern();
+    primitive->intern();
+    EXPECT_FALSE(alias->get_interned_type().is_exact);
+    EXPECT_NE(alias->get_interned_type().shape, primitive->get_interned_type().shape);
+    EXPECT_TRUE(alias->equals(primitive.get()));
+    EXPECT_TRUE(primitive->equals(alias.get()));
+}
+
+TEST(TypeInterner, ObjectNamesAreIgnoredByShape)
+{
+    const auto context = make_context();
+
+    const auto first = make_object(context, "First", PrimitiveType::INT32);
+    const auto second = make_object(context, "Second", PrimitiveType::INT32);
+
+    first->intern();
+    second->intern();
+    EXPECT_NE(first->get_type_id(), second->get_type_id());
+    EXPECT_EQ(first->get_interned_type().shape, second->get_interned_type().shape);
+    EXPECT_TRUE(first->equals(second.get()));
+    EXPECT_FALSE(first->equals(make_object(context, "First", PrimitiveType::BOOL).get()));
+}
+
+TEST(TypeInterner, ConcurrentInterning)
+{
+    constexpr int thread_count = 8;
+    constexpr int types_per_thread = 200;
+
+    const auto context = make_context();
+    std::vector<std::vector<TypeId>> ids(thread_count);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (int i = 0; i < types_per_thread; ++i)
+            {
+                std::unique_ptr<IAstType> type = make_primitive(context, PrimitiveType::INT8);
+                for (int depth = 0; depth < i % 16; ++depth)
+                {
+                    type = std::make_unique<AstArrayType>(POSITION, context, std::move(type), i);
+                }
+                ids[t].push_back(type->get_type_id());
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int t = 1; t < thread_count; ++t)
+    {
+        EXPECT_EQ(ids[0], ids[t]);
+    }
+}
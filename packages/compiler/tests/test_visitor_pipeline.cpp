@@ -0,0 +1,149 @@
+#include "errors.h"
+#include "utils.h"
+#include "ast/visitor_pipeline.h"
+#include "ast/nodes/function_declaration.h"
+
+using namespace stride;
+using namespace stride::ast;
+using namespace stride::tests;
+
+namespace
+{
+    /// Records every visit into a log shared between visitors
+    class RecordingVisitor : public IVisitor
+    {
+        std::string _name;
+        std::vector<std::string>& _log;
+
+    public:
+        RecordingVisitor(std::string name, std::vector<std::string>& log) :
+            _name(std::move(name)),
+            _log(log) {}
+
+        void begin_file(const std::string& file_name, AstBlock*) override
+        {
+            this->_log.push_back(std::format("{}:file:{}", this->_name, file_name));
+        }
+
+        void accept(IAstExpression*) override
+        {
+            this->_log.push_back(std::format("{}:expr", this->_name));
+        }
+
+        void accept(IAstFunction* fn) override
+        {
+            this->_log.push_back(std::format("{}:fn:{}", this->_name, fn->get_function_name()));
+        }
+    };
+
+    std::unique_ptr<AstBlock> parse_only(const std::string& code)
+    {
+        const auto source = std::make_shared<SourceFile>("test.sr", code);
+        auto tokens = tokenizer::tokenize(source);
+        return parse_sequential(std::make_shared<ParsingContext>(), tokens);
+    }
+
+    std::vector<std::string> entries_of(const std::vector<std::string>& log, const std::string& name)
+    {
+        std::vector<std::string> entries;
+        for (const auto& entry : log)
+        {
+            if (entry.starts_with(name + ":"))
+            {
+                entries.push_back(entry.substr(name.size() + 1));
+            }
+        }
+        return entries;
+    }
+}
+
+TEST(VisitorPipeline, IndependentVisitorsShareATraversal)
+{
+    std::vector<std::string> log;
+    RecordingVisitor first("first", log);
+    RecordingVisitor second("second", log);
+    RecordingVisitor third("third", log);
+
+    VisitorPipeline pipeline;
+    pipeline.add(&first);
+    pipeline.add(&second);
+    pipeline.add(&third, { &first });
+
+    const auto phases = pipeline.get_phases();
+    ASSERT_EQ(phases.size(), 2);
+    EXPECT_EQ(phases[0], (std::vector<IVisitor*>{ &first, &second }));
+    EXPECT_EQ(phases[1], (std::vector<IVisitor*>{ &third }));
+
+    const auto root = parse_only("fn one(): i32 { return 1 + 2; }");
+    pipeline.run("test.sr", root.get());
+
+    // Fused visitors see each node in turn, in the order they were added
+    ASSERT_GE(log.size(), 4);
+    EXPECT_EQ(log[0], "first:file:test.sr");
+    EXPECT_EQ(log[1], "second:file:test.sr");
+    EXPECT_EQ(log[2], "first:fn:one");
+    EXPECT_EQ(log[3], "second:fn:one");
+
+    // Every visitor sees the same nodes as it would on its own
+    EXPECT_EQ(entries_of(log, "first"), entries_of(log, "second"));
+    EXPECT_EQ(entries_of(log, "first"), entries_of(log, "third"));
+
+    // The dependent visitor starts after the others are done with every node
+    const auto first_of_third = std::ranges::find_if(log, [](const auto& entry) { return entry.starts_with("third:"); });
+    EXPECT_TRUE(std::all_of(first_of_third, log.end(), [](const auto& entry) { return entry.starts_with("third:"); }));
+}
+
+TEST(VisitorPipeline, CompletionActionsRunBetweenPhases)
+{
+    std::vector<std::string> log;
+    RecordingVisitor first("first", log);
+    RecordingVisitor second("second", log);
+    RecordingVisitor last("last", log);
+
+    VisitorPipeline pipeline;
+    pipeline.add(&first);
+    pipeline.add(&second, { &first });
+    pipeline.add(&last, { &second, &first });
+    pipeline.on_complete(&first, [&] { log.emplace_back("barrier:first"); });
+    pipeline.on_complete(&second, [&] { log.emplace_back("barrier:second"); });
+
+    EXPECT_EQ(pipeline.get_phases().size(), 3);
+
+    std::map<std::string, std::unique_ptr<AstBlock>> files;
+    files.emplace("a.sr", parse_only("fn a(): i32 { return 1; }"));
+    files.emplace("b.sr", parse_only("fn b(): i32 { return 2; }"));
+    pipeline.run(files);
+
+    const auto position_of = [&](const std::string& entry)
+    {
+        return std::ranges::find(log, entry) - log.begin();
+    };
+
+    EXPECT_LT(position_of("first:fn:b"), position_of("barrier:first"));
+    EXPECT_LT(position_of("barrier:first"), position_of("second:file:a.sr"));
+    EXPECT_LT(position_of("second:fn:b"), position_of("barrier:second"));
+    EXPECT_LT(position_of("barrier:second"), position_of("last:file:a.sr"));
+    EXPECT_EQ(entries_of(log, "barrier").size(), 2);
+}
+
+TEST(VisitorPipeline, DependenciesMustBeAddedFirst)
+{
+    std::vector<std::string> log;
+    RecordingVisitor first("first", log);
+    RecordingVisitor second("second", log);
+
+    VisitorPipeline pipeline;
+    EXPECT_THROW(pipeline.add(&second, { &first }), std::invalid_argument);
+    EXPECT_THROW(pipeline.on_complete(&first, [] {}), std::invalid_argument);
+
+    pipeline.add(&first);
+    EXPECT_THROW(pipeline.add(&first), std::invalid_argument);
+}
+
+TEST(VisitorPipeline, FunctionsAreDeclaredBeforeExpressionsAreTyped)
+{
+    // Function declarations are registered in the fused first phase, so calls ahead of them resolve
+    assert_compiles(
+        "fn main(): i32 { return later(2) + 1; }\n"
+        "fn later(x: i32): i32 { return x * 2; }\n");
+}
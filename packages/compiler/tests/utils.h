@@ -1,16 +1,22 @@
 #pragma once
 
+#include "cli.h"
 #include "files.h"
+#include "program.h"
 #include "ast/ast.h"
 #include "ast/parsing_context.h"
 #include "ast/visitor.h"
+#include "ast/visitor_pipeline.h"
 #include "ast/nodes/blocks.h"
 #include "ast/nodes/traversal.h"
 #include "ast/tokens/tokenizer.h"
 #include "runtime/symbols.h"
 
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/IR/IRBuilder.h>
@@ -19,6 +25,46 @@
 
 namespace stride::tests
 {
+    /// Source file in a temporary directory, removed again when the test ends
+    struct TemporaryFile
+    {
+        std::filesystem::path path;
+
+        TemporaryFile(const std::string& name, const std::string& contents) :
+            path(std::filesystem::temp_directory_path() / name)
+        {
+            std::ofstream(this->path, std::ios::binary) << contents;
+        }
+
+        ~TemporaryFile()
+        {
+            std::filesystem::remove(this->path);
+        }
+    };
+
+    /// Compilation options as resolved from the command-line <code>arguments</code>
+    inline cli::CompilationOptions resolve_options(std::vector<std::string> arguments)
+    {
+        std::vector<char*> argv;
+        argv.reserve(arguments.size());
+        for (auto& argument : arguments)
+        {
+            argv.push_back(argument.data());
+        }
+
+        return cli::resolve_compilation_options_from_args(static_cast<int>(argv.size()), argv.data());
+    }
+
+    /// A target machine for the host, which modules generated by the tests are lowered for
+    inline std::unique_ptr<llvm::TargetMachine> create_host_target_machine()
+    {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+
+        auto jtmb = llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost());
+        return llvm::cantFail(jtmb.createTargetMachine());
+    }
+
     inline std::pair<std::unique_ptr<ast::AstBlock>, std::shared_ptr<ast::ParsingContext>> parse_code_with_context(
         const std::string& code)
     {
@@ -28,18 +74,16 @@ namespace stride::tests
 
         auto node = parse_sequential(context, tokens);
 
-        ast::AstNodeTraverser traverser;
         ast::ExpressionVisitor type_visitor;
         ast::FunctionVisitor function_visitor;
         ast::ImportVisitor import_visitor;
 
-        import_visitor.set_current_file_name("test.sr");
-        traverser.visit_block(&import_visitor, node.get());
-
-        traverser.visit_block(&function_visitor, node.get());
-
-        runtime::register_runtime_symbols(node->get_context());
-        traverser.visit_block(&type_visitor, node.get());
+        ast::VisitorPipeline pipeline;
+        pipeline.add(&import_visitor);
+        pipeline.add(&function_visitor);
+        pipeline.add(&type_visitor, { &import_visitor, &function_visitor });
+        pipeline.on_complete(&import_visitor, [&] { runtime::register_runtime_symbols(node->get_context()); });
+        pipeline.run("test.sr", node.get());
 
         node->validate();
 
@@ -64,11 +108,7 @@ namespace stride::tests
         auto [block, context] = parse_code_with_context(code);
         EXPECT_NE(block, nullptr) << "Parsing returned null for code: " << code;
 
-        llvm::InitializeNativeTarget();
-        llvm::InitializeNativeTargetAsmPrinter();
-
-        auto jtmb = llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost());
-        const auto target_machine = llvm::cantFail(jtmb.createTargetMachine());
+        const auto target_machine = create_host_target_machine();
 
         llvm::LLVMContext llvm_context;
         llvm::Module module("test_module", llvm_context);